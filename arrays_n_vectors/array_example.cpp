@@ -40,5 +40,10 @@ int main() {
     const int days_in_yrs {365};    // declare a const var
     double hi_temp[days_in_yrs];    // apply the const to the size
 
+    // the element count is part of the type
+    std::cout << "test_scores: " << std::size(test_scores) << " elements\n"
+              << "high_score_per_level: " << std::size(high_score_per_level) << " elements\n"
+              << "hi_temp: " << std::size(hi_temp) << " elements" << std::endl;
+
     /* Initialization */
 }
\ No newline at end of file
@@ -0,0 +1,310 @@
+/**
+@file fixed_vector.h
+
+@brief
+    Fixed-capacity containers with inline storage and selectable bounds checking
+        - fixed_array<T, N>: always N elements, like a C array / std::array.
+        - fixed_vector<T, N>: 0..N elements with push_back, like a std::vector that
+          never allocates (a "small vector" without the heap fallback).
+
+@par
+    Why:
+        * A C array (int test_scores[5]) has "No checking if Out-Of-Bounds"; std::array's
+          operator[] doesn't check either, and at() throws.
+        * std::vector checks nothing in operator[] and puts its elements on the heap.
+    Bounds checking (template parameter, default from PG_BOUNDS_CHECK):
+        bounds_check::off -> no check at all, same code as a raw array
+        bounds_check::debug -> assert(); compiled out with NDEBUG (PG_BOUNDS_CHECK 1, default)
+        bounds_check::always -> checked in every build (PG_BOUNDS_CHECK 2)
+        at() is checked in every mode.
+        A failed check prints the index and size and calls std::abort(). The failure path
+        is a cold, non-inlined function, so the checked operator[] is one compare and a
+        never-taken branch, which the compiler can usually hoist out of a counted loop.
+    Alignment:
+        Align (default alignof(T)) aligns the element storage, e.g. 64 for a cache line
+        or 32 for AVX2 loads.
+    Usage:
+        pg::fixed_array<int, 5> test_scores {{100, 95, 99, 87, 88}};
+        pg::fixed_vector<double, 365, pg::bounds_check::always, 64> hi_temp {};
+        hi_temp.push_back(90.1);
+        hi_temp[400];   // aborts: "index 400 out of range (size 1)"
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_FIXED_VECTOR_H
+#define PG_FIXED_VECTOR_H
+
+#include <cassert>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+#ifndef PG_BOUNDS_CHECK
+#define PG_BOUNDS_CHECK 1           // 0 = off, 1 = debug assert, 2 = always
+#endif
+
+namespace pg {
+
+enum class bounds_check { off, debug, always };
+
+constexpr bounds_check default_bounds_check =
+    PG_BOUNDS_CHECK == 0 ? bounds_check::off : PG_BOUNDS_CHECK == 2 ? bounds_check::always : bounds_check::debug;
+
+namespace detail {
+
+[[noreturn]] __attribute__((cold, noinline))
+inline void bounds_failure(const char *what, std::size_t index, std::size_t size) {
+    std::fprintf(stderr, "%s %zu out of range (size %zu)\n", what, index, size);
+    std::abort();
+}
+
+template <bounds_check Check>
+inline void check_index(std::size_t index, std::size_t size) {
+    if constexpr (Check == bounds_check::always) {
+        if (__builtin_expect(index >= size, 0))
+            bounds_failure("index", index, size);
+    } else if constexpr (Check == bounds_check::debug) {
+        assert(index < size && "index out of range");
+    }
+}
+
+template <bounds_check Check>
+inline void check_capacity(std::size_t size, std::size_t capacity) {
+    if constexpr (Check == bounds_check::always) {
+        if (__builtin_expect(size >= capacity, 0))
+            bounds_failure("push at size", size, capacity);
+    } else if constexpr (Check == bounds_check::debug) {
+        assert(size < capacity && "fixed_vector is full");
+    }
+}
+
+}   // namespace detail
+
+template <typename T, std::size_t N, bounds_check Check = default_bounds_check, std::size_t Align = alignof(T)>
+struct fixed_array {
+    static_assert(N > 0, "fixed_array needs at least one element");
+    static_assert((Align & (Align - 1)) == 0 && Align >= alignof(T), "Align must be a power of two >= alignof(T)");
+
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    alignas(Align) T elems[N];      // public, so aggregate initialization works like std::array
+
+    T &operator[](std::size_t i) {
+        detail::check_index<Check>(i, N);
+        return elems[i];
+    }
+    const T &operator[](std::size_t i) const {
+        detail::check_index<Check>(i, N);
+        return elems[i];
+    }
+    T &at(std::size_t i) {
+        detail::check_index<bounds_check::always>(i, N);
+        return elems[i];
+    }
+    const T &at(std::size_t i) const {
+        detail::check_index<bounds_check::always>(i, N);
+        return elems[i];
+    }
+
+    T &front() { return elems[0]; }
+    const T &front() const { return elems[0]; }
+    T &back() { return elems[N - 1]; }
+    const T &back() const { return elems[N - 1]; }
+    T *data() { return elems; }
+    const T *data() const { return elems; }
+
+    iterator begin() { return elems; }
+    iterator end() { return elems + N; }
+    const_iterator begin() const { return elems; }
+    const_iterator end() const { return elems + N; }
+
+    static constexpr std::size_t size() { return N; }
+    static constexpr bool empty() { return false; }
+
+    void fill(const T &value) {
+        for (T &e : elems)
+            e = value;
+    }
+};
+
+template <typename T, std::size_t N, bounds_check Check = default_bounds_check, std::size_t Align = alignof(T)>
+class fixed_vector {
+    static_assert(N > 0, "fixed_vector needs a capacity of at least one");
+    static_assert((Align & (Align - 1)) == 0 && Align >= alignof(T), "Align must be a power of two >= alignof(T)");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using iterator = T *;
+    using const_iterator = const T *;
+
+    fixed_vector() = default;
+
+    fixed_vector(std::initializer_list<T> init) {
+        for (const T &v : init)
+            push_back(v);
+    }
+
+    fixed_vector(std::size_t count, const T &value) {
+        for (std::size_t i {0}; i < count; ++i)
+            push_back(value);
+    }
+
+    fixed_vector(const fixed_vector &other) {
+        for (const T &v : other)
+            push_back(v);
+    }
+
+    fixed_vector(fixed_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        for (T &v : other)
+            push_back(std::move(v));
+        other.clear();
+    }
+
+    fixed_vector &operator=(const fixed_vector &other) {
+        if (this != &other) {
+            clear();
+            for (const T &v : other)
+                push_back(v);
+        }
+        return *this;
+    }
+
+    fixed_vector &operator=(fixed_vector &&other) noexcept(std::is_nothrow_move_constructible_v<T>) {
+        if (this != &other) {
+            clear();
+            for (T &v : other)
+                push_back(std::move(v));
+            other.clear();
+        }
+        return *this;
+    }
+
+    ~fixed_vector() { clear(); }
+
+    /* Element access */
+    T &operator[](std::size_t i) {
+        detail::check_index<Check>(i, size_);
+        return data()[i];
+    }
+    const T &operator[](std::size_t i) const {
+        detail::check_index<Check>(i, size_);
+        return data()[i];
+    }
+    T &at(std::size_t i) {
+        detail::check_index<bounds_check::always>(i, size_);
+        return data()[i];
+    }
+    const T &at(std::size_t i) const {
+        detail::check_index<bounds_check::always>(i, size_);
+        return data()[i];
+    }
+    T &front() { return (*this)[0]; }
+    const T &front() const { return (*this)[0]; }
+    T &back() { return (*this)[size_ - 1]; }
+    const T &back() const { return (*this)[size_ - 1]; }
+
+    T *data() { return reinterpret_cast<T *>(storage_); }
+    const T *data() const { return reinterpret_cast<const T *>(storage_); }
+
+    iterator begin() { return data(); }
+    iterator end() { return data() + size_; }
+    const_iterator begin() const { return data(); }
+    const_iterator end() const { return data() + size_; }
+
+    /* Capacity */
+    std::size_t size() const { return size_; }
+    static constexpr std::size_t capacity() { return N; }
+    bool empty() const { return size_ == 0; }
+    bool full() const { return size_ == N; }
+
+    /* Modifiers */
+    void push_back(const T &value) { emplace_back(value); }
+    void push_back(T &&value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T &emplace_back(Args &&...args) {
+        detail::check_capacity<Check>(size_, N);
+        T *p = ::new (static_cast<void *>(data() + size_)) T(std::forward<Args>(args)...);
+        ++size_;
+        return *p;
+    }
+
+    /* Never fails loudly: false when full, in every check mode */
+    bool try_push_back(const T &value) {
+        if (size_ == N)
+            return false;
+        ::new (static_cast<void *>(data() + size_)) T(value);
+        ++size_;
+        return true;
+    }
+
+    void pop_back() {
+        detail::check_index<Check>(0, size_);
+        --size_;
+        data()[size_].~T();
+    }
+
+    /* Removes the element at pos, keeping the order of the rest */
+    iterator erase(const_iterator pos) {
+        std::size_t i = static_cast<std::size_t>(pos - data());
+        detail::check_index<Check>(i, size_);
+        T *p = data();
+        for (std::size_t k {i}; k + 1 < size_; ++k)
+            p[k] = std::move(p[k + 1]);
+        pop_back();
+        return p + i;
+    }
+
+    void resize(std::size_t count, const T &value = T {}) {
+        while (size_ > count)
+            pop_back();
+        while (size_ < count)
+            push_back(value);
+    }
+
+    void clear() {
+        if constexpr (!std::is_trivially_destructible_v<T>) {
+            for (std::size_t i {0}; i < size_; ++i)
+                data()[i].~T();
+        }
+        size_ = 0;
+    }
+
+private:
+    alignas(Align) unsigned char storage_[N * sizeof(T)];
+    std::size_t size_ {0};
+};
+
+template <typename T, std::size_t N, bounds_check C, std::size_t A>
+bool operator==(const fixed_vector<T, N, C, A> &a, const fixed_vector<T, N, C, A> &b) {
+    if (a.size() != b.size())
+        return false;
+    for (std::size_t i {0}; i < a.size(); ++i) {
+        if (!(a.data()[i] == b.data()[i]))
+            return false;
+    }
+    return true;
+}
+
+}   // namespace pg
+
+#endif  // PG_FIXED_VECTOR_H
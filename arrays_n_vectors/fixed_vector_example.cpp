@@ -0,0 +1,171 @@
+/**
+@file fixed_vector_example.cpp
+
+@brief
+    The array_example.cpp declarations (test_scores[5], hi_temp[365]) with pg::fixed_array /
+    pg::fixed_vector (fixed_vector.h), and a benchmark against raw arrays, std::array and
+    std::vector.
+
+@par
+    Workloads (all variants must give the same checksum):
+        iterate -> sum of 365 doubles through operator[], repeated
+        push -> fill 365 elements with push_back (or an index for raw/std::array), then clear
+    Variants:
+        raw array, std::array, std::vector (reserved), fixed_array / fixed_vector with
+        bounds_check::off and bounds_check::always
+    Usage:
+        fixed_vector_example            -> demo + benchmark
+        fixed_vector_example --oob      -> shows the out-of-bounds abort
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "fixed_vector.h"
+
+constexpr std::size_t days_in_yrs {365};
+constexpr int rounds {200000};
+
+// Keeps the compiler from deleting a benchmark loop whose result is otherwise unused
+template <typename T>
+static void keep(T &value) {
+    asm volatile("" : "+m"(value));
+}
+
+template <typename Body>
+static double time_it(Body body) {
+    body();                                     // warm up caches and the branch predictor
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const std::string &label, double seconds, bool ok) {
+    std::cout << std::left << std::setw(32) << label << std::right << std::fixed << std::setprecision(2)
+              << std::setw(8) << seconds * 1e9 / (double {rounds} * days_in_yrs) << " ns/element"
+              << (ok ? "" : "   MISMATCH") << std::endl;
+}
+
+template <typename Array>
+static double sum_indexed(Array &a) {
+    double sum {0.0};
+    for (int r {0}; r < rounds; ++r) {
+        keep(a);
+        for (std::size_t i {0}; i < days_in_yrs; ++i)
+            sum += a[i];
+    }
+    return sum;
+}
+
+template <typename Vector>
+static double push_and_clear(Vector &v) {
+    double sum {0.0};
+    for (int r {0}; r < rounds; ++r) {
+        v.clear();
+        for (std::size_t i {0}; i < days_in_yrs; ++i)
+            v.push_back(static_cast<double>(i));
+        keep(v);
+        sum += v[days_in_yrs - 1];
+    }
+    return sum;
+}
+
+int main(int argc, char *argv[]) {
+    /* Declarations, as in array_example.cpp */
+    pg::fixed_array<int, 5, pg::bounds_check::always> test_scores {{100, 95, 99, 87, 88}};
+    pg::fixed_vector<double, days_in_yrs, pg::bounds_check::always, 64> hi_temp {};
+    hi_temp.push_back(90.1);
+    hi_temp.push_back(89.8);
+    std::cout << "test_scores[0]: " << test_scores[0] << "  size " << test_scores.size() << std::endl
+              << "hi_temp: " << hi_temp.size() << " of " << hi_temp.capacity() << " days, 64-byte aligned: "
+              << std::boolalpha << (reinterpret_cast<std::uintptr_t>(hi_temp.data()) % 64 == 0) << std::endl;
+    if (argc > 1 && std::strcmp(argv[1], "--oob") == 0)
+        std::cout << test_scores[5] << std::endl;       // aborts: index 5 out of range (size 5)
+
+    /* Iterate */
+    bool all_ok {true};
+    double expected {0.0};
+    {
+        double raw[days_in_yrs];
+        for (std::size_t i {0}; i < days_in_yrs; ++i)
+            raw[i] = static_cast<double>(i % 100);
+        double sum {};
+        double s = time_it([&] { sum = sum_indexed(raw); });
+        expected = sum;
+        report("iterate raw array", s, true);
+    }
+    auto iterate = [&](const std::string &label, auto &a) {
+        for (std::size_t i {0}; i < days_in_yrs; ++i)
+            a[i] = static_cast<double>(i % 100);
+        double sum {};
+        double s = time_it([&] { sum = sum_indexed(a); });
+        all_ok = all_ok && sum == expected;
+        report(label, s, sum == expected);
+    };
+    {
+        std::array<double, days_in_yrs> a {};
+        iterate("iterate std::array", a);
+        std::vector<double> v(days_in_yrs);
+        iterate("iterate std::vector", v);
+        pg::fixed_array<double, days_in_yrs, pg::bounds_check::off> f_off {};
+        iterate("iterate fixed_array off", f_off);
+        pg::fixed_array<double, days_in_yrs, pg::bounds_check::always> f_on {};
+        iterate("iterate fixed_array always", f_on);
+        pg::fixed_vector<double, days_in_yrs, pg::bounds_check::always, 64> fv(days_in_yrs, 0.0);
+        iterate("iterate fixed_vector always", fv);
+    }
+
+    /* Push */
+    {
+        double raw[days_in_yrs];
+        std::size_t count {0};
+        double sum {0.0};
+        double s = time_it([&] {
+            sum = 0.0;
+            for (int r {0}; r < rounds; ++r) {
+                count = 0;
+                for (std::size_t i {0}; i < days_in_yrs; ++i)
+                    raw[count++] = static_cast<double>(i);
+                keep(raw);
+                sum += raw[days_in_yrs - 1];
+            }
+        });
+        expected = sum;
+        report("push raw array + count", s, true);
+    }
+    auto push = [&](const std::string &label, auto &v) {
+        double sum {};
+        double s = time_it([&] { sum = push_and_clear(v); });
+        all_ok = all_ok && sum == expected;
+        report(label, s, sum == expected);
+    };
+    {
+        std::vector<double> v {};
+        v.reserve(days_in_yrs);
+        push("push std::vector (reserved)", v);
+        pg::fixed_vector<double, days_in_yrs, pg::bounds_check::off> f_off {};
+        push("push fixed_vector off", f_off);
+        pg::fixed_vector<double, days_in_yrs, pg::bounds_check::always> f_on {};
+        push("push fixed_vector always", f_on);
+    }
+
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,517 @@
+/**
+@file series_kernels.h
+
+@brief
+    Vectorized reductions and transforms over per-day series (double hi_temp[365] and larger)
+        contiguous double / float / int32 array ===> SSE2 / AVX2 / AVX-512 kernel ===> result
+
+@par
+    Functions (pg::series):
+        sum(data, n) -> acc_t<T> (double for float/double, int64 for int32)
+        min_max(data, n) -> {min, max}; n must be > 0; NaN handling unspecified
+        mean_variance(data, n) -> {mean, sample variance}; two passes, so no catastrophic
+                                  cancellation as with sum of squares
+        prefix_sum(data, n, out) -> out[i] = data[0] + ... + data[i], in acc_t<T>
+        moving_mean(data, n, window, out) -> out[j] = mean of data[j .. j + window - 1],
+                                             n - window + 1 outputs
+        count_above(data, n, t) / count_below(data, n, t) -> number of elements > t / < t
+    Kernels:
+        scalar -> plain loops in element order; the reference for correctness checks.
+        sse2 / avx2 / avx512 -> 16 / 32 / 64-byte vectors, written once with GCC vector
+                                extensions and compiled per ISA with __attribute__((target)).
+        Floating-point sums add in a different order than the scalar loop, so compare them
+        with a relative tolerance. Integer results and min/max/counts match exactly.
+        Moving windows up to direct_window elements are summed directly (the same order in
+        every kernel). Longer windows use a running sum.
+    Runtime dispatch:
+        * pg::detected_vector_isa() picks the widest ISA the CPU supports, once.
+        * series::kernels<T>(isa) returns the function table for an explicit ISA
+          (benchmarks, tests); unsupported levels fall back to the next lower one.
+    Usage:
+        double hi_temp[365] {...};
+        double total = pg::series::sum(hi_temp, 365);
+        pg::series::mean_variance_result mv = pg::series::mean_variance(hi_temp, 365);
+        std::size_t hot_days = pg::series::count_above(hi_temp, 365, 90.0);
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_SERIES_KERNELS_H
+#define PG_SERIES_KERNELS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace pg {
+
+enum class vector_isa { scalar, sse2, avx2, avx512 };
+
+inline const char *to_string(vector_isa isa) {
+    switch (isa) {
+    case vector_isa::scalar: return "scalar";
+    case vector_isa::sse2: return "sse2";
+    case vector_isa::avx2: return "avx2";
+    case vector_isa::avx512: return "avx512";
+    }
+    return "?";
+}
+
+inline bool cpu_supports(vector_isa isa) {
+#if defined(__x86_64__)
+    switch (isa) {
+    case vector_isa::scalar:
+    case vector_isa::sse2: return true;
+    case vector_isa::avx2: return __builtin_cpu_supports("avx2");
+    case vector_isa::avx512: return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq");
+    }
+    return false;
+#else
+    return isa == vector_isa::scalar;
+#endif
+}
+
+/* Widest ISA this CPU supports; checked once */
+inline vector_isa detected_vector_isa() {
+    static const vector_isa isa = cpu_supports(vector_isa::avx512) ? vector_isa::avx512
+                                : cpu_supports(vector_isa::avx2)   ? vector_isa::avx2
+                                : cpu_supports(vector_isa::sse2)   ? vector_isa::sse2
+                                                                   : vector_isa::scalar;
+    return isa;
+}
+
+namespace series {
+
+template <typename T> struct accumulator;
+template <> struct accumulator<double> { using type = double; };
+template <> struct accumulator<float> { using type = double; };
+template <> struct accumulator<std::int32_t> { using type = std::int64_t; };
+
+template <typename T>
+using acc_t = typename accumulator<T>::type;
+
+template <typename T>
+struct min_max_result {
+    T min;
+    T max;
+};
+
+struct mean_variance_result {
+    double mean;
+    double variance;            // sample variance (divides by n - 1); 0 when n < 2
+};
+
+constexpr std::size_t direct_window {32};   // longer moving windows use a running sum
+
+namespace detail {
+
+#define PG_SERIES_INLINE __attribute__((always_inline)) inline
+
+template <typename T, std::size_t Bytes>
+struct vec {
+    typedef T type __attribute__((vector_size(Bytes)));
+};
+
+template <typename T> struct same_size_int;
+template <> struct same_size_int<double> { using type = std::int64_t; };
+template <> struct same_size_int<float> { using type = std::int32_t; };
+template <> struct same_size_int<std::int32_t> { using type = std::int32_t; };
+
+// Vectors are passed by reference only: a by-value vector wider than the baseline ISA
+// would change the calling convention of these helpers
+template <typename V, typename T>
+PG_SERIES_INLINE void load(V &v, const T *p) { std::memcpy(&v, p, sizeof v); }
+
+template <typename V, typename T>
+PG_SERIES_INLINE void store(T *p, const V &v) { std::memcpy(p, &v, sizeof v); }
+
+/* Lane-widening load: W elements of T into W lanes of A */
+template <typename VA, typename T, std::size_t W>
+PG_SERIES_INLINE void load_widen(VA &out, const T *p) {
+    typename vec<T, W * sizeof(T)>::type v;
+    load(v, p);
+    out = __builtin_convertvector(v, VA);
+}
+
+/* Reference loops */
+template <typename T>
+acc_t<T> sum_scalar(const T *p, std::size_t n) {
+    acc_t<T> s {0};
+    for (std::size_t i {0}; i < n; ++i)
+        s += p[i];
+    return s;
+}
+
+template <typename T>
+min_max_result<T> min_max_scalar(const T *p, std::size_t n) {
+    min_max_result<T> r {p[0], p[0]};
+    for (std::size_t i {1}; i < n; ++i) {
+        r.min = p[i] < r.min ? p[i] : r.min;
+        r.max = p[i] > r.max ? p[i] : r.max;
+    }
+    return r;
+}
+
+template <typename T>
+double sum_sq_dev_scalar(const T *p, std::size_t n, double mean) {
+    double s {0.0};
+    for (std::size_t i {0}; i < n; ++i) {
+        double d = static_cast<double>(p[i]) - mean;
+        s += d * d;
+    }
+    return s;
+}
+
+template <typename T>
+void prefix_sum_scalar(const T *p, std::size_t n, acc_t<T> *out) {
+    acc_t<T> s {0};
+    for (std::size_t i {0}; i < n; ++i)
+        out[i] = s += p[i];
+}
+
+template <typename T>
+void moving_mean_running(const T *p, std::size_t n, std::size_t w, double *out, std::size_t from) {
+    if (from >= n - w + 1)
+        return;
+    double s {0.0};
+    for (std::size_t k {0}; k < w; ++k)
+        s += static_cast<double>(p[from + k]);
+    out[from] = s / static_cast<double>(w);
+    for (std::size_t j {from + 1}; j + w <= n; ++j) {
+        s += static_cast<double>(p[j + w - 1]) - static_cast<double>(p[j - 1]);
+        out[j] = s / static_cast<double>(w);
+    }
+}
+
+template <typename T>
+void moving_mean_direct(const T *p, std::size_t n, std::size_t w, double *out, std::size_t from) {
+    for (std::size_t j {from}; j + w <= n; ++j) {
+        double s {0.0};
+        for (std::size_t k {0}; k < w; ++k)
+            s += static_cast<double>(p[j + k]);
+        out[j] = s / static_cast<double>(w);
+    }
+}
+
+template <typename T>
+void moving_mean_scalar(const T *p, std::size_t n, std::size_t w, double *out) {
+    if (w == 0 || n < w)
+        return;
+    if (w <= direct_window)
+        moving_mean_direct(p, n, w, out, 0);
+    else
+        moving_mean_running(p, n, w, out, 0);
+}
+
+template <typename T, bool Above>
+std::size_t count_scalar(const T *p, std::size_t n, T t) {
+    std::size_t c {0};
+    for (std::size_t i {0}; i < n; ++i)
+        c += Above ? p[i] > t : p[i] < t;
+    return c;
+}
+
+/* Vector bodies; R = register bytes. Inlined into the per-ISA wrappers below. */
+template <typename T, std::size_t R>
+PG_SERIES_INLINE acc_t<T> sum_body(const T *p, std::size_t n) {
+    using A = acc_t<T>;
+    constexpr std::size_t W {R / sizeof(A)};
+    using VA = typename vec<A, R>::type;
+    VA a0 {}, a1 {}, a2 {}, a3 {};              // four chains hide the add latency
+    std::size_t i {0};
+    for (; i + 4 * W <= n; i += 4 * W) {
+        VA v0, v1, v2, v3;
+        load_widen<VA, T, W>(v0, p + i);
+        load_widen<VA, T, W>(v1, p + i + W);
+        load_widen<VA, T, W>(v2, p + i + 2 * W);
+        load_widen<VA, T, W>(v3, p + i + 3 * W);
+        a0 += v0;
+        a1 += v1;
+        a2 += v2;
+        a3 += v3;
+    }
+    for (; i + W <= n; i += W) {
+        VA v;
+        load_widen<VA, T, W>(v, p + i);
+        a0 += v;
+    }
+    a0 += a1 + (a2 + a3);
+    A s {0};
+    for (std::size_t k {0}; k < W; ++k)
+        s += a0[k];
+    for (; i < n; ++i)
+        s += p[i];
+    return s;
+}
+
+template <typename T, std::size_t R>
+PG_SERIES_INLINE min_max_result<T> min_max_body(const T *p, std::size_t n) {
+    constexpr std::size_t W {R / sizeof(T)};
+    using VT = typename vec<T, R>::type;
+    if (n < 2 * W)
+        return min_max_scalar(p, n);
+    VT lo, hi, lo1, hi1;
+    load(lo, p);
+    hi = lo;
+    load(lo1, p + W);
+    hi1 = lo1;
+    std::size_t i {2 * W};
+    for (; i + 2 * W <= n; i += 2 * W) {
+        VT v0, v1;
+        load(v0, p + i);
+        load(v1, p + i + W);
+        lo = v0 < lo ? v0 : lo;
+        hi = v0 > hi ? v0 : hi;
+        lo1 = v1 < lo1 ? v1 : lo1;
+        hi1 = v1 > hi1 ? v1 : hi1;
+    }
+    lo = lo1 < lo ? lo1 : lo;
+    hi = hi1 > hi ? hi1 : hi;
+    min_max_result<T> r {lo[0], hi[0]};
+    for (std::size_t k {1}; k < W; ++k) {
+        r.min = lo[k] < r.min ? lo[k] : r.min;
+        r.max = hi[k] > r.max ? hi[k] : r.max;
+    }
+    for (; i < n; ++i) {
+        r.min = p[i] < r.min ? p[i] : r.min;
+        r.max = p[i] > r.max ? p[i] : r.max;
+    }
+    return r;
+}
+
+template <typename T, std::size_t R>
+PG_SERIES_INLINE double sum_sq_dev_body(const T *p, std::size_t n, double mean) {
+    constexpr std::size_t W {R / sizeof(double)};
+    using VD = typename vec<double, R>::type;
+    VD m = VD {} + mean;
+    VD a0 {}, a1 {};
+    std::size_t i {0};
+    for (; i + 2 * W <= n; i += 2 * W) {
+        VD v0, v1;
+        load_widen<VD, T, W>(v0, p + i);
+        load_widen<VD, T, W>(v1, p + i + W);
+        v0 -= m;
+        v1 -= m;
+        a0 += v0 * v0;
+        a1 += v1 * v1;
+    }
+    a0 += a1;
+    double s {0.0};
+    for (std::size_t k {0}; k < W; ++k)
+        s += a0[k];
+    for (; i < n; ++i) {
+        double d = static_cast<double>(p[i]) - mean;
+        s += d * d;
+    }
+    return s;
+}
+
+/* In-register inclusive scan (log2(W) shift-and-add steps), then add the running carry */
+template <typename T, std::size_t R>
+PG_SERIES_INLINE void prefix_sum_body(const T *p, std::size_t n, acc_t<T> *out) {
+    using A = acc_t<T>;
+    constexpr std::size_t W {R / sizeof(A)};
+    using VA = typename vec<A, R>::type;
+    using VM = typename vec<std::int64_t, R>::type;    // A is always 8 bytes wide
+    static_assert(sizeof(A) == 8, "shuffle mask assumes 8-byte lanes");
+    VA zero {};
+    VA carry {};
+    std::size_t i {0};
+    for (; i + W <= n; i += W) {
+        VA v;
+        load_widen<VA, T, W>(v, p + i);
+        for (std::size_t s {1}; s < W; s *= 2) {
+            VM mask;
+            for (std::size_t k {0}; k < W; ++k)
+                mask[k] = static_cast<std::int64_t>(k >= s ? k - s : W);    // W = lane 0 of zero
+            v += __builtin_shuffle(v, zero, mask);
+        }
+        v += carry;
+        store(out + i, v);
+        carry = VA {} + v[W - 1];
+    }
+    A s = i > 0 ? out[i - 1] : A {0};
+    for (; i < n; ++i)
+        out[i] = s += p[i];
+}
+
+template <typename T, std::size_t R>
+PG_SERIES_INLINE void moving_mean_body(const T *p, std::size_t n, std::size_t w, double *out) {
+    if (w == 0 || n < w)
+        return;
+    if (w > direct_window) {
+        moving_mean_running(p, n, w, out, 0);
+        return;
+    }
+    constexpr std::size_t W {R / sizeof(double)};
+    using VD = typename vec<double, R>::type;
+    const std::size_t outputs {n - w + 1};
+    const double width {static_cast<double>(w)};
+    std::size_t j {0};
+    for (; j + W <= outputs; j += W) {         // W windows at once, each summed in element order
+        VD s {};
+        for (std::size_t k {0}; k < w; ++k) {
+            VD v;
+            load_widen<VD, T, W>(v, p + j + k);
+            s += v;
+        }
+        s /= width;
+        store(out + j, s);
+    }
+    moving_mean_direct(p, n, w, out, j);
+}
+
+template <typename T, std::size_t R, bool Above>
+PG_SERIES_INLINE std::size_t count_body(const T *p, std::size_t n, T t) {
+    constexpr std::size_t W {R / sizeof(T)};
+    using VT = typename vec<T, R>::type;
+    using I = typename same_size_int<T>::type;
+    using VI = typename vec<I, R>::type;
+    constexpr std::size_t flush_every {std::size_t {1} << 20};    // keeps int32 lanes from overflowing
+    VT threshold = VT {} + t;
+    std::size_t total {0};
+    std::size_t i {0};
+    while (i + W <= n) {
+        VI c {};
+        for (std::size_t steps {0}; steps < flush_every && i + W <= n; ++steps, i += W) {
+            VT v;
+            load(v, p + i);
+            c -= Above ? (v > threshold) : (v < threshold);    // true lanes are -1
+        }
+        for (std::size_t k {0}; k < W; ++k)
+            total += static_cast<std::size_t>(c[k]);
+    }
+    return total + count_scalar<T, Above>(p + i, n - i, t);
+}
+
+/* Per-ISA entry points: same bodies, different target */
+#define PG_SERIES_ISA_KERNELS(name, bytes, attributes)                                              \
+    template <typename T> attributes acc_t<T> sum_##name(const T *p, std::size_t n) {               \
+        return sum_body<T, bytes>(p, n);                                                            \
+    }                                                                                               \
+    template <typename T> attributes min_max_result<T> min_max_##name(const T *p, std::size_t n) { \
+        return min_max_body<T, bytes>(p, n);                                                        \
+    }                                                                                               \
+    template <typename T> attributes double sum_sq_dev_##name(const T *p, std::size_t n, double m) { \
+        return sum_sq_dev_body<T, bytes>(p, n, m);                                                  \
+    }                                                                                               \
+    template <typename T> attributes void prefix_sum_##name(const T *p, std::size_t n, acc_t<T> *o) { \
+        prefix_sum_body<T, bytes>(p, n, o);                                                         \
+    }                                                                                               \
+    template <typename T>                                                                           \
+    attributes void moving_mean_##name(const T *p, std::size_t n, std::size_t w, double *o) {      \
+        moving_mean_body<T, bytes>(p, n, w, o);                                                     \
+    }                                                                                               \
+    template <typename T> attributes std::size_t count_above_##name(const T *p, std::size_t n, T t) { \
+        return count_body<T, bytes, true>(p, n, t);                                                 \
+    }                                                                                               \
+    template <typename T> attributes std::size_t count_below_##name(const T *p, std::size_t n, T t) { \
+        return count_body<T, bytes, false>(p, n, t);                                                \
+    }
+
+#if defined(__x86_64__)
+PG_SERIES_ISA_KERNELS(sse2, 16, )
+PG_SERIES_ISA_KERNELS(avx2, 32, __attribute__((target("avx2"))))
+PG_SERIES_ISA_KERNELS(avx512, 64, __attribute__((target("avx512f,avx512dq"))))
+#endif
+
+#undef PG_SERIES_ISA_KERNELS
+
+}   // namespace detail
+
+template <typename T>
+struct kernel_table {
+    vector_isa isa;
+    acc_t<T> (*sum)(const T *, std::size_t);
+    min_max_result<T> (*min_max)(const T *, std::size_t);
+    double (*sum_sq_dev)(const T *, std::size_t, double);
+    void (*prefix_sum)(const T *, std::size_t, acc_t<T> *);
+    void (*moving_mean)(const T *, std::size_t, std::size_t, double *);
+    std::size_t (*count_above)(const T *, std::size_t, T);
+    std::size_t (*count_below)(const T *, std::size_t, T);
+};
+
+/* Kernels for an explicit ISA (falls back to the widest supported level below it) */
+template <typename T>
+const kernel_table<T> &kernels(vector_isa isa) {
+    using namespace detail;
+    static const kernel_table<T> scalar {vector_isa::scalar, sum_scalar<T>, min_max_scalar<T>, sum_sq_dev_scalar<T>,
+                                         prefix_sum_scalar<T>, moving_mean_scalar<T>,
+                                         count_scalar<T, true>, count_scalar<T, false>};
+#if defined(__x86_64__)
+    static const kernel_table<T> sse2 {vector_isa::sse2, sum_sse2<T>, min_max_sse2<T>, sum_sq_dev_sse2<T>,
+                                       prefix_sum_sse2<T>, moving_mean_sse2<T>, count_above_sse2<T>,
+                                       count_below_sse2<T>};
+    static const kernel_table<T> avx2 {vector_isa::avx2, sum_avx2<T>, min_max_avx2<T>, sum_sq_dev_avx2<T>,
+                                       prefix_sum_avx2<T>, moving_mean_avx2<T>, count_above_avx2<T>,
+                                       count_below_avx2<T>};
+    static const kernel_table<T> avx512 {vector_isa::avx512, sum_avx512<T>, min_max_avx512<T>,
+                                         sum_sq_dev_avx512<T>, prefix_sum_avx512<T>, moving_mean_avx512<T>,
+                                         count_above_avx512<T>, count_below_avx512<T>};
+    if (isa == vector_isa::avx512 && cpu_supports(vector_isa::avx512))
+        return avx512;
+    if (isa >= vector_isa::avx2 && cpu_supports(vector_isa::avx2))
+        return avx2;
+    if (isa >= vector_isa::sse2)
+        return sse2;
+#endif
+    return scalar;
+}
+
+/* Kernels for this CPU */
+template <typename T>
+const kernel_table<T> &kernels() {
+    static const kernel_table<T> &table = kernels<T>(detected_vector_isa());
+    return table;
+}
+
+template <typename T>
+acc_t<T> sum(const T *data, std::size_t n) { return kernels<T>().sum(data, n); }
+
+template <typename T>
+min_max_result<T> min_max(const T *data, std::size_t n) { return kernels<T>().min_max(data, n); }
+
+template <typename T>
+mean_variance_result mean_variance(const T *data, std::size_t n) {
+    if (n == 0)
+        return {0.0, 0.0};
+    double mean = static_cast<double>(kernels<T>().sum(data, n)) / static_cast<double>(n);
+    double variance = n < 2 ? 0.0 : kernels<T>().sum_sq_dev(data, n, mean) / static_cast<double>(n - 1);
+    return {mean, variance};
+}
+
+template <typename T>
+void prefix_sum(const T *data, std::size_t n, acc_t<T> *out) { kernels<T>().prefix_sum(data, n, out); }
+
+template <typename T>
+void moving_mean(const T *data, std::size_t n, std::size_t window, double *out) {
+    kernels<T>().moving_mean(data, n, window, out);
+}
+
+template <typename T>
+std::size_t count_above(const T *data, std::size_t n, T threshold) {
+    return kernels<T>().count_above(data, n, threshold);
+}
+
+template <typename T>
+std::size_t count_below(const T *data, std::size_t n, T threshold) {
+    return kernels<T>().count_below(data, n, threshold);
+}
+
+}   // namespace series
+
+}   // namespace pg
+
+#undef PG_SERIES_INLINE
+
+#endif  // PG_SERIES_KERNELS_H
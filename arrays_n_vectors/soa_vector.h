@@ -0,0 +1,246 @@
+/**
+@file soa_vector.h
+
+@brief
+    Structure-of-arrays container
+        std::vector<person>       -> name num total | name num total | name num total ...
+        soa_vector<string, int, double> -> name name name ... | num num num ... | total total total ...
+
+@par
+    Why:
+        * A scan over one field of std::vector<struct> (sum every total) drags the whole
+          record (name, num, padding) through the cache and can't use packed SIMD loads.
+        * soa_vector keeps every field in its own contiguous column, so a column scan reads
+          only that field. Its loop vectorizes, and the column can go straight to the
+          pg::series kernels (series_kernels.h).
+    Fields are addressed by index; an enum keeps call sites readable:
+        enum person_field { name, num, total };
+        pg::soa_vector<std::string, int, double> people {};
+        people.push_back("Larry", 100, 255.67);
+        double sum {0.0};
+        for (double t : people.column<total>())
+            sum += t;
+    Rows:
+        * people[i] is a row_ref: get<num>() returns a reference into the num column, and
+          load()/store() move the whole row as a std::tuple.
+        * Iterating the container gives row_refs, so AoS-style loops still work.
+    Modifiers:
+        push_back (one value per field, or a row tuple; if a column throws, the columns
+        already extended are rolled back), erase(i) (keeps order),
+        swap_erase(i) (O(1)), clear, reserve,
+        sort_by<I>(comp) (stable; one permutation applied to every column).
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_SOA_VECTOR_H
+#define PG_SOA_VECTOR_H
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace pg {
+
+/* Contiguous column of a soa_vector (pointer + size, like a C++20 std::span) */
+template <typename T>
+class column_view {
+public:
+    column_view(T *data, std::size_t size) : data_ {data}, size_ {size} {}
+
+    T *data() const { return data_; }
+    std::size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+    T &operator[](std::size_t i) const { return data_[i]; }
+    T *begin() const { return data_; }
+    T *end() const { return data_ + size_; }
+
+private:
+    T *data_;
+    std::size_t size_;
+};
+
+template <typename... Fields>
+class soa_vector {
+    static_assert(sizeof...(Fields) > 0, "soa_vector needs at least one field");
+    static_assert((!std::is_same_v<Fields, bool> && ...),
+                  "std::vector<bool> isn't contiguous; use char or std::uint8_t columns");
+
+public:
+    static constexpr std::size_t field_count {sizeof...(Fields)};
+    using row_tuple = std::tuple<Fields...>;
+
+    template <std::size_t I>
+    using field_type = std::tuple_element_t<I, row_tuple>;
+
+    /* One row, by reference into the columns; valid until the container is resized */
+    template <bool Const>
+    class basic_row_ref {
+        using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+    public:
+        basic_row_ref(owner *v, std::size_t i) : v_ {v}, i_ {i} {}
+
+        template <std::size_t I>
+        decltype(auto) get() const { return std::get<I>(v_->columns_)[i_]; }
+
+        row_tuple load() const { return load(std::index_sequence_for<Fields...> {}); }
+
+        template <bool C = Const, typename = std::enable_if_t<!C>>
+        void store(const row_tuple &row) const { store(row, std::index_sequence_for<Fields...> {}); }
+
+        std::size_t index() const { return i_; }
+
+    private:
+        template <std::size_t... I>
+        row_tuple load(std::index_sequence<I...>) const { return row_tuple {std::get<I>(v_->columns_)[i_]...}; }
+
+        template <std::size_t... I>
+        void store(const row_tuple &row, std::index_sequence<I...>) const {
+            ((std::get<I>(v_->columns_)[i_] = std::get<I>(row)), ...);
+        }
+
+        owner *v_;
+        std::size_t i_;
+    };
+
+    using row_ref = basic_row_ref<false>;
+    using const_row_ref = basic_row_ref<true>;
+
+    template <bool Const>
+    class basic_iterator {
+        using owner = std::conditional_t<Const, const soa_vector, soa_vector>;
+
+    public:
+        basic_iterator(owner *v, std::size_t i) : v_ {v}, i_ {i} {}
+        basic_row_ref<Const> operator*() const { return {v_, i_}; }
+        basic_iterator &operator++() {
+            ++i_;
+            return *this;
+        }
+        bool operator!=(const basic_iterator &o) const { return i_ != o.i_; }
+        bool operator==(const basic_iterator &o) const { return i_ == o.i_; }
+
+    private:
+        owner *v_;
+        std::size_t i_;
+    };
+
+    soa_vector() = default;
+
+    /* Size */
+    std::size_t size() const { return std::get<0>(columns_).size(); }
+    bool empty() const { return size() == 0; }
+
+    void reserve(std::size_t n) {
+        for_each_column([n](auto &c) { c.reserve(n); });
+    }
+
+    void clear() {
+        for_each_column([](auto &c) { c.clear(); });
+    }
+
+    /* Columns */
+    template <std::size_t I>
+    column_view<field_type<I>> column() {
+        auto &c = std::get<I>(columns_);
+        return {c.data(), c.size()};
+    }
+
+    template <std::size_t I>
+    column_view<const field_type<I>> column() const {
+        const auto &c = std::get<I>(columns_);
+        return {c.data(), c.size()};
+    }
+
+    /* Rows */
+    row_ref operator[](std::size_t i) { return {this, i}; }
+    const_row_ref operator[](std::size_t i) const { return {this, i}; }
+
+    basic_iterator<false> begin() { return {this, 0}; }
+    basic_iterator<false> end() { return {this, size()}; }
+    basic_iterator<true> begin() const { return {this, 0}; }
+    basic_iterator<true> end() const { return {this, size()}; }
+
+    /* Modifiers */
+    template <typename... Args, typename = std::enable_if_t<sizeof...(Args) == field_count>>
+    void push_back(Args &&...values) {
+        push_back_impl(std::index_sequence_for<Fields...> {}, std::forward<Args>(values)...);
+    }
+
+    void push_back(const row_tuple &row) {
+        std::apply([this](const Fields &...values) { push_back(values...); }, row);
+    }
+
+    /* Remove row i, keeping the order of the others */
+    void erase(std::size_t i) {
+        for_each_column([i](auto &c) { c.erase(c.begin() + static_cast<std::ptrdiff_t>(i)); });
+    }
+
+    /* Remove row i by moving the last row into its place */
+    void swap_erase(std::size_t i) {
+        for_each_column([i](auto &c) {
+            if (i + 1 != c.size())
+                c[i] = std::move(c.back());
+            c.pop_back();
+        });
+    }
+
+    /* Stable sort of all rows by column I */
+    template <std::size_t I, typename Compare = std::less<field_type<I>>>
+    void sort_by(Compare comp = Compare {}) {
+        const auto &key = std::get<I>(columns_);
+        std::vector<std::size_t> order(size());
+        std::iota(order.begin(), order.end(), std::size_t {0});
+        std::stable_sort(order.begin(), order.end(),
+                         [&](std::size_t a, std::size_t b) { return comp(key[a], key[b]); });
+        for_each_column([&order](auto &c) {
+            std::remove_reference_t<decltype(c)> sorted {};
+            sorted.reserve(c.size());
+            for (std::size_t from : order)
+                sorted.push_back(std::move(c[from]));
+            c.swap(sorted);
+        });
+    }
+
+private:
+    template <typename F>
+    void for_each_column(F &&f) {
+        std::apply([&f](auto &...c) { (f(c), ...); }, columns_);
+    }
+
+    // A throwing column (bad_alloc, a copy constructor) leaves the earlier ones a row longer: undo them
+    template <std::size_t... I, typename... Args>
+    void push_back_impl(std::index_sequence<I...>, Args &&...values) {
+        std::size_t rows {size()};
+        try {
+            (std::get<I>(columns_).push_back(std::forward<Args>(values)), ...);
+        } catch (...) {
+            for_each_column([rows](auto &c) {
+                if (c.size() > rows)
+                    c.pop_back();
+            });
+            throw;
+        }
+    }
+
+    std::tuple<std::vector<Fields>...> columns_ {};
+};
+
+}   // namespace pg
+
+#endif  // PG_SOA_VECTOR_H
@@ -0,0 +1,160 @@
+/**
+@file soa_vector_example.cpp
+
+@brief
+    The name/num/total records from file_input_output.cpp stored as std::vector<person>
+    and as pg::soa_vector (soa_vector.h): column scans, row views, sort and erase.
+
+@par
+    Benchmarked scans over 10M records (results must match):
+        sum of total -> std::vector<person> loop vs soa column loop vs pg::series::sum
+        count of num > threshold -> std::vector<person> loop vs soa column loop
+    Reported: ns per record and speedup over std::vector<person>.
+    Also checked: a push_back whose last column throws leaves every column the same length.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "series_kernels.h"
+#include "soa_vector.h"
+
+struct person {
+    std::string name;
+    std::int32_t num;
+    double total;
+};
+
+/* Copying it throws when armed, to break a push_back halfway through the columns */
+struct throwing_copy {
+    static inline bool armed {false};
+    int value {0};
+    throwing_copy() = default;
+    throwing_copy(int v) : value {v} {}
+    throwing_copy(const throwing_copy &other) : value {other.value} {
+        if (armed)
+            throw std::runtime_error {"copy failed"};
+    }
+    throwing_copy &operator=(const throwing_copy &) = default;
+};
+
+enum person_field { name, num, total };
+using person_table = pg::soa_vector<std::string, std::int32_t, double>;
+
+template <typename Body>
+static double ns_per_record(std::size_t n, Body body) {
+    body();
+    auto start = std::chrono::steady_clock::now();
+    const int reps {10};
+    for (int r {0}; r < reps; ++r)
+        body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 / (double(n) * reps);
+}
+
+static void report(const std::string &label, double ns, double baseline, bool ok) {
+    std::cout << std::left << std::setw(30) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(8) << ns << " ns/record   x" << std::setprecision(1) << baseline / ns
+              << (ok ? "" : "   MISMATCH") << std::endl;
+}
+
+int main() {
+    /* Rows, columns, sort, erase */
+    person_table people {};
+    people.push_back("Larry", 100, 255.67);
+    people.push_back("Moe", 300, 10.5);
+    people.push_back("Curly", 200, 1234.5);
+    people.sort_by<num>();
+    people.erase(0);                            // drops Larry (num 100)
+    people[0].get<total>() += 1.0;              // row view writes into the total column
+    for (auto row : people)
+        std::cout << row.get<name>() << " " << row.get<num>() << " " << row.get<total>() << std::endl;
+
+    /* Benchmark */
+    const std::size_t count {10'000'000};
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    std::vector<person> aos {};
+    person_table soa {};
+    aos.reserve(count);
+    soa.reserve(count);
+    for (std::size_t i {0}; i < count; ++i) {
+        std::int32_t n = static_cast<std::int32_t>(i % 1000);
+        double t = static_cast<double>(i % 4096) * 0.25;   // exact sums in any order
+        aos.push_back({names[i % 4], n, t});
+        soa.push_back(names[i % 4], n, t);
+    }
+
+    bool all_ok {true};
+    double aos_sum {0.0}, soa_sum {0.0}, kernel_sum {0.0};
+    double base = ns_per_record(count, [&] {
+        double s {0.0};
+        for (const person &p : aos)
+            s += p.total;
+        aos_sum = s;
+    });
+    report("sum total: vector<person>", base, base, true);
+    double ns = ns_per_record(count, [&] {
+        double s {0.0};
+        for (double t : soa.column<total>())
+            s += t;
+        soa_sum = s;
+    });
+    report("sum total: soa column", ns, base, soa_sum == aos_sum);
+    ns = ns_per_record(count, [&] {
+        kernel_sum = pg::series::sum(soa.column<total>().data(), soa.size());
+    });
+    report("sum total: soa + series::sum", ns, base, kernel_sum == aos_sum);
+    all_ok = all_ok && soa_sum == aos_sum && kernel_sum == aos_sum;
+
+    std::size_t aos_count {0}, soa_count {0};
+    base = ns_per_record(count, [&] {
+        std::size_t c {0};
+        for (const person &p : aos)
+            c += p.num > 500;
+        aos_count = c;
+    });
+    report("count num > 500: vector<person>", base, base, true);
+    ns = ns_per_record(count, [&] {
+        std::size_t c {0};
+        for (std::int32_t n : soa.column<num>())
+            c += n > 500;
+        soa_count = c;
+    });
+    report("count num > 500: soa column", ns, base, soa_count == aos_count);
+    all_ok = all_ok && soa_count == aos_count;
+
+    /* A throwing column: the columns before it are rolled back */
+    pg::soa_vector<std::string, int, throwing_copy> partial {};
+    partial.push_back(std::string {"Larry"}, 1, throwing_copy {1});
+    const throwing_copy bad {2};
+    throwing_copy::armed = true;
+    bool threw {false};
+    try {
+        partial.push_back(std::string {"Moe"}, 2, bad);
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+    throwing_copy::armed = false;
+    bool rolled_back = threw && partial.size() == 1 && partial.column<1>().size() == 1 &&
+                       partial.column<2>().size() == 1 && partial[0].get<0>() == "Larry";
+    std::cout << "push_back rolled back: " << std::boolalpha << rolled_back << std::endl;
+    all_ok = all_ok && rolled_back;
+
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
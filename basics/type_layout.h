@@ -0,0 +1,228 @@
+/**
+@file type_layout.h
+
+@brief
+    Compile-time layout of the primitive types and of the target
+        size, alignment, signedness, numeric limits, endianness, data model,
+        cache-line size and the SIMD ISA the code is compiled for.
+
+@par
+    Why:
+        * primitive_datatypes.cpp prints sizeof() one line at a time, and the comments next to
+          it ("long // 32 bits") are only true on some targets (long is 64 bits on LP64 Linux).
+        * Binary formats (binary_records.h, append_log.h) and SIMD widths (series_kernels.h)
+          depend on these numbers, so they need to be checked at build time, not read off a
+          console.
+    Everything here is constexpr:
+        pg::layout_of<T>("name") -> type_layout {size, align, is_signed, limits, ...}
+        pg::primitive_layouts -> table of the built-in types (and size_t, pointers, max_align_t)
+        pg::find_layout("long") -> entry of the table, nullptr if unknown
+        pg::native_endian, pg::data_model, pg::cache_line_size, pg::compiled_simd
+    Build guards (static_assert, a mismatch stops the build):
+        PG_EXPECT_LAYOUT(type, size, align)
+        PG_EXPECT_ENDIAN(little)
+        PG_EXPECT_DATA_MODEL(lp64)
+        Baseline guards the repo relies on (8-bit char, IEEE-754 float/double, two's
+        complement fixed-width integers) are always on; define PG_NO_LAYOUT_GUARDS to skip them.
+    type_layout_report.cpp prints all of it as JSON, and --guards emits the
+    PG_EXPECT_* lines that pin the current target.
+    Limits of integers are exact (intmax_t/uintmax_t); floating limits are long double.
+    cache_line_size is PG_CACHE_LINE_SIZE (default 64; 128 on Apple arm64), a compile-time
+    constant for alignas(); the report tool also shows what the OS reports.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_TYPE_LAYOUT_H
+#define PG_TYPE_LAYOUT_H
+
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string_view>
+
+#ifndef PG_CACHE_LINE_SIZE
+#if defined(__APPLE__) && defined(__aarch64__)
+#define PG_CACHE_LINE_SIZE 128
+#else
+#define PG_CACHE_LINE_SIZE 64
+#endif
+#endif
+
+namespace pg {
+
+/* Types */
+struct type_layout {
+    const char *name;
+    std::size_t size;
+    std::size_t align;
+    bool is_signed;
+    bool is_integer;
+    bool is_iec559;                 // IEEE-754 floating point
+    int digits;                     // value bits (integers) or mantissa bits (floating)
+    int max_digits10;               // digits needed to round-trip a floating value
+    std::intmax_t int_min;          // integers only
+    std::uintmax_t int_max;
+    long double float_lowest;       // floating only
+    long double float_max;
+    long double float_min;          // smallest normal
+    long double epsilon;
+};
+
+template <typename T>
+constexpr type_layout layout_of(const char *name) {
+    using limits = std::numeric_limits<T>;
+    type_layout l {name, sizeof(T), alignof(T), limits::is_signed, limits::is_integer, limits::is_iec559,
+                   limits::digits, limits::max_digits10, 0, 0, 0.0L, 0.0L, 0.0L, 0.0L};
+    if constexpr (limits::is_integer) {
+        l.int_min = static_cast<std::intmax_t>(limits::min());
+        l.int_max = static_cast<std::uintmax_t>(limits::max());
+    } else if constexpr (limits::is_specialized) {
+        l.float_lowest = static_cast<long double>(limits::lowest());
+        l.float_max = static_cast<long double>(limits::max());
+        l.float_min = static_cast<long double>(limits::min());
+        l.epsilon = static_cast<long double>(limits::epsilon());
+    }
+    return l;
+}
+
+constexpr type_layout primitive_layouts[] {
+    layout_of<bool>("bool"),
+    layout_of<char>("char"),
+    layout_of<signed char>("signed char"),
+    layout_of<unsigned char>("unsigned char"),
+    layout_of<char16_t>("char16_t"),
+    layout_of<char32_t>("char32_t"),
+    layout_of<wchar_t>("wchar_t"),
+    layout_of<short>("short"),
+    layout_of<int>("int"),
+    layout_of<long>("long"),
+    layout_of<long long>("long long"),
+    layout_of<unsigned short>("unsigned short"),
+    layout_of<unsigned>("unsigned int"),
+    layout_of<unsigned long>("unsigned long"),
+    layout_of<unsigned long long>("unsigned long long"),
+    layout_of<float>("float"),
+    layout_of<double>("double"),
+    layout_of<long double>("long double"),
+    layout_of<std::size_t>("size_t"),
+    layout_of<std::ptrdiff_t>("ptrdiff_t"),
+    layout_of<std::uintptr_t>("uintptr_t"),
+    layout_of<void *>("void*"),
+    layout_of<std::max_align_t>("max_align_t"),
+};
+
+constexpr const type_layout *find_layout(std::string_view name) {
+    for (const type_layout &l : primitive_layouts) {
+        if (name == l.name)
+            return &l;
+    }
+    return nullptr;
+}
+
+/* Target */
+enum class endian_order { little, big };
+
+constexpr endian_order native_endian =
+    __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__ ? endian_order::big : endian_order::little;
+
+constexpr const char *to_string(endian_order e) { return e == endian_order::big ? "big" : "little"; }
+
+enum class data_model_kind { ilp32, lp64, llp64, other };
+
+constexpr data_model_kind data_model = sizeof(void *) == 4 && sizeof(long) == 4 && sizeof(int) == 4 ? data_model_kind::ilp32
+                                     : sizeof(void *) == 8 && sizeof(long) == 8 && sizeof(int) == 4 ? data_model_kind::lp64
+                                     : sizeof(void *) == 8 && sizeof(long) == 4 && sizeof(int) == 4 ? data_model_kind::llp64
+                                                                                                     : data_model_kind::other;
+
+constexpr const char *to_string(data_model_kind m) {
+    switch (m) {
+    case data_model_kind::ilp32: return "ILP32";
+    case data_model_kind::lp64: return "LP64";
+    case data_model_kind::llp64: return "LLP64";
+    default: return "other";
+    }
+}
+
+constexpr std::size_t cache_line_size {PG_CACHE_LINE_SIZE};
+
+/* Instruction sets enabled by the compiler flags (-msse4.2, -mavx2, -march=native, ...) */
+struct simd_features {
+    bool sse2;
+    bool sse4_2;
+    bool avx;
+    bool avx2;
+    bool avx512f;
+    bool neon;
+
+    /* Widest vector register the compiled code may use, in bytes */
+    constexpr std::size_t vector_bytes() const {
+        return avx512f ? 64 : avx ? 32 : (sse2 || neon) ? 16 : sizeof(void *);
+    }
+};
+
+constexpr simd_features compiled_simd {
+#ifdef __SSE2__
+    true,
+#else
+    false,
+#endif
+#ifdef __SSE4_2__
+    true,
+#else
+    false,
+#endif
+#ifdef __AVX__
+    true,
+#else
+    false,
+#endif
+#ifdef __AVX2__
+    true,
+#else
+    false,
+#endif
+#ifdef __AVX512F__
+    true,
+#else
+    false,
+#endif
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+    true,
+#else
+    false,
+#endif
+};
+
+}   // namespace pg
+
+/* Build guards */
+#define PG_EXPECT_LAYOUT(type, expected_size, expected_align)                                  \
+    static_assert(sizeof(type) == (expected_size) && alignof(type) == (expected_align),         \
+                  "layout of " #type " is not " #expected_size " bytes / align " #expected_align)
+
+#define PG_EXPECT_ENDIAN(order) \
+    static_assert(pg::native_endian == pg::endian_order::order, "target is not " #order "-endian")
+
+#define PG_EXPECT_DATA_MODEL(model) \
+    static_assert(pg::data_model == pg::data_model_kind::model, "target data model is not " #model)
+
+#ifndef PG_NO_LAYOUT_GUARDS
+static_assert(CHAR_BIT == 8, "8-bit bytes are assumed throughout");
+static_assert(std::numeric_limits<float>::is_iec559 && sizeof(float) == 4, "float must be IEEE-754 binary32");
+static_assert(std::numeric_limits<double>::is_iec559 && sizeof(double) == 8, "double must be IEEE-754 binary64");
+static_assert(static_cast<std::int32_t>(0xFFFFFFFFu) == -1, "two's complement integers are assumed");
+static_assert(sizeof(std::int64_t) == 8 && alignof(std::int64_t) <= 8, "int64_t must be 8 bytes");
+#endif
+
+#endif  // PG_TYPE_LAYOUT_H
@@ -0,0 +1,147 @@
+/**
+@file type_layout_report.cpp
+
+@brief
+    Layout report of the build target as JSON (type_layout.h)
+        ./type_layout_report            -> JSON on stdout
+        ./type_layout_report --guards   -> PG_EXPECT_* lines pinning this target's layout
+
+@par
+    JSON fields:
+        target: endianness, data model, compiler, cache line (compile-time and OS-reported),
+                SIMD ISAs enabled at compile time and supported by the running CPU
+        types: name, size, align, signed, integer, iec559, digits, and the limits
+               (min/max for integers, lowest/max/min/epsilon for floating types)
+    The --guards output is meant to be saved as a header and included in a build of
+    another target, where any difference stops compilation:
+        ./type_layout_report --guards > layout_guards.h
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <cctype>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+#include "type_layout.h"
+
+// Pinned by this tool's own build; see --guards
+PG_EXPECT_LAYOUT(char, 1, 1);
+PG_EXPECT_LAYOUT(double, 8, 8);
+
+static std::string format_float(long double v, int digits) {
+    char text[64];
+    std::snprintf(text, sizeof text, "%.*Lg", digits > 0 ? digits : 21, v);
+    return text;
+}
+
+/* Cache line the OS reports, 0 if unknown */
+static long os_cache_line() {
+    long n {0};
+#ifdef _SC_LEVEL1_DCACHE_LINESIZE
+    n = ::sysconf(_SC_LEVEL1_DCACHE_LINESIZE);
+#endif
+    if (n <= 0) {
+        std::ifstream in_file {"/sys/devices/system/cpu/cpu0/cache/index0/coherency_line_size"};
+        if (!(in_file >> n))
+            n = 0;
+    }
+    return n;
+}
+
+static void print_runtime_simd() {
+    const char *sep = "";
+    std::cout << "[";
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_cpu_init();
+    const char *names[] {"sse2", "sse4.2", "avx", "avx2", "avx512f", "avx512bw", "avx512vl"};
+    bool has[] {__builtin_cpu_supports("sse2") != 0,    __builtin_cpu_supports("sse4.2") != 0,
+                __builtin_cpu_supports("avx") != 0,     __builtin_cpu_supports("avx2") != 0,
+                __builtin_cpu_supports("avx512f") != 0, __builtin_cpu_supports("avx512bw") != 0,
+                __builtin_cpu_supports("avx512vl") != 0};
+    for (std::size_t i {0}; i < sizeof names / sizeof names[0]; ++i) {
+        if (has[i]) {
+            std::cout << sep << '"' << names[i] << '"';
+            sep = ", ";
+        }
+    }
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    std::cout << "\"neon\"";
+#endif
+    std::cout << "]";
+}
+
+static void print_json() {
+    const pg::simd_features &s = pg::compiled_simd;
+    std::cout << "{\n  \"target\": {\n"
+              << "    \"endian\": \"" << pg::to_string(pg::native_endian) << "\",\n"
+              << "    \"data_model\": \"" << pg::to_string(pg::data_model) << "\",\n"
+              << "    \"compiler\": \"" << __VERSION__ << "\",\n"
+              << "    \"cplusplus\": " << __cplusplus << ",\n"
+              << "    \"cache_line\": " << pg::cache_line_size << ",\n"
+              << "    \"os_cache_line\": " << os_cache_line() << ",\n"
+              << "    \"compiled_simd\": {\"sse2\": " << s.sse2 << ", \"sse4_2\": " << s.sse4_2
+              << ", \"avx\": " << s.avx << ", \"avx2\": " << s.avx2 << ", \"avx512f\": " << s.avx512f
+              << ", \"neon\": " << s.neon << "},\n"
+              << "    \"compiled_vector_bytes\": " << s.vector_bytes() << ",\n"
+              << "    \"cpu_simd\": ";
+    print_runtime_simd();
+    std::cout << "\n  },\n  \"types\": [\n";
+
+    const std::size_t count {sizeof pg::primitive_layouts / sizeof pg::primitive_layouts[0]};
+    for (std::size_t i {0}; i < count; ++i) {
+        const pg::type_layout &l = pg::primitive_layouts[i];
+        std::cout << "    {\"name\": \"" << l.name << "\", \"size\": " << l.size << ", \"align\": " << l.align
+                  << ", \"signed\": " << l.is_signed << ", \"integer\": " << l.is_integer
+                  << ", \"iec559\": " << l.is_iec559 << ", \"digits\": " << l.digits;
+        if (l.is_integer) {
+            std::cout << ", \"min\": " << l.int_min << ", \"max\": " << l.int_max;
+        } else if (l.digits > 0) {
+            std::cout << ", \"lowest\": " << format_float(l.float_lowest, l.max_digits10)
+                      << ", \"max\": " << format_float(l.float_max, l.max_digits10)
+                      << ", \"min\": " << format_float(l.float_min, l.max_digits10)
+                      << ", \"epsilon\": " << format_float(l.epsilon, l.max_digits10);
+        }
+        std::cout << "}" << (i + 1 < count ? "," : "") << "\n";
+    }
+    std::cout << "  ]\n}" << std::endl;
+}
+
+static void print_guards() {
+    std::cout << "// Generated by type_layout_report --guards\n#include \"type_layout.h\"\n\n"
+              << "PG_EXPECT_ENDIAN(" << pg::to_string(pg::native_endian) << ");\n";
+    if (pg::data_model != pg::data_model_kind::other) {
+        std::string model = pg::to_string(pg::data_model);
+        for (char &c : model)
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        std::cout << "PG_EXPECT_DATA_MODEL(" << model << ");\n";
+    }
+    for (const pg::type_layout &l : pg::primitive_layouts) {
+        std::string type = l.name;
+        if (type == "size_t" || type == "ptrdiff_t" || type == "uintptr_t" || type == "max_align_t")
+            type = "std::" + type;
+        std::cout << "PG_EXPECT_LAYOUT(" << type << ", " << l.size << ", " << l.align << ");\n";
+    }
+}
+
+int main(int argc, char *argv[]) {
+    std::cout << std::boolalpha;
+    if (argc > 1 && std::string {argv[1]} == "--guards")
+        print_guards();
+    else
+        print_json();
+    return 0;
+}
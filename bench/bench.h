@@ -0,0 +1,426 @@
+/**
+@file bench.h
+
+@brief
+    Micro-benchmark harness
+        benchmark body ===> calibrate ===> warmup ===> repetitions (+ perf counters)
+                       ===> statistics ===> text table / JSON baseline ===> compare against baseline
+
+@par
+    Why:
+        * The timings in the *_example.cpp programs are one run each, with no warmup and no
+          spread, so a 5% change can't be told apart from noise, and nothing is kept to
+          compare the next build against.
+    Running:
+        * Each benchmark body does one unit of work (read the file once, format 100k lines).
+        * calibrate: the body is repeated until one repetition takes at least min_time.
+        * warmup repetitions run first and are dropped (page cache, branch predictors, CPU clock).
+        * Each repetition gives one ns-per-iteration sample; stats are min, median, mean,
+          stddev and p90 over the samples. Throughput (MB/s) is from the median.
+    Perf counters (Linux, perf_event_open):
+        cycles, instructions, cache misses and branch misses per iteration, read as one group.
+        When the kernel refuses (perf_event_paranoid, containers) they are reported as null
+        and the run goes on without them.
+    Baselines:
+        * write_json() saves a run; read_baseline() loads the name -> median ns pairs back.
+        * compare() flags every benchmark whose median got slower than baseline * (1 + threshold).
+        * run_main() wires it all to a command line:
+            --filter s --repetitions n --warmup n --min-time sec --no-perf
+            --json out.json                 save this run
+            --baseline base.json [--threshold 0.10]   exit code 1 on a regression
+    Usage:
+        pg::bench::suite s {};
+        s.add("array/sum", n * sizeof(double), [&] { pg::bench::do_not_optimize(sum(v)); });
+        return pg::bench::run_main(argc, argv, s);
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_BENCH_H
+#define PG_BENCH_H
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace pg::bench {
+
+/* Keep a value (and everything it was computed from) alive past the optimizer */
+template <typename T>
+inline void do_not_optimize(const T &value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void clobber_memory() { asm volatile("" : : : "memory"); }
+
+struct options {
+    int warmup {2};
+    int repetitions {10};
+    double min_time {0.05};             // seconds per repetition
+    bool perf {true};
+    std::string filter {};              // substring of the benchmark name
+};
+
+struct stats {
+    double min {0.0};
+    double median {0.0};
+    double mean {0.0};
+    double stddev {0.0};
+    double p90 {0.0};
+};
+
+inline stats summarize(std::vector<double> samples) {
+    stats s {};
+    if (samples.empty())
+        return s;
+    std::sort(samples.begin(), samples.end());
+    std::size_t n = samples.size();
+    s.min = samples.front();
+    s.median = n % 2 ? samples[n / 2] : (samples[n / 2 - 1] + samples[n / 2]) / 2.0;
+    for (double v : samples)
+        s.mean += v;
+    s.mean /= double(n);
+    for (double v : samples)
+        s.stddev += (v - s.mean) * (v - s.mean);
+    s.stddev = n > 1 ? std::sqrt(s.stddev / double(n - 1)) : 0.0;
+    s.p90 = samples[std::min(n - 1, static_cast<std::size_t>(std::ceil(0.9 * double(n))) - 1)];
+    return s;
+}
+
+/* Hardware counters per iteration; valid is false when they couldn't be read */
+struct perf_counters {
+    bool valid {false};
+    double cycles {0.0};
+    double instructions {0.0};
+    double cache_misses {0.0};
+    double branch_misses {0.0};
+};
+
+/* One perf_event group for the calling thread */
+class perf_group {
+public:
+    perf_group() {
+#ifdef __linux__
+        const std::uint64_t configs[] {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                       PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+        for (std::uint64_t config : configs) {
+            perf_event_attr attr {};
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.size = sizeof attr;
+            attr.config = config;
+            attr.disabled = fds_.empty() ? 1 : 0;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            attr.read_format = PERF_FORMAT_GROUP;
+            int fd = static_cast<int>(::syscall(SYS_perf_event_open, &attr, 0, -1, fds_.empty() ? -1 : fds_[0], 0));
+            if (fd < 0) {
+                close_all();
+                return;
+            }
+            fds_.push_back(fd);
+        }
+#endif
+    }
+
+    perf_group(const perf_group &) = delete;
+    perf_group &operator=(const perf_group &) = delete;
+    ~perf_group() { close_all(); }
+
+    explicit operator bool() const { return !fds_.empty(); }
+
+    void start() {
+#ifdef __linux__
+        if (!fds_.empty()) {
+            ::ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ::ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    /* Adds the counts since start() to totals */
+    bool stop(perf_counters &totals) {
+#ifdef __linux__
+        if (fds_.empty())
+            return false;
+        ::ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        std::uint64_t values[1 + 4] {};
+        if (::read(fds_[0], values, sizeof values) != static_cast<ssize_t>(sizeof values) || values[0] != 4)
+            return false;
+        totals.cycles += double(values[1]);
+        totals.instructions += double(values[2]);
+        totals.cache_misses += double(values[3]);
+        totals.branch_misses += double(values[4]);
+        return true;
+#else
+        (void)totals;
+        return false;
+#endif
+    }
+
+private:
+    void close_all() {
+#ifdef __linux__
+        for (int fd : fds_)
+            ::close(fd);
+#endif
+        fds_.clear();
+    }
+
+    std::vector<int> fds_ {};
+};
+
+struct result {
+    std::string name;
+    std::size_t bytes {0};              // processed per iteration, 0 if not a throughput benchmark
+    std::size_t iterations {0};         // per repetition
+    stats ns {};                        // ns per iteration
+    perf_counters perf {};
+
+    double mb_per_sec() const { return bytes && ns.median > 0.0 ? double(bytes) / ns.median * 1e3 : 0.0; }
+};
+
+class suite {
+public:
+    void add(std::string name, std::size_t bytes_per_iteration, std::function<void()> body) {
+        benchmarks_.push_back({std::move(name), bytes_per_iteration, std::move(body)});
+    }
+
+    std::vector<result> run(const options &opt, std::ostream *progress = &std::cout) const {
+        std::vector<result> results {};
+        perf_group perf {};
+        if (opt.perf && !perf && progress)
+            *progress << "perf counters unavailable; timing only" << std::endl;
+        for (const benchmark &b : benchmarks_) {
+            if (!opt.filter.empty() && b.name.find(opt.filter) == std::string::npos)
+                continue;
+            result r {b.name, b.bytes, calibrate(b, opt.min_time)};
+            for (int w {0}; w < opt.warmup; ++w)
+                repeat(b, r.iterations);
+            std::vector<double> samples {};
+            perf_counters totals {};
+            bool counted = opt.perf && static_cast<bool>(perf);
+            for (int rep {0}; rep < std::max(1, opt.repetitions); ++rep) {
+                if (counted)
+                    perf.start();
+                double seconds = repeat(b, r.iterations);
+                if (counted)
+                    counted = perf.stop(totals);
+                samples.push_back(seconds * 1e9 / double(r.iterations));
+            }
+            r.ns = summarize(samples);
+            if (counted) {
+                double n = double(r.iterations) * double(samples.size());
+                r.perf = {true, totals.cycles / n, totals.instructions / n, totals.cache_misses / n,
+                          totals.branch_misses / n};
+            }
+            if (progress)
+                print(*progress, r);
+            results.push_back(std::move(r));
+        }
+        return results;
+    }
+
+    static void print(std::ostream &os, const result &r) {
+        os << std::left << std::setw(28) << r.name << std::right << std::fixed << std::setprecision(1)
+           << std::setw(14) << r.ns.median << " ns  +-" << std::setw(5)
+           << (r.ns.median > 0.0 ? 100.0 * r.ns.stddev / r.ns.median : 0.0) << "%";
+        if (r.bytes)
+            os << std::setw(10) << r.mb_per_sec() << " MB/s";
+        if (r.perf.valid)
+            os << "   IPC " << std::setprecision(2) << r.perf.instructions / std::max(1.0, r.perf.cycles);
+        os << std::endl;
+    }
+
+private:
+    struct benchmark {
+        std::string name;
+        std::size_t bytes;
+        std::function<void()> body;
+    };
+
+    static double repeat(const benchmark &b, std::size_t iterations) {
+        auto start = std::chrono::steady_clock::now();
+        for (std::size_t i {0}; i < iterations; ++i)
+            b.body();
+        clobber_memory();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    // Iterations per repetition so that one repetition takes at least min_time
+    static std::size_t calibrate(const benchmark &b, double min_time) {
+        std::size_t iterations {1};
+        for (;;) {
+            double seconds = repeat(b, iterations);
+            if (seconds >= min_time || iterations >= (std::size_t {1} << 30))
+                return iterations;
+            double grow = seconds > 0.0 ? 1.4 * min_time / seconds : 10.0;
+            iterations = static_cast<std::size_t>(double(iterations) * std::clamp(grow, 2.0, 10.0));
+        }
+    }
+
+    std::vector<benchmark> benchmarks_ {};
+};
+
+/* JSON */
+inline std::string json_number(double v, bool valid = true) {
+    if (!valid || !std::isfinite(v))
+        return "null";
+    std::ostringstream os {};
+    os << std::setprecision(6) << v;
+    return os.str();
+}
+
+inline void write_json(std::ostream &os, const std::vector<result> &results) {
+    os << "{\n  \"benchmarks\": [\n";
+    for (std::size_t i {0}; i < results.size(); ++i) {
+        const result &r = results[i];
+        const perf_counters &p = r.perf;
+        os << "    {\"name\": \"" << r.name << "\", \"bytes\": " << r.bytes << ", \"iterations\": " << r.iterations
+           << ", \"median_ns\": " << json_number(r.ns.median) << ", \"mean_ns\": " << json_number(r.ns.mean)
+           << ", \"min_ns\": " << json_number(r.ns.min) << ", \"stddev_ns\": " << json_number(r.ns.stddev)
+           << ", \"p90_ns\": " << json_number(r.ns.p90) << ", \"mb_per_sec\": " << json_number(r.mb_per_sec())
+           << ", \"cycles\": " << json_number(p.cycles, p.valid)
+           << ", \"instructions\": " << json_number(p.instructions, p.valid)
+           << ", \"cache_misses\": " << json_number(p.cache_misses, p.valid)
+           << ", \"branch_misses\": " << json_number(p.branch_misses, p.valid) << "}"
+           << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n}\n";
+}
+
+inline bool write_json(const std::string &path, const std::vector<result> &results) {
+    std::ofstream out_file {path};
+    if (!out_file)
+        return false;
+    write_json(out_file, results);
+    return static_cast<bool>(out_file);
+}
+
+/* name -> median ns from a file written by write_json(); false if it can't be read */
+inline bool read_baseline(const std::string &path, std::map<std::string, double> &baseline) {
+    std::ifstream in_file {path};
+    if (!in_file)
+        return false;
+    std::stringstream text {};
+    text << in_file.rdbuf();
+    const std::string s = text.str();
+    const std::string name_key {"\"name\": \""}, median_key {"\"median_ns\": "};
+    for (std::size_t pos = s.find(name_key); pos != std::string::npos; pos = s.find(name_key, pos)) {
+        pos += name_key.size();
+        std::size_t end = s.find('"', pos);
+        std::size_t median = s.find(median_key, end);
+        if (end == std::string::npos || median == std::string::npos)
+            return false;
+        baseline[s.substr(pos, end - pos)] = std::strtod(s.c_str() + median + median_key.size(), nullptr);
+        pos = median;
+    }
+    return true;
+}
+
+struct comparison {
+    std::string name;
+    double baseline_ns;
+    double current_ns;
+    double change;                      // current / baseline - 1; positive = slower
+    bool regressed;
+};
+
+inline std::vector<comparison> compare(const std::vector<result> &results,
+                                       const std::map<std::string, double> &baseline, double threshold) {
+    std::vector<comparison> out {};
+    for (const result &r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0.0)
+            continue;
+        double change = r.ns.median / it->second - 1.0;
+        out.push_back({r.name, it->second, r.ns.median, change, change > threshold});
+    }
+    return out;
+}
+
+/* Command line driver; returns the process exit code */
+inline int run_main(int argc, char *argv[], const suite &s) {
+    options opt {};
+    std::string json_path {}, baseline_path {};
+    double threshold {0.10};
+    for (int i {1}; i < argc; ++i) {
+        std::string arg {argv[i]};
+        bool has_value = i + 1 < argc;
+        if (arg == "--filter" && has_value)
+            opt.filter = argv[++i];
+        else if (arg == "--repetitions" && has_value)
+            opt.repetitions = std::atoi(argv[++i]);
+        else if (arg == "--warmup" && has_value)
+            opt.warmup = std::atoi(argv[++i]);
+        else if (arg == "--min-time" && has_value)
+            opt.min_time = std::atof(argv[++i]);
+        else if (arg == "--json" && has_value)
+            json_path = argv[++i];
+        else if (arg == "--baseline" && has_value)
+            baseline_path = argv[++i];
+        else if (arg == "--threshold" && has_value)
+            threshold = std::atof(argv[++i]);
+        else if (arg == "--no-perf")
+            opt.perf = false;
+        else {
+            std::cerr << "usage: " << argv[0] << " [--filter s] [--repetitions n] [--warmup n] [--min-time sec]"
+                      << " [--no-perf] [--json out.json] [--baseline base.json [--threshold 0.10]]" << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<result> results = s.run(opt);
+    if (!json_path.empty() && !write_json(json_path, results)) {
+        std::cerr << "File open error: " << json_path << std::endl;
+        return 2;
+    }
+    if (baseline_path.empty())
+        return 0;
+
+    std::map<std::string, double> baseline {};
+    if (!read_baseline(baseline_path, baseline)) {
+        std::cerr << "File open error: " << baseline_path << std::endl;
+        return 2;
+    }
+    bool regressed {false};
+    std::cout << "\ncompared with " << baseline_path << " (threshold " << threshold * 100.0 << "%)" << std::endl;
+    for (const comparison &c : compare(results, baseline, threshold)) {
+        std::cout << std::left << std::setw(28) << c.name << std::right << std::showpos << std::fixed
+                  << std::setprecision(1) << std::setw(8) << c.change * 100.0 << "%" << std::noshowpos
+                  << (c.regressed ? "   REGRESSION" : "") << std::endl;
+        regressed = regressed || c.regressed;
+    }
+    return regressed ? 1 : 0;
+}
+
+}   // namespace pg::bench
+
+#endif  // PG_BENCH_H
@@ -0,0 +1,187 @@
+/**
+@file io_arrays_bench.cpp
+
+@brief
+    Benchmark suite for the stream read, copy, format and array patterns of io/ and
+    arrays_n_vectors/ (harness: bench.h)
+
+@par
+    Benchmarks (each pair: the pattern as the tutorial programs write it, then the pg version):
+        read/getline, read/line_reader -> count the lines of a 32 MiB text file
+        copy/rdbuf, copy/buffered, copy/kernel -> copy the same file
+        format/iomanip, format/format_writer -> 100k name/num/total lines with setw/setprecision
+        array/vector_loop, array/series_sum -> sum of 1M doubles
+        array/aos_scan, array/soa_scan -> sum of one field over 1M records
+    Regression check:
+        ./io_arrays_bench --json baseline.json                  (on the reference build)
+        ./io_arrays_bench --baseline baseline.json --threshold 0.10
+    The input file is created in $TMPDIR (or /tmp) and removed at exit.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "bench.h"
+#include "../arrays_n_vectors/series_kernels.h"
+#include "../arrays_n_vectors/soa_vector.h"
+#include "../io/file_copy.h"
+#include "../io/format_writer.h"
+#include "../io/line_reader.h"
+
+struct person {
+    std::string name;
+    std::int32_t num;
+    double total;
+};
+
+/* Temporary input, removed on exit */
+struct temp_file {
+    std::string path;
+    ~temp_file() {
+        if (!path.empty())
+            std::remove(path.c_str());
+    }
+};
+
+static bool make_input(temp_file &file, std::size_t bytes) {
+    const char *dir = std::getenv("TMPDIR");
+    std::string pattern = std::string {dir ? dir : "/tmp"} + "/pg_bench_XXXXXX";
+    int fd = ::mkstemp(&pattern[0]);
+    if (fd < 0)
+        return false;
+    ::close(fd);
+    file.path = pattern;
+    std::ofstream out_file {file.path, std::ios::binary};
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    std::size_t written {0};
+    for (std::size_t i {0}; written < bytes; ++i) {
+        std::string line = std::string {names[i % 4]} + " " + std::to_string(i % 1000) + " " +
+                           std::to_string(double(i % 4096) * 0.25) + "\n";
+        out_file << line;
+        written += line.size();
+    }
+    return static_cast<bool>(out_file);
+}
+
+int main(int argc, char *argv[]) {
+    temp_file input {};
+    const std::size_t file_bytes {32u << 20};
+    if (!make_input(input, file_bytes)) {
+        std::cerr << "File open error" << std::endl;
+        return 2;
+    }
+    temp_file output {input.path + ".copy"};
+
+    pg::bench::suite s {};
+
+    /* Stream read */
+    s.add("read/getline", file_bytes, [&] {
+        std::ifstream in_file {input.path};
+        std::string line {};
+        std::size_t lines {0};
+        while (std::getline(in_file, line))
+            ++lines;
+        pg::bench::do_not_optimize(lines);
+    });
+    s.add("read/line_reader", file_bytes, [&] {
+        pg::line_reader reader {input.path};
+        std::string_view line {};
+        std::size_t lines {0};
+        while (reader.next(line))
+            ++lines;
+        pg::bench::do_not_optimize(lines);
+    });
+
+    /* Copy */
+    s.add("copy/rdbuf", file_bytes, [&] {
+        std::ifstream in_file {input.path, std::ios::binary};
+        std::ofstream out_file {output.path, std::ios::binary};
+        out_file << in_file.rdbuf();
+    });
+    s.add("copy/buffered", file_bytes, [&] {
+        pg::bench::do_not_optimize(pg::copy_file(input.path, output.path, pg::copy_backend::buffered).ok);
+    });
+    s.add("copy/kernel", file_bytes, [&] {
+        pg::bench::do_not_optimize(pg::copy_file(input.path, output.path, pg::copy_backend::kernel).ok);
+    });
+
+    /* Format */
+    const std::size_t format_lines {100'000};
+    std::vector<person> people {};
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    for (std::size_t i {0}; i < format_lines; ++i)
+        people.push_back({names[i % 4], static_cast<std::int32_t>(i % 1000), double(i % 4096) * 0.25});
+    s.add("format/iomanip", format_lines * 30, [&] {
+        std::ostringstream out {};
+        for (const person &p : people)
+            out << std::setw(10) << std::left << p.name << std::setw(6) << std::right << p.num << std::setw(12)
+                << std::fixed << std::setprecision(2) << p.total << '\n';
+        pg::bench::do_not_optimize(out.tellp());
+    });
+    pg::format_writer writer {format_lines * 30};
+    s.add("format/format_writer", format_lines * 30, [&] {
+        constexpr auto name_spec = pg::format_spec {}.setw(10).left();
+        constexpr auto num_spec = pg::format_spec {}.setw(6);
+        constexpr auto total_spec = pg::format_spec {}.setw(12).fixed().setprecision(2);
+        writer.clear();
+        for (const person &p : people)
+            writer.write(p.name, name_spec).write(p.num, num_spec).write(p.total, total_spec).newline();
+        pg::bench::do_not_optimize(writer.size());
+    });
+
+    /* Arrays */
+    const std::size_t count {1'000'000};
+    std::vector<double> values(count);
+    std::vector<person> aos {};
+    pg::soa_vector<std::string, std::int32_t, double> soa {};
+    soa.reserve(count);
+    aos.reserve(count);
+    for (std::size_t i {0}; i < count; ++i) {
+        values[i] = double(i % 4096) * 0.25;
+        aos.push_back({names[i % 4], static_cast<std::int32_t>(i % 1000), values[i]});
+        soa.push_back(names[i % 4], static_cast<std::int32_t>(i % 1000), values[i]);
+    }
+    s.add("array/vector_loop", count * sizeof(double), [&] {
+        double sum {0.0};
+        for (double v : values)
+            sum += v;
+        pg::bench::do_not_optimize(sum);
+    });
+    s.add("array/series_sum", count * sizeof(double), [&] {
+        pg::bench::do_not_optimize(pg::series::sum(values.data(), values.size()));
+    });
+    s.add("array/aos_scan", count * sizeof(double), [&] {
+        double sum {0.0};
+        for (const person &p : aos)
+            sum += p.total;
+        pg::bench::do_not_optimize(sum);
+    });
+    s.add("array/soa_scan", count * sizeof(double), [&] {
+        double sum {0.0};
+        for (double t : soa.column<2>())
+            sum += t;
+        pg::bench::do_not_optimize(sum);
+    });
+
+    return pg::bench::run_main(argc, argv, s);
+}
@@ -0,0 +1,365 @@
+/**
+@file append_log.h
+
+@brief
+    Append-only log with group commit
+        Threads ===> shared batch ===> one write() + optional fdatasync() ===> log file
+
+@par
+    Why not std::ofstream {path, std::ios::app}:
+        * Each thread needs its own locking, and every flush is its own write() syscall.
+        * There is no control over durability: either nothing is synced or each caller
+          fsyncs on its own.
+    Group commit:
+        * append() adds the record to the current batch. The first waiting thread becomes the
+          leader: it takes the whole batch, does one write() (and one fdatasync() if the policy
+          asks for it), then wakes every thread whose record was in the batch.
+        * While the leader writes, new appends build up the next batch.
+    Sync policies (append_log_options::sync):
+        sync_policy::none -> append() returns once the batch is written (page cache only)
+        sync_policy::every_commit -> append() returns once the batch is on disk
+        sync_policy::interval -> a flusher thread syncs every sync_interval while there are
+                                 unsynced commits; call sync() to force it
+    Record framing:
+        uint32 length | uint32 crc32c(length, payload) | payload
+        On open, the file is scanned; a torn or corrupt tail (length past the end, bad CRC)
+        is truncated away and reported by truncated_bytes(). The CRC covers the length, so a
+        zero-filled tail (preallocation, size extended before a crash) doesn't read as records.
+    Usage:
+        pg::append_log log {"../app.log"};
+        if (!log)
+            std::cerr << "File open error" << std::endl;
+        log.append("user=larry action=login");
+
+        pg::read_append_log("../app.log", [](std::string_view record) { ... });
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_APPEND_LOG_H
+#define PG_APPEND_LOG_H
+
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pg {
+
+/* CRC-32C (Castagnoli); SSE4.2 crc32 instruction when the CPU has it */
+namespace detail {
+
+inline const std::array<std::uint32_t, 256> &crc32c_table() {
+    static const std::array<std::uint32_t, 256> table = [] {
+        std::array<std::uint32_t, 256> t {};
+        for (std::uint32_t i {0}; i < 256; ++i) {
+            std::uint32_t c {i};
+            for (int k {0}; k < 8; ++k)
+                c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+            t[i] = c;
+        }
+        return t;
+    }();
+    return table;
+}
+
+inline std::uint32_t crc32c_scalar(std::uint32_t crc, const char *p, std::size_t n) {
+    const auto &table = crc32c_table();
+    for (std::size_t i {0}; i < n; ++i)
+        crc = table[(crc ^ static_cast<unsigned char>(p[i])) & 0xFF] ^ (crc >> 8);
+    return crc;
+}
+
+#if defined(__x86_64__)
+__attribute__((target("sse4.2")))
+inline std::uint32_t crc32c_sse42(std::uint32_t crc, const char *p, std::size_t n) {
+    std::uint64_t c {crc};
+    for (; n >= 8; n -= 8, p += 8) {
+        std::uint64_t word;
+        std::memcpy(&word, p, 8);
+        c = __builtin_ia32_crc32di(c, word);
+    }
+    std::uint32_t c32 = static_cast<std::uint32_t>(c);
+    for (; n > 0; --n, ++p)
+        c32 = __builtin_ia32_crc32qi(c32, static_cast<unsigned char>(*p));
+    return c32;
+}
+#endif
+
+}   // namespace detail
+
+/* Continue a CRC-32C: crc32c(a + b) == crc32c(crc32c(a), b) */
+inline std::uint32_t crc32c(std::uint32_t crc, const char *p, std::size_t n) {
+#if defined(__x86_64__)
+    static const bool hw = __builtin_cpu_supports("sse4.2");
+    if (hw)
+        return ~detail::crc32c_sse42(~crc, p, n);
+#endif
+    return ~detail::crc32c_scalar(~crc, p, n);
+}
+
+inline std::uint32_t crc32c(const char *p, std::size_t n) { return crc32c(0, p, n); }
+
+constexpr std::size_t append_record_header {8};     // length + crc
+
+/* Record checksum: the length bytes then the payload */
+inline std::uint32_t append_record_crc(std::uint32_t length, const char *payload) {
+    char bytes[4];
+    std::memcpy(bytes, &length, 4);
+    return crc32c(crc32c(bytes, 4), payload, length);
+}
+
+/* Calls on_record for every intact record; returns the byte offset where intact data ends */
+template <typename OnRecord>
+std::size_t scan_append_log(const char *data, std::size_t size, OnRecord &&on_record) {
+    std::size_t pos {0};
+    while (size - pos >= append_record_header) {
+        std::uint32_t length {};
+        std::uint32_t crc {};
+        std::memcpy(&length, data + pos, 4);
+        std::memcpy(&crc, data + pos + 4, 4);
+        if (length > size - pos - append_record_header)
+            break;                              // torn: length runs past the end
+        const char *payload = data + pos + append_record_header;
+        if (append_record_crc(length, payload) != crc)
+            break;                              // torn or corrupt
+        on_record(std::string_view {payload, length});
+        pos += append_record_header + length;
+    }
+    return pos;
+}
+
+/* Read every intact record of a log file; false if the file can't be read */
+template <typename OnRecord>
+bool read_append_log(const std::string &path, OnRecord &&on_record) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return false;
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        return false;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return true;
+    }
+    void *p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+        return false;
+    scan_append_log(static_cast<const char *>(p), size, on_record);
+    ::munmap(p, size);
+    return true;
+}
+
+enum class sync_policy { none, every_commit, interval };
+
+struct append_log_options {
+    sync_policy sync {sync_policy::every_commit};
+    std::chrono::milliseconds sync_interval {100};  // for sync_policy::interval (flusher period)
+};
+
+class append_log {
+public:
+    explicit append_log(const std::string &path, append_log_options options = {})
+        : options_ {options} {
+        fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+        if (fd_ < 0)
+            return;
+        recover();
+        if (!failed_ && options_.sync == sync_policy::interval)
+            flusher_ = std::thread {[this] { flush_loop(); }};
+    }
+
+    append_log(const append_log &) = delete;
+    append_log &operator=(const append_log &) = delete;
+
+    ~append_log() {
+        if (flusher_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock {mutex_};
+                stopping_ = true;
+            }
+            flusher_cv_.notify_all();
+            flusher_.join();
+        }
+        if (fd_ >= 0) {
+            if (options_.sync != sync_policy::none)
+                ::fdatasync(fd_);
+            ::close(fd_);
+        }
+    }
+
+    explicit operator bool() const { return fd_ >= 0 && !failed_; }
+    std::size_t truncated_bytes() const { return truncated_; }     // torn tail removed on open
+
+    /* Append one record; returns when the record is written (and synced, per policy) */
+    bool append(std::string_view payload) {
+        std::unique_lock<std::mutex> lock {mutex_};
+        if (fd_ < 0 || failed_)
+            return false;
+        std::uint32_t length = static_cast<std::uint32_t>(payload.size());
+        std::uint32_t crc = append_record_crc(length, payload.data());
+        char header[append_record_header];
+        std::memcpy(header, &length, 4);
+        std::memcpy(header + 4, &crc, 4);
+        pending_.insert(pending_.end(), header, header + append_record_header);
+        pending_.insert(pending_.end(), payload.begin(), payload.end());
+        std::uint64_t my_seq = ++appended_;
+
+        while (committed_ < my_seq && !failed_) {
+            if (!leader_active_) {
+                commit_as_leader(lock);         // writes my batch (and maybe later ones)
+            } else {
+                committed_cv_.wait(lock);
+            }
+        }
+        return !failed_;
+    }
+
+    /* Force everything appended so far onto disk; appenders keep going during the flush */
+    bool sync() {
+        std::unique_lock<std::mutex> lock {mutex_};
+        if (fd_ < 0)
+            return false;
+        return sync_unlocked(lock);
+    }
+
+    std::uint64_t records() const { std::lock_guard<std::mutex> lock {mutex_}; return committed_; }
+    std::uint64_t commits() const { std::lock_guard<std::mutex> lock {mutex_}; return commits_; }
+    std::uint64_t syncs() const { std::lock_guard<std::mutex> lock {mutex_}; return syncs_; }
+
+private:
+    // Check the existing records and cut off a torn tail
+    void recover() {
+        struct stat st {};
+        if (::fstat(fd_, &st) != 0) {
+            failed_ = true;
+            return;
+        }
+        std::size_t size = static_cast<std::size_t>(st.st_size);
+        std::size_t good {0};
+        if (size > 0) {
+            void *p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (p == MAP_FAILED) {
+                failed_ = true;
+                return;
+            }
+            good = scan_append_log(static_cast<const char *>(p), size, [](std::string_view) {});
+            ::munmap(p, size);
+        }
+        if (good < size) {
+            truncated_ = size - good;
+            if (::ftruncate(fd_, static_cast<off_t>(good)) != 0 || ::fdatasync(fd_) != 0)
+                failed_ = true;
+        }
+    }
+
+    // Caller holds the lock; it is dropped during the write so others can queue the next batch
+    void commit_as_leader(std::unique_lock<std::mutex> &lock) {
+        leader_active_ = true;
+        writing_.swap(pending_);
+        pending_.clear();
+        std::uint64_t batch_end = appended_;
+        bool want_sync = options_.sync == sync_policy::every_commit;
+        lock.unlock();
+
+        bool ok {true};
+        const char *p = writing_.data();
+        std::size_t left = writing_.size();
+        while (left > 0) {
+            ssize_t n = ::write(fd_, p, left);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                ok = false;
+                break;
+            }
+            p += n;
+            left -= static_cast<std::size_t>(n);
+        }
+        if (ok && want_sync)
+            ok = ::fdatasync(fd_) == 0;
+
+        lock.lock();
+        ++commits_;
+        if (want_sync)
+            ++syncs_;
+        if (!ok)
+            failed_ = true;                     // the file may now hold a torn batch; reopen recovers
+        if (!want_sync)
+            dirty_ = true;
+        committed_ = batch_end;
+        leader_active_ = false;
+        committed_cv_.notify_all();
+    }
+
+    // Caller holds the lock; it is dropped during fdatasync, like the leader's write
+    bool sync_unlocked(std::unique_lock<std::mutex> &lock) {
+        dirty_ = false;
+        lock.unlock();
+        bool ok = ::fdatasync(fd_) == 0;
+        lock.lock();
+        ++syncs_;
+        if (!ok)
+            dirty_ = true;
+        return ok;
+    }
+
+    // sync_policy::interval: sync every sync_interval while commits are waiting for it
+    void flush_loop() {
+        std::unique_lock<std::mutex> lock {mutex_};
+        while (!stopping_) {
+            flusher_cv_.wait_for(lock, options_.sync_interval, [this] { return stopping_; });
+            if (!stopping_ && dirty_)
+                sync_unlocked(lock);
+        }
+    }
+
+    int fd_ {-1};
+    append_log_options options_;
+    std::size_t truncated_ {0};
+
+    mutable std::mutex mutex_ {};
+    std::condition_variable committed_cv_ {};
+    std::vector<char> pending_ {};              // batch being filled
+    std::vector<char> writing_ {};              // batch being written by the leader
+    std::uint64_t appended_ {0};                // records handed to append()
+    std::uint64_t committed_ {0};               // records written (per policy)
+    bool leader_active_ {false};
+    bool failed_ {false};
+    std::uint64_t commits_ {0};
+    std::uint64_t syncs_ {0};
+    bool dirty_ {false};                        // commits written but not synced
+    bool stopping_ {false};
+    std::condition_variable flusher_cv_ {};
+    std::thread flusher_ {};                    // sync_policy::interval only
+};
+
+}   // namespace pg
+
+#endif  // PG_APPEND_LOG_H
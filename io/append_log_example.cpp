@@ -0,0 +1,174 @@
+/**
+@file append_log_example.cpp
+
+@brief
+    Many threads appending to one log file: std::ofstream {path, std::ios::app} with a
+    lock and flush per record vs pg::append_log group commit (append_log.h).
+
+@par
+    Runs:
+        ofstream app + flush -> one write() per record, no durability
+        ofstream app + fsync -> one write() + fsync per record
+        append_log none / interval / every_commit -> batched write(), syncs per policy
+    Recovery check:
+        Garbage is appended to the log (a torn write); reopening must cut it off and keep
+        every record intact. The same goes for a zero-filled tail (preallocated space).
+    Idle check:
+        With sync_policy::interval, one append and no further traffic must still be synced.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "append_log.h"
+
+static std::string make_record(unsigned thread, unsigned i) {
+    return "thread=" + std::to_string(thread) + " seq=" + std::to_string(i) + " action=update total=255.67";
+}
+
+static void report(const std::string &label, std::size_t records, double seconds, const std::string &extra = "") {
+    std::cout << std::left << std::setw(26) << label << std::right << std::fixed << std::setprecision(0)
+              << std::setw(10) << records / seconds << " rec/s" << extra << std::endl;
+}
+
+template <typename Body>
+static double run_threads(unsigned threads, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers {};
+    for (unsigned t {0}; t < threads; ++t)
+        workers.emplace_back(body, t);
+    for (std::thread &w : workers)
+        w.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const unsigned threads {8};
+    const unsigned per_thread {2000};
+    const std::size_t records {std::size_t {threads} * per_thread};
+    const std::string path {"append_log_bench.log"};
+
+    /* ofstream in append mode, shared behind a mutex */
+    for (bool with_sync : {false, true}) {
+        std::remove(path.c_str());
+        std::ofstream out_file {path, std::ios::app};
+        if (!out_file) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        int sync_fd = ::open(path.c_str(), O_WRONLY | O_CLOEXEC);      // ofstream can't fsync
+        std::mutex out_mutex {};
+        unsigned n = with_sync ? per_thread / 10 : per_thread;          // fsync per record is slow
+        double s = run_threads(threads, [&](unsigned t) {
+            for (unsigned i {0}; i < n; ++i) {
+                std::string record = make_record(t, i);
+                std::lock_guard<std::mutex> lock {out_mutex};
+                out_file << record << '\n' << std::flush;
+                if (with_sync)
+                    ::fdatasync(sync_fd);
+            }
+        });
+        ::close(sync_fd);
+        report(with_sync ? "ofstream app + fsync" : "ofstream app + flush", std::size_t {threads} * n, s);
+    }
+
+    /* Group commit */
+    struct run { const char *label; pg::sync_policy sync; };
+    for (run r : {run {"append_log none", pg::sync_policy::none},
+                  run {"append_log interval", pg::sync_policy::interval},
+                  run {"append_log every_commit", pg::sync_policy::every_commit}}) {
+        std::remove(path.c_str());
+        pg::append_log_options options {};
+        options.sync = r.sync;
+        pg::append_log log {path, options};
+        if (!log) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        double s = run_threads(threads, [&](unsigned t) {
+            for (unsigned i {0}; i < per_thread; ++i)
+                log.append(make_record(t, i));
+        });
+        report(r.label, records, s, "   " + std::to_string(log.commits()) + " writes, "
+                                    + std::to_string(log.syncs()) + " syncs");
+    }
+
+    /* Torn tail recovery: the last every_commit log plus half a record of garbage */
+    {
+        std::ofstream torn {path, std::ios::app | std::ios::binary};
+        torn.write("\x40\x00\x00\x00\x12\x34\x56\x78partial", 15);
+    }
+    bool ok {false};
+    {
+        pg::append_log log {path};
+        log.append("after recovery");
+        std::size_t count {0};
+        bool last_ok {false};
+        pg::read_append_log(path, [&](std::string_view record) {
+            ++count;
+            last_ok = record == "after recovery";
+        });
+        ok = log && log.truncated_bytes() == 15 && count == records + 1 && last_ok;
+        std::cout << "recovered: truncated " << log.truncated_bytes() << " bytes, "
+                  << count << " records" << std::endl;
+    }
+
+    /* Zero-filled tail: must not read as empty records */
+    {
+        std::ofstream padded {path, std::ios::app | std::ios::binary};
+        const std::string zeros(4096, '\0');
+        padded.write(zeros.data(), static_cast<std::streamsize>(zeros.size()));
+    }
+    {
+        pg::append_log log {path};
+        log.append("after zero tail");
+        std::size_t count {0};
+        bool last_ok {false};
+        pg::read_append_log(path, [&](std::string_view record) {
+            ++count;
+            last_ok = record == "after zero tail";
+        });
+        ok = ok && log && log.truncated_bytes() == 4096 && count == records + 2 && last_ok;
+        std::cout << "zero tail: truncated " << log.truncated_bytes() << " bytes, "
+                  << count << " records" << std::endl;
+    }
+
+    /* Idle log with sync_policy::interval: the flusher syncs without further appends */
+    {
+        std::remove(path.c_str());
+        pg::append_log_options options {};
+        options.sync = pg::sync_policy::interval;
+        options.sync_interval = std::chrono::milliseconds {10};
+        pg::append_log log {path, options};
+        log.append("idle");
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds {5};
+        while (log.syncs() == 0 && std::chrono::steady_clock::now() < deadline)
+            std::this_thread::sleep_for(std::chrono::milliseconds {5});
+        ok = ok && log.syncs() >= 1;
+        std::cout << "idle interval log: " << log.syncs() << " syncs" << std::endl;
+    }
+    std::cout << "results match: " << std::boolalpha << ok << std::endl;
+    std::remove(path.c_str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,561 @@
+/**
+@file async_io.h
+
+@brief
+    Asynchronous file I/O with completion callbacks
+        open/read/write/close requests ===> io_uring (or worker threads) ===> callbacks on poll()/wait()
+
+@par
+    Why:
+        * std::ifstream open + read + close blocks on every call, so reading thousands of
+          small files is a chain of syscall round trips with idle time in between.
+        * Here every request is queued and many are in flight at once. Processing the files
+          that have already completed overlaps with the I/O of the rest.
+    Backends (io_backend):
+        io_uring -> requests go into the kernel's submission ring (raw syscalls through
+                    <linux/io_uring.h>, no liburing); one io_uring_enter() submits a batch
+                    and collects completions
+        thread_pool -> blocking open/pread/pwrite/close on worker threads, for kernels
+                       without io_uring (or where it is disabled)
+        automatic -> io_uring if it can be set up and supports every opcode used here,
+                     thread_pool otherwise
+    Completions:
+        * Each request takes an io_callback, called with the syscall result: bytes for
+          read/write, the new fd for open, 0 for close, or -errno on failure.
+        * Callbacks run only inside poll()/wait()/drain() on the calling thread, for both
+          backends, so they need no locking and may queue follow-up requests
+          (open -> read -> close chains).
+    Registered buffers:
+        * register_buffers() pins a set of buffers once. read_fixed()/write_fixed() then use
+          them by index, and the kernel skips mapping the pages on every request. On the
+          thread_pool backend they are plain reads/writes into the same buffers.
+    Usage:
+        pg::async_io io {};
+        io.open("../test.txt", O_RDONLY, [&](long fd) {
+            if (fd < 0)
+                return;
+            io.read(static_cast<int>(fd), buf, sizeof buf, 0, [&, fd](long n) {
+                process(buf, n);
+                io.close(static_cast<int>(fd), [](long) {});
+            });
+        });
+        io.drain();
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_ASYNC_IO_H
+#define PG_ASYNC_IO_H
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace pg {
+
+enum class io_backend { automatic, io_uring, thread_pool };
+
+inline const char *to_string(io_backend b) {
+    switch (b) {
+        case io_backend::automatic:     return "automatic";
+        case io_backend::io_uring:      return "io_uring";
+        case io_backend::thread_pool:   return "thread_pool";
+    }
+    return "?";
+}
+
+using io_callback = std::function<void(long result)>;
+
+namespace detail {
+
+enum class io_opcode { open, read, write, read_fixed, write_fixed, close };
+
+struct io_request {
+    io_opcode code {io_opcode::read};
+    int fd {-1};
+    void *buf {nullptr};
+    std::size_t len {0};
+    std::uint64_t offset {0};
+    int flags {0};
+    unsigned buf_index {0};
+    std::string path {};            // open: kept alive until the kernel has read it
+    io_callback callback {};
+};
+
+/* Minimal io_uring: one submission and one completion ring, user_data = request slot */
+class uring {
+public:
+    explicit uring(unsigned entries) {
+        io_uring_params params {};
+        fd_ = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (fd_ < 0)
+            return;
+        if (!map_rings(params) || !supports_opcodes()) {
+            release();
+            return;
+        }
+        sq_entries_ = params.sq_entries;
+    }
+
+    uring(const uring &) = delete;
+    uring &operator=(const uring &) = delete;
+    ~uring() { release(); }
+
+    bool ok() const { return fd_ >= 0; }
+    unsigned capacity() const { return sq_entries_; }
+
+    bool register_buffers(const std::vector<iovec> &buffers) {
+        return ::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_BUFFERS,
+                         buffers.data(), static_cast<unsigned>(buffers.size())) == 0;
+    }
+
+    // Caller keeps the number in flight at or below capacity(), so a free SQE always exists
+    void push(const io_request &r, std::uint64_t user_data) {
+        unsigned tail = *sq_tail_;
+        unsigned index = tail & *sq_mask_;
+        io_uring_sqe &sqe = sqes_[index];
+        std::memset(&sqe, 0, sizeof sqe);
+        sqe.fd = r.fd;
+        sqe.user_data = user_data;
+        switch (r.code) {
+            case io_opcode::open:
+                sqe.opcode = IORING_OP_OPENAT;
+                sqe.fd = AT_FDCWD;
+                sqe.addr = reinterpret_cast<std::uint64_t>(r.path.c_str());
+                sqe.open_flags = static_cast<std::uint32_t>(r.flags | O_CLOEXEC);
+                sqe.len = 0644;                 // mode, for O_CREAT
+                break;
+            case io_opcode::read:
+            case io_opcode::write:
+                sqe.opcode = r.code == io_opcode::read ? IORING_OP_READ : IORING_OP_WRITE;
+                sqe.addr = reinterpret_cast<std::uint64_t>(r.buf);
+                sqe.len = static_cast<std::uint32_t>(r.len);
+                sqe.off = r.offset;
+                break;
+            case io_opcode::read_fixed:
+            case io_opcode::write_fixed:
+                sqe.opcode = r.code == io_opcode::read_fixed ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+                sqe.addr = reinterpret_cast<std::uint64_t>(r.buf);
+                sqe.len = static_cast<std::uint32_t>(r.len);
+                sqe.off = r.offset;
+                sqe.buf_index = static_cast<std::uint16_t>(r.buf_index);
+                break;
+            case io_opcode::close:
+                sqe.opcode = IORING_OP_CLOSE;
+                break;
+        }
+        sq_array_[index] = index;
+        __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+        ++unsubmitted_;
+    }
+
+    // Submit queued SQEs and wait for at least min_complete completions
+    bool enter(unsigned min_complete) {
+        if (unsubmitted_ == 0 && min_complete == 0)
+            return true;
+        for (;;) {
+            long n = ::syscall(__NR_io_uring_enter, fd_, unsubmitted_, min_complete,
+                               min_complete > 0 ? IORING_ENTER_GETEVENTS : 0u, nullptr, 0);
+            if (n >= 0) {
+                unsubmitted_ -= static_cast<unsigned>(n);
+                return true;
+            }
+            if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                return false;
+            if (errno != EINTR)
+                std::this_thread::yield();
+        }
+    }
+
+    // Calls on_complete(user_data, result) for every completion in the ring
+    template <typename OnComplete>
+    std::size_t reap(OnComplete &&on_complete) {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        std::size_t count {0};
+        for (; head != tail; ++head, ++count) {
+            const io_uring_cqe &cqe = cqes_[head & *cq_mask_];
+            std::uint64_t user_data = cqe.user_data;
+            long result = cqe.res;
+            __atomic_store_n(cq_head_, head + 1, __ATOMIC_RELEASE);    // slot may be reused now
+            on_complete(user_data, result);
+        }
+        return count;
+    }
+
+private:
+    bool map_rings(const io_uring_params &p) {
+        sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(unsigned);
+        cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(io_uring_cqe);
+        bool single = (p.features & IORING_FEAT_SINGLE_MMAP) != 0;
+        if (single)
+            sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+        sq_ring_ = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                          fd_, IORING_OFF_SQ_RING);
+        if (sq_ring_ == MAP_FAILED)
+            return false;
+        if (single) {
+            cq_ring_ = sq_ring_;
+        } else {
+            cq_ring_ = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                              fd_, IORING_OFF_CQ_RING);
+            if (cq_ring_ == MAP_FAILED)
+                return false;
+        }
+        sqes_size_ = p.sq_entries * sizeof(io_uring_sqe);
+        void *sqes = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                            fd_, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+            return false;
+        sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+        char *sq = static_cast<char *>(sq_ring_);
+        sq_tail_ = reinterpret_cast<unsigned *>(sq + p.sq_off.tail);
+        sq_mask_ = reinterpret_cast<unsigned *>(sq + p.sq_off.ring_mask);
+        sq_array_ = reinterpret_cast<unsigned *>(sq + p.sq_off.array);
+        char *cq = static_cast<char *>(cq_ring_);
+        cq_head_ = reinterpret_cast<unsigned *>(cq + p.cq_off.head);
+        cq_tail_ = reinterpret_cast<unsigned *>(cq + p.cq_off.tail);
+        cq_mask_ = reinterpret_cast<unsigned *>(cq + p.cq_off.ring_mask);
+        cqes_ = reinterpret_cast<io_uring_cqe *>(cq + p.cq_off.cqes);
+        return true;
+    }
+
+    // OPENAT and CLOSE arrived in 5.6; older kernels get the thread_pool backend
+    bool supports_opcodes() {
+        constexpr unsigned ops {IORING_OP_LAST};
+        std::vector<char> storage(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op));
+        io_uring_probe *probe = reinterpret_cast<io_uring_probe *>(storage.data());
+        if (::syscall(__NR_io_uring_register, fd_, IORING_REGISTER_PROBE, probe, ops) != 0)
+            return false;
+        for (unsigned op : {IORING_OP_OPENAT, IORING_OP_READ, IORING_OP_WRITE, IORING_OP_READ_FIXED,
+                            IORING_OP_WRITE_FIXED, IORING_OP_CLOSE}) {
+            if (op > probe->last_op || !(probe->ops[op].flags & IO_URING_OP_SUPPORTED))
+                return false;
+        }
+        return true;
+    }
+
+    void release() {
+        if (sqes_ != nullptr)
+            ::munmap(sqes_, sqes_size_);
+        if (cq_ring_ != nullptr && cq_ring_ != MAP_FAILED && cq_ring_ != sq_ring_)
+            ::munmap(cq_ring_, cq_ring_size_);
+        if (sq_ring_ != nullptr && sq_ring_ != MAP_FAILED)
+            ::munmap(sq_ring_, sq_ring_size_);
+        sqes_ = nullptr;
+        sq_ring_ = cq_ring_ = nullptr;
+        if (fd_ >= 0)
+            ::close(fd_);
+        fd_ = -1;
+    }
+
+    int fd_ {-1};
+    unsigned sq_entries_ {0};
+    unsigned unsubmitted_ {0};
+    void *sq_ring_ {nullptr};
+    void *cq_ring_ {nullptr};
+    std::size_t sq_ring_size_ {0};
+    std::size_t cq_ring_size_ {0};
+    std::size_t sqes_size_ {0};
+    io_uring_sqe *sqes_ {nullptr};
+    unsigned *sq_tail_ {nullptr};
+    unsigned *sq_mask_ {nullptr};
+    unsigned *sq_array_ {nullptr};
+    unsigned *cq_head_ {nullptr};
+    unsigned *cq_tail_ {nullptr};
+    unsigned *cq_mask_ {nullptr};
+    io_uring_cqe *cqes_ {nullptr};
+};
+
+/* Fallback: blocking syscalls on worker threads, results queued back to the poller */
+class blocking_io_pool {
+public:
+    explicit blocking_io_pool(unsigned threads) {
+        for (unsigned i {0}; i < (threads == 0 ? 1 : threads); ++i)
+            workers_.emplace_back([this] { run(); });
+    }
+
+    blocking_io_pool(const blocking_io_pool &) = delete;
+    blocking_io_pool &operator=(const blocking_io_pool &) = delete;
+
+    ~blocking_io_pool() {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            stopping_ = true;
+        }
+        work_cv_.notify_all();
+        for (std::thread &w : workers_)
+            w.join();
+    }
+
+    // The request itself stays in the caller's slot table; workers only read it
+    void push(const io_request *r, std::uint64_t user_data) {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            work_.push_back({r, user_data});
+        }
+        work_cv_.notify_one();
+    }
+
+    template <typename OnComplete>
+    std::size_t reap(bool block, OnComplete &&on_complete) {
+        std::deque<std::pair<std::uint64_t, long>> done {};
+        {
+            std::unique_lock<std::mutex> lock {mutex_};
+            if (block)
+                done_cv_.wait(lock, [this] { return !done_.empty(); });
+            done.swap(done_);
+        }
+        for (const auto &d : done)
+            on_complete(d.first, d.second);
+        return done.size();
+    }
+
+private:
+    static long perform(const io_request &r) {
+        long n {0};
+        do {
+            switch (r.code) {
+                case io_opcode::open:
+                    n = ::open(r.path.c_str(), r.flags | O_CLOEXEC, 0644);
+                    break;
+                case io_opcode::read:
+                case io_opcode::read_fixed:
+                    n = ::pread(r.fd, r.buf, r.len, static_cast<off_t>(r.offset));
+                    break;
+                case io_opcode::write:
+                case io_opcode::write_fixed:
+                    n = ::pwrite(r.fd, r.buf, r.len, static_cast<off_t>(r.offset));
+                    break;
+                case io_opcode::close:
+                    return ::close(r.fd) == 0 ? 0 : -errno;
+            }
+        } while (n < 0 && errno == EINTR);
+        return n < 0 ? -errno : n;
+    }
+
+    void run() {
+        for (;;) {
+            std::pair<const io_request *, std::uint64_t> job {};
+            {
+                std::unique_lock<std::mutex> lock {mutex_};
+                work_cv_.wait(lock, [this] { return stopping_ || !work_.empty(); });
+                if (work_.empty())
+                    return;
+                job = work_.front();
+                work_.pop_front();
+            }
+            long result = perform(*job.first);
+            {
+                std::lock_guard<std::mutex> lock {mutex_};
+                done_.emplace_back(job.second, result);
+            }
+            done_cv_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> workers_ {};
+    std::mutex mutex_ {};
+    std::condition_variable work_cv_ {};
+    std::condition_variable done_cv_ {};
+    std::deque<std::pair<const io_request *, std::uint64_t>> work_ {};
+    std::deque<std::pair<std::uint64_t, long>> done_ {};
+    bool stopping_ {false};
+};
+
+}   // namespace detail
+
+class async_io {
+public:
+    explicit async_io(io_backend backend = io_backend::automatic, unsigned queue_depth = 256,
+                      unsigned threads = 4) {
+        if (backend != io_backend::thread_pool) {
+            ring_ = std::make_unique<detail::uring>(queue_depth);
+            if (ring_->ok()) {
+                backend_ = io_backend::io_uring;
+                depth_ = ring_->capacity();
+                return;
+            }
+            ring_.reset();
+            if (backend == io_backend::io_uring)
+                return;                         // asked for io_uring only: not usable
+        }
+        pool_ = std::make_unique<detail::blocking_io_pool>(threads);
+        backend_ = io_backend::thread_pool;
+        depth_ = queue_depth;
+    }
+
+    async_io(const async_io &) = delete;
+    async_io &operator=(const async_io &) = delete;
+
+    ~async_io() { drain(); }
+
+    explicit operator bool() const { return ring_ != nullptr || pool_ != nullptr; }
+    io_backend backend() const { return backend_; }
+    std::size_t in_flight() const { return in_flight_ + backlog_.size(); }
+
+    /* Pin buffers for read_fixed/write_fixed; call before queuing fixed requests */
+    bool register_buffers(const std::vector<iovec> &buffers) {
+        fixed_ = buffers;
+        return ring_ == nullptr || ring_->register_buffers(buffers);
+    }
+
+    void open(const std::string &path, int flags, io_callback callback) {
+        detail::io_request r {};
+        r.code = detail::io_opcode::open;
+        r.path = path;
+        r.flags = flags;
+        r.callback = std::move(callback);
+        queue(std::move(r));
+    }
+
+    void read(int fd, void *buf, std::size_t len, std::uint64_t offset, io_callback callback) {
+        queue(transfer(detail::io_opcode::read, fd, buf, len, offset, std::move(callback)));
+    }
+
+    void write(int fd, const void *buf, std::size_t len, std::uint64_t offset, io_callback callback) {
+        queue(transfer(detail::io_opcode::write, fd, const_cast<void *>(buf), len, offset, std::move(callback)));
+    }
+
+    /* Read into registered buffer `index`, starting at its beginning */
+    void read_fixed(int fd, unsigned index, std::size_t len, std::uint64_t offset, io_callback callback) {
+        detail::io_request r = transfer(detail::io_opcode::read_fixed, fd, fixed_[index].iov_base,
+                                        std::min(len, fixed_[index].iov_len), offset, std::move(callback));
+        r.buf_index = index;
+        queue(std::move(r));
+    }
+
+    void write_fixed(int fd, unsigned index, std::size_t len, std::uint64_t offset, io_callback callback) {
+        detail::io_request r = transfer(detail::io_opcode::write_fixed, fd, fixed_[index].iov_base,
+                                        std::min(len, fixed_[index].iov_len), offset, std::move(callback));
+        r.buf_index = index;
+        queue(std::move(r));
+    }
+
+    void close(int fd, io_callback callback) {
+        detail::io_request r {};
+        r.code = detail::io_opcode::close;
+        r.fd = fd;
+        r.callback = std::move(callback);
+        queue(std::move(r));
+    }
+
+    /* Submit queued requests and run the callbacks of finished ones; never blocks */
+    std::size_t poll() { return process(false); }
+
+    /* Like poll(), but blocks until at least one request has finished (0 if none in flight) */
+    std::size_t wait() { return in_flight() == 0 ? 0 : process(true); }
+
+    /* Run until every request, including ones queued by callbacks, has finished */
+    void drain() {
+        while (in_flight() > 0) {
+            if (process(true) == 0)
+                break;                          // ring error: nothing more will complete
+        }
+    }
+
+private:
+    static detail::io_request transfer(detail::io_opcode code, int fd, void *buf, std::size_t len,
+                                       std::uint64_t offset, io_callback callback) {
+        detail::io_request r {};
+        r.code = code;
+        r.fd = fd;
+        r.buf = buf;
+        r.len = len;
+        r.offset = offset;
+        r.callback = std::move(callback);
+        return r;
+    }
+
+    void queue(detail::io_request r) {
+        if (in_flight_ >= depth_) {
+            backlog_.push_back(std::move(r));   // waits for a completion to free a slot
+            return;
+        }
+        start(std::move(r));
+    }
+
+    void start(detail::io_request r) {
+        std::size_t slot {};
+        if (free_slots_.empty()) {
+            slot = slots_.size();
+            slots_.push_back(std::make_unique<detail::io_request>());
+        } else {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+        *slots_[slot] = std::move(r);
+        ++in_flight_;
+        if (ring_ != nullptr)
+            ring_->push(*slots_[slot], slot);
+        else
+            pool_->push(slots_[slot].get(), slot);
+    }
+
+    void complete(std::uint64_t slot, long result) {
+        io_callback callback = std::move(slots_[slot]->callback);
+        slots_[slot]->path.clear();
+        free_slots_.push_back(static_cast<std::size_t>(slot));
+        --in_flight_;
+        if (!backlog_.empty()) {
+            start(std::move(backlog_.front()));
+            backlog_.pop_front();
+        }
+        if (callback)
+            callback(result);
+    }
+
+    std::size_t process(bool block) {
+        auto on_complete = [this](std::uint64_t slot, long result) { complete(slot, result); };
+        if (ring_ != nullptr) {
+            if (!ring_->enter(block && in_flight_ > 0 ? 1 : 0))
+                return 0;
+            std::size_t n = ring_->reap(on_complete);
+            ring_->enter(0);                    // push out requests queued by the callbacks
+            return n;
+        }
+        return pool_->reap(block && in_flight_ > 0, on_complete);
+    }
+
+    io_backend backend_ {io_backend::automatic};
+    std::unique_ptr<detail::uring> ring_ {};
+    std::unique_ptr<detail::blocking_io_pool> pool_ {};
+    std::size_t depth_ {0};
+    std::size_t in_flight_ {0};
+    std::vector<std::unique_ptr<detail::io_request>> slots_ {};
+    std::vector<std::size_t> free_slots_ {};
+    std::deque<detail::io_request> backlog_ {};
+    std::vector<iovec> fixed_ {};
+};
+
+}   // namespace pg
+
+#endif  // PG_ASYNC_IO_H
@@ -0,0 +1,174 @@
+/**
+@file async_io_example.cpp
+
+@brief
+    Reading thousands of small files: sequential std::ifstream (file_input_output.cpp style)
+    vs pg::async_io (async_io.h) on the io_uring and thread_pool backends.
+
+@par
+    Usage:
+        async_io_example            -> 4000 files of 1..16 KB in async_io_files/
+        async_io_example <count>    -> <count> files
+    Every run computes the same checksum over all file contents (exit code 1 if any differs).
+    Before each run the files are dropped from the page cache with posix_fadvise(DONTNEED),
+    so the numbers include real device reads where the filesystem allows it.
+    The async runs keep one registered buffer per file in flight:
+        open -> read_fixed -> (process) -> close, chained from the callbacks.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "async_io.h"
+
+static std::string file_name(std::size_t i) {
+    return "async_io_files/f" + std::to_string(i) + ".txt";
+}
+
+static bool make_files(std::size_t count) {
+    ::mkdir("async_io_files", 0755);
+    std::string content {};
+    for (std::size_t i {0}; i < count; ++i) {
+        std::size_t size = 1024 + (i * 7919) % (15 * 1024);
+        content.assign(size, 'a' + static_cast<char>(i % 26));
+        std::ofstream out_file {file_name(i), std::ios::binary};
+        out_file << content;
+        if (!out_file)
+            return false;
+    }
+    return true;
+}
+
+static void drop_cache(std::size_t count) {
+    for (std::size_t i {0}; i < count; ++i) {
+        int fd = ::open(file_name(i).c_str(), O_RDONLY);
+        if (fd >= 0) {
+            ::fdatasync(fd);
+            ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            ::close(fd);
+        }
+    }
+}
+
+static std::uint64_t checksum(const char *data, std::size_t size) {
+    std::uint64_t sum {size};
+    for (std::size_t i {0}; i < size; ++i)
+        sum = sum * 31 + static_cast<unsigned char>(data[i]);
+    return sum;
+}
+
+static void report(const std::string &label, std::size_t count, double seconds) {
+    std::cout << std::left << std::setw(22) << label << std::right << std::fixed << std::setprecision(3)
+              << std::setw(8) << seconds << " s  " << std::setprecision(0) << std::setw(10)
+              << count / seconds << " files/s" << std::endl;
+}
+
+/* Sequential: open, read, close one file after another */
+static std::uint64_t read_sequential(std::size_t count) {
+    std::uint64_t total {0};
+    std::string content {};
+    for (std::size_t i {0}; i < count; ++i) {
+        std::ifstream in_file {file_name(i), std::ios::binary};
+        if (!in_file) {
+            std::cerr << "File open error" << std::endl;
+            continue;
+        }
+        content.assign(std::istreambuf_iterator<char> {in_file}, std::istreambuf_iterator<char> {});
+        total += checksum(content.data(), content.size());
+    }
+    return total;
+}
+
+/* Async: up to `slots` files in flight, each with its own registered buffer */
+static std::uint64_t read_async(pg::async_io &io, std::size_t count, std::size_t slots) {
+    const std::size_t buffer_size {16 * 1024};
+    std::vector<char> storage(slots * buffer_size);
+    std::vector<iovec> buffers(slots);
+    for (std::size_t s {0}; s < slots; ++s)
+        buffers[s] = iovec {storage.data() + s * buffer_size, buffer_size};
+    if (!io.register_buffers(buffers))
+        std::cerr << "register_buffers failed, using plain reads" << std::endl;
+
+    std::uint64_t total {0};
+    std::size_t next {0};
+    std::function<void(unsigned)> start_next = [&](unsigned slot) {
+        if (next == count)
+            return;
+        std::size_t i = next++;
+        io.open(file_name(i), O_RDONLY, [&, slot](long fd) {
+            if (fd < 0) {
+                std::cerr << "File open error" << std::endl;
+                start_next(slot);
+                return;
+            }
+            io.read_fixed(static_cast<int>(fd), slot, buffer_size, 0, [&, slot, fd](long n) {
+                if (n > 0)
+                    total += checksum(static_cast<const char *>(buffers[slot].iov_base), static_cast<std::size_t>(n));
+                io.close(static_cast<int>(fd), nullptr);
+                start_next(slot);               // processing overlaps the other files' I/O
+            });
+        });
+    };
+    for (unsigned s {0}; s < slots; ++s)
+        start_next(s);
+    io.drain();
+    return total;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t count = argc > 1 ? std::stoul(argv[1]) : 4000;
+    std::cout << "Generating " << count << " files ..." << std::endl;
+    if (!make_files(count)) {
+        std::cerr << "File create error" << std::endl;
+        return 1;
+    }
+
+    drop_cache(count);
+    auto start = std::chrono::steady_clock::now();
+    std::uint64_t expected = read_sequential(count);
+    report("sequential ifstream", count, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+
+    bool all_ok {true};
+    for (pg::io_backend b : {pg::io_backend::io_uring, pg::io_backend::thread_pool}) {
+        pg::async_io io {b, 64};
+        if (!io) {
+            std::cout << std::left << std::setw(22) << pg::to_string(b) << " not available" << std::endl;
+            continue;
+        }
+        drop_cache(count);
+        start = std::chrono::steady_clock::now();
+        std::uint64_t sum = read_async(io, count, 64);
+        report(std::string {"async_io "} + pg::to_string(io.backend()), count,
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        all_ok = all_ok && sum == expected;
+    }
+
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    for (std::size_t i {0}; i < count; ++i)
+        std::remove(file_name(i).c_str());
+    ::rmdir("async_io_files");
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,427 @@
+/**
+@file async_logger.h
+
+@brief
+    Asynchronous batched logging
+        Thread ===> its own lock-free ring ===> flusher thread ===> writev() batches ===> fd
+
+@par
+    Why not std::clog << ... << std::endl:
+        * Every call formats, locks the stream and (with std::endl) does a write() syscall
+          on the caller's thread.
+        * async_logger copies the message into a per-thread ring (no lock, no syscall) and
+          a background thread writes many records per writev().
+    Flush policies (logger_options):
+        batch_bytes -> flush as soon as this many bytes are waiting (size)
+        flush_interval -> flush at least this often (time)
+        flush_severity -> a record at or above this severity wakes the flusher at once (severity)
+    Overflow (ring full):
+        overflow_policy::block -> the caller waits for the flusher (no loss)
+        overflow_policy::drop -> the record is dropped and counted in dropped()
+    Synchronous mode ("cerr-compatible"):
+        * logger_mode::synchronous writes each record on the caller's thread, like std::cerr.
+        * set_synchronous(true) switches at run time, e.g. before shutdown or from a
+          std::set_terminate handler; pending records are written first so the order is kept.
+        * severity::fatal is always written synchronously after draining the rings.
+        * Neither is async-signal-safe (both take a mutex): don't call them from a signal
+          handler.
+    Threads:
+        Each thread gets its ring on its first log() call. When the thread exits, its ring
+        is marked retired; the flusher writes what is left in it and frees it, so thread
+        churn doesn't grow memory or the flusher's scan.
+    Limits:
+        Messages longer than max_message are truncated. Record order is kept per thread,
+        not across threads.
+    Usage:
+        pg::async_logger log {STDERR_FILENO};
+        log.log(pg::severity::info, "server started");
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_ASYNC_LOGGER_H
+#define PG_ASYNC_LOGGER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace pg {
+
+enum class severity : std::uint8_t { debug, info, warning, error, fatal };
+
+inline const char *to_string(severity s) {
+    switch (s) {
+    case severity::debug: return "DEBUG";
+    case severity::info: return "INFO";
+    case severity::warning: return "WARN";
+    case severity::error: return "ERROR";
+    case severity::fatal: return "FATAL";
+    }
+    return "?";
+}
+
+enum class logger_mode { asynchronous, synchronous };
+enum class overflow_policy { block, drop };
+
+struct logger_options {
+    logger_mode mode {logger_mode::asynchronous};
+    overflow_policy overflow {overflow_policy::block};
+    std::size_t ring_capacity {4096};                       // records per thread, power of two
+    std::size_t batch_bytes {64 * 1024};
+    std::chrono::milliseconds flush_interval {50};
+    severity flush_severity {severity::error};
+    severity min_severity {severity::debug};                // records below this are ignored
+};
+
+class async_logger {
+public:
+    static constexpr std::size_t max_message {200};
+
+    explicit async_logger(int fd, logger_options options = {})
+        : fd_ {fd}, options_ {options}, id_ {next_id()} {
+        std::size_t cap {1};
+        while (cap < options_.ring_capacity)
+            cap <<= 1;
+        options_.ring_capacity = cap;
+        synchronous_.store(options_.mode == logger_mode::synchronous);
+        flusher_ = std::thread {[this] { run(); }};
+    }
+
+    async_logger(const async_logger &) = delete;
+    async_logger &operator=(const async_logger &) = delete;
+
+    ~async_logger() {
+        {
+            std::lock_guard<std::mutex> lock {wake_mutex_};
+            stopping_ = true;
+        }
+        wake_.notify_one();
+        flusher_.join();
+    }
+
+    void log(severity sev, std::string_view message) {
+        if (sev < options_.min_severity)
+            return;
+        if (sev == severity::fatal || synchronous_.load(std::memory_order_relaxed)) {
+            write_now(sev, message);
+            return;
+        }
+        ring &r = local_ring();
+        record *slot = r.try_claim();
+        while (slot == nullptr) {
+            if (options_.overflow == overflow_policy::drop) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            request_flush();
+            std::this_thread::yield();
+            slot = r.try_claim();
+        }
+        slot->time_ns = now_ns();
+        slot->sev = sev;
+        slot->size = static_cast<std::uint16_t>(message.size() < max_message ? message.size() : max_message);
+        std::memcpy(slot->text, message.data(), slot->size);
+        std::size_t bytes = slot->size + 32u;
+        std::size_t waiting = pending_bytes_.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        r.publish();
+
+        if (sev >= options_.flush_severity || waiting >= options_.batch_bytes)
+            request_flush();
+    }
+
+    /* Block until everything logged so far has been written */
+    void flush() {
+        std::unique_lock<std::mutex> lock {wake_mutex_};
+        std::uint64_t target = flush_requests_ + 1;
+        flush_requests_ = target;
+        wake_.notify_one();
+        flushed_.wait(lock, [&] { return flushes_done_ >= target || stopping_; });
+    }
+
+    /* Switch to writing on the caller's thread (e.g. before shutdown; not from a signal handler) */
+    void set_synchronous(bool on) {
+        if (on) {
+            std::lock_guard<std::mutex> lock {write_mutex_};
+            drain_all();
+        }
+        synchronous_.store(on);
+    }
+
+    std::uint64_t dropped() const { return dropped_.load(); }
+    std::uint64_t written() const { return written_.load(); }
+    std::uint64_t batches() const { return batches_.load(); }      // writev() calls
+
+    std::size_t rings() const {                 // per-thread rings not yet reclaimed
+        std::lock_guard<std::mutex> lock {rings_mutex_};
+        return rings_.size();
+    }
+
+private:
+    struct record {
+        std::uint64_t time_ns;
+        severity sev;
+        std::uint16_t size;
+        char text[max_message];
+    };
+
+    /* Single-producer (the owning thread) / single-consumer (the flusher) ring */
+    class ring {
+    public:
+        explicit ring(std::size_t capacity) : slots_(capacity), mask_ {capacity - 1} {}
+
+        record *try_claim() {
+            std::size_t tail = tail_.load(std::memory_order_relaxed);
+            if (tail - head_cache_ == slots_.size()) {
+                head_cache_ = head_.load(std::memory_order_acquire);
+                if (tail - head_cache_ == slots_.size())
+                    return nullptr;
+            }
+            return &slots_[tail & mask_];
+        }
+        void publish() { tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+        // consumer side
+        std::size_t available(std::size_t &head) const {
+            head = head_.load(std::memory_order_relaxed);
+            return tail_.load(std::memory_order_acquire) - head;
+        }
+        const record &at(std::size_t index) const { return slots_[index & mask_]; }
+        void release(std::size_t count) {
+            head_.store(head_.load(std::memory_order_relaxed) + count, std::memory_order_release);
+        }
+
+        // Set by the owning thread on exit; every record it published is visible after this
+        void retire() { retired_.store(true, std::memory_order_release); }
+        bool retired() const { return retired_.load(std::memory_order_acquire); }
+
+    private:
+        std::vector<record> slots_;
+        std::size_t mask_;
+        alignas(64) std::atomic<std::size_t> head_ {0};
+        alignas(64) std::atomic<std::size_t> tail_ {0};
+        std::size_t head_cache_ {0};    // producer's last view of head_
+        std::atomic<bool> retired_ {false};
+    };
+
+    /* The calling thread's rings, one per logger; retired when the thread exits */
+    struct thread_rings {
+        std::vector<std::pair<std::uint64_t, std::shared_ptr<ring>>> entries {};
+
+        ~thread_rings() {
+            for (auto &entry : entries)
+                entry.second->retire();
+        }
+    };
+
+    static std::uint64_t next_id() {
+        static std::atomic<std::uint64_t> id {1};
+        return id.fetch_add(1);
+    }
+
+    static std::uint64_t now_ns() {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    // One ring per (thread, logger); keyed by id so a new logger at an old address isn't confused.
+    // Shared with the logger, so whichever of the thread and the logger ends last frees it.
+    ring &local_ring() {
+        thread_local thread_rings rings {};
+        for (auto &entry : rings.entries)
+            if (entry.first == id_)
+                return *entry.second;
+        rings.entries.erase(std::remove_if(rings.entries.begin(), rings.entries.end(),
+                                           [](const auto &entry) { return entry.second.use_count() == 1; }),
+                            rings.entries.end());           // loggers that are gone
+        auto shared = std::make_shared<ring>(options_.ring_capacity);
+        {
+            std::lock_guard<std::mutex> lock {rings_mutex_};
+            rings_.push_back(shared);
+        }
+        rings.entries.emplace_back(id_, shared);
+        return *shared;
+    }
+
+    void request_flush() {
+        if (!wake_pending_.exchange(true, std::memory_order_acq_rel))
+            wake_.notify_one();
+    }
+
+    // "2026-10-16T12:00:00.123456Z INFO "
+    static std::size_t format_prefix(char *out, std::uint64_t time_ns, severity sev) {
+        std::time_t secs = static_cast<std::time_t>(time_ns / 1000000000u);
+        std::tm tm {};
+        ::gmtime_r(&secs, &tm);
+        int n = std::snprintf(out, 48, "%04d-%02d-%02dT%02d:%02d:%02d.%06uZ %s ",
+                              tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min,
+                              tm.tm_sec, static_cast<unsigned>(time_ns % 1000000000u / 1000u), to_string(sev));
+        return n > 0 ? static_cast<std::size_t>(n) : 0;
+    }
+
+    static void write_fully(int fd, iovec *iov, int count) {
+        while (count > 0) {
+            ssize_t n = ::writev(fd, iov, count);
+            if (n < 0) {
+                if (errno == EINTR)
+                    continue;
+                return;                         // nowhere to report a failing log fd
+            }
+            std::size_t left = static_cast<std::size_t>(n);
+            while (count > 0 && left >= iov->iov_len) {
+                left -= iov->iov_len;
+                ++iov;
+                --count;
+            }
+            if (count > 0) {
+                iov->iov_base = static_cast<char *>(iov->iov_base) + left;
+                iov->iov_len -= left;
+            }
+        }
+    }
+
+    void write_now(severity sev, std::string_view message) {
+        std::lock_guard<std::mutex> lock {write_mutex_};
+        drain_all();                            // keep earlier records first
+        char prefix[48];
+        std::size_t size = message.size() < max_message ? message.size() : max_message;
+        iovec iov[3] {{prefix, format_prefix(prefix, now_ns(), sev)},
+                      {const_cast<char *>(message.data()), size},
+                      {const_cast<char *>("\n"), 1}};
+        write_fully(fd_, iov, 3);
+        written_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Write every published record; caller holds write_mutex_
+    void drain_all() {
+        std::vector<iovec> &iov = iov_;
+        std::vector<char> &prefixes = prefixes_;
+
+        std::vector<ring *> &snapshot = snapshot_;
+        snapshot.clear();
+        {
+            std::lock_guard<std::mutex> lock {rings_mutex_};
+            for (auto &r : rings_)
+                snapshot.push_back(r.get());
+        }
+        bool reclaim {false};
+        for (ring *r : snapshot) {
+            bool retired = r->retired();        // before draining: nothing is published after it
+            reclaim = reclaim || retired;
+            std::size_t head {0};
+            std::size_t count {0};
+            while ((count = r->available(head)) > 0) {
+                if (count > batch_records)
+                    count = batch_records;
+                std::size_t bytes {0};
+                for (std::size_t i {0}; i < count; ++i) {
+                    const record &rec = r->at(head + i);
+                    char *prefix = &prefixes[i * 48];
+                    iov[i * 3] = {prefix, format_prefix(prefix, rec.time_ns, rec.sev)};
+                    iov[i * 3 + 1] = {const_cast<char *>(rec.text), rec.size};
+                    iov[i * 3 + 2] = {const_cast<char *>("\n"), 1};
+                    bytes += rec.size + 32;
+                }
+                write_fully(fd_, iov.data(), static_cast<int>(count * 3));
+                r->release(count);
+                pending_bytes_.fetch_sub(bytes, std::memory_order_relaxed);
+                written_.fetch_add(count, std::memory_order_relaxed);
+                batches_.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        if (reclaim) {                          // retired rings seen above are drained: free them
+            std::lock_guard<std::mutex> lock {rings_mutex_};
+            for (ring *r : snapshot) {
+                if (!r->retired())
+                    continue;
+                std::size_t head {0};
+                if (r->available(head) != 0)
+                    continue;
+                rings_.erase(std::find_if(rings_.begin(), rings_.end(),
+                                          [r](const std::shared_ptr<ring> &owned) { return owned.get() == r; }));
+            }
+        }
+    }
+
+    void run() {
+        std::unique_lock<std::mutex> lock {wake_mutex_};
+        for (;;) {
+            wake_.wait_for(lock, options_.flush_interval, [this] {
+                return stopping_ || flush_requests_ > flushes_done_
+                    || wake_pending_.load(std::memory_order_acquire);
+            });
+            wake_pending_.store(false, std::memory_order_release);
+            bool stop = stopping_;
+            std::uint64_t requested = flush_requests_;
+            lock.unlock();
+            {
+                std::lock_guard<std::mutex> write_lock {write_mutex_};
+                drain_all();
+            }
+            lock.lock();
+            flushes_done_ = requested;
+            flushed_.notify_all();
+            if (stop)
+                return;
+        }
+    }
+
+    int fd_;
+    logger_options options_;
+    std::uint64_t id_;
+    std::atomic<bool> synchronous_ {false};
+
+    mutable std::mutex rings_mutex_ {};
+    std::vector<std::shared_ptr<ring>> rings_ {};
+
+    static constexpr std::size_t batch_records {IOV_MAX / 3};
+
+    std::mutex write_mutex_ {};                 // one writer at a time: flusher or sync path
+    std::vector<iovec> iov_ = std::vector<iovec>(batch_records * 3);       // guarded by write_mutex_
+    std::vector<char> prefixes_ = std::vector<char>(batch_records * 48);
+    std::vector<ring *> snapshot_ {};
+    std::mutex wake_mutex_ {};
+    std::condition_variable wake_ {};
+    std::condition_variable flushed_ {};
+    std::atomic<bool> wake_pending_ {false};
+    bool stopping_ {false};
+    std::uint64_t flush_requests_ {0};
+    std::uint64_t flushes_done_ {0};
+
+    std::atomic<std::size_t> pending_bytes_ {0};
+    std::atomic<std::uint64_t> dropped_ {0};
+    std::atomic<std::uint64_t> written_ {0};
+    std::atomic<std::uint64_t> batches_ {0};
+
+    std::thread flusher_ {};
+};
+
+}   // namespace pg
+
+#endif  // PG_ASYNC_LOGGER_H
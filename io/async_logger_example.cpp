@@ -0,0 +1,148 @@
+/**
+@file async_logger_example.cpp
+
+@brief
+    Logging with async_logger.h, and a multithreaded benchmark of the log-call latency
+    (p50/p99) against writing directly to std::clog.
+
+@par
+    Usage:
+        async_logger_example            -> demo to stderr, then the benchmark (stderr -> /dev/null)
+        async_logger_example <threads>  -> benchmark with that many threads (default 4)
+    The latency measured is the time spent inside the call on the logging thread;
+    with async_logger the write() itself happens later on the flusher thread.
+    Thread churn check: rings of threads that have exited are reclaimed by the flusher.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "async_logger.h"
+
+struct latency {
+    double p50_ns;
+    double p99_ns;
+    double max_ns;
+};
+
+static latency summarize(std::vector<double> &samples) {
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) { return samples[static_cast<std::size_t>(q * (samples.size() - 1))]; };
+    return {at(0.50), at(0.99), samples.back()};
+}
+
+/* Run `call(i)` `per_thread` times on each thread and collect every call's latency */
+template <typename F>
+static latency measure(int threads, int per_thread, F call) {
+    std::vector<std::vector<double>> per(threads);
+    std::vector<std::thread> pool {};
+    for (int t {0}; t < threads; ++t) {
+        pool.emplace_back([&, t] {
+            per[t].reserve(per_thread);
+            for (int i {0}; i < per_thread; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                call(t, i);
+                auto stop = std::chrono::steady_clock::now();
+                per[t].push_back(std::chrono::duration<double, std::nano>(stop - start).count());
+            }
+        });
+    }
+    for (std::thread &th : pool)
+        th.join();
+    std::vector<double> all {};
+    for (auto &v : per)
+        all.insert(all.end(), v.begin(), v.end());
+    return summarize(all);
+}
+
+static void report(const char *label, const latency &l) {
+    std::cout << std::left << std::setw(16) << label << std::right << std::fixed << std::setprecision(0)
+              << "p50 " << std::setw(7) << l.p50_ns << " ns   p99 " << std::setw(8) << l.p99_ns
+              << " ns   max " << std::setw(10) << l.max_ns << " ns" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    int threads {argc > 1 ? std::atoi(argv[1]) : 4};
+    if (threads < 1)
+        threads = 1;
+
+    /* Logging to stderr */
+    {
+        pg::async_logger log {STDERR_FILENO};
+        log.log(pg::severity::info, "server started");
+        log.log(pg::severity::debug, "batched with the next records");
+        log.log(pg::severity::error, "errors wake the flusher at once");
+        log.flush();                            // wait until written
+        log.set_synchronous(true);              // e.g. before shutdown
+        log.log(pg::severity::warning, "written on this thread, like std::cerr");
+    }
+
+    /* Benchmark: stderr goes to /dev/null so only the logging cost is measured */
+    const int per_thread {200'000};
+    int saved_stderr = ::dup(STDERR_FILENO);
+    int null_fd = ::open("/dev/null", O_WRONLY);
+    ::dup2(null_fd, STDERR_FILENO);
+
+    std::string message(80, 'x');
+    latency by_clog = measure(threads, per_thread, [&](int t, int i) {
+        std::clog << "INFO worker " << t << " request " << i << ' ' << message << std::endl;
+    });
+
+    latency by_logger {};
+    std::uint64_t written {0}, batches {0}, dropped {0};
+    {
+        pg::async_logger log {STDERR_FILENO};
+        by_logger = measure(threads, per_thread, [&](int, int) {
+            log.log(pg::severity::info, message);
+        });
+        log.flush();
+        written = log.written();
+        batches = log.batches();
+        dropped = log.dropped();
+    }
+
+    /* Thread churn: 500 short-lived threads, one record each; their rings must be reclaimed */
+    std::uint64_t churn_written {0};
+    std::size_t churn_rings {0};
+    {
+        pg::async_logger log {STDERR_FILENO};
+        for (int i {0}; i < 500; ++i)
+            std::thread {[&] { log.log(pg::severity::info, message); }}.join();
+        log.flush();
+        churn_written = log.written();
+        churn_rings = log.rings();
+    }
+    bool churn_ok = churn_written == 500 && churn_rings == 0;
+
+    ::dup2(saved_stderr, STDERR_FILENO);
+    ::close(saved_stderr);
+    ::close(null_fd);
+
+    std::cout << threads << " threads x " << per_thread << " records" << std::endl;
+    report("std::clog", by_clog);
+    report("async_logger", by_logger);
+    std::cout << written << " records in " << batches << " writev() calls, "
+              << dropped << " dropped" << std::endl;
+    std::cout << "thread churn: " << churn_written << " records, " << churn_rings << " rings left" << std::endl;
+    return written == static_cast<std::uint64_t>(threads) * per_thread && churn_ok ? 0 : 1;
+}
@@ -5,7 +5,18 @@
     Basic Cpp standard input/output demos
 
 @par
-
+    Usage:
+        basic_input_output                      -> asks for your name (std::getline on std::cin)
+        some_command | basic_input_output --bulk    -> counts lines/bytes of piped input at disk speed
+        some_command | basic_input_output --compare -> times std::cin against the bulk reader
+    Bulk stdin (line_reader.h):
+        * std::getline(std::cin, line) with the default sync_with_stdio(true) goes through
+          C stdio one character at a time.
+        * pg::line_reader reads stdin in 1 MiB chunks (pipe buffer raised with F_SETPIPE_SZ),
+          or mmaps it when stdin is a redirected file, and hands out lines as string_views.
+    Compare mode:
+        stdin is first spooled to a temporary file with splice() (file_copy.h), then the same
+        bytes are read by each method in turn.
 
 $Author: Willie Chang$
 
@@ -19,16 +30,118 @@ $Source: $
     $Log: $
 
 */
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
 #include <iostream>
 #include <string>
+#include <string_view>
 // #include <bits/stdc++.h>
 
-int main() {
+#include <unistd.h>
+
+#include "file_copy.h"
+#include "line_reader.h"
+
+struct ingest_result {
+    std::size_t lines {0};
+    std::size_t bytes {0};
+    double seconds {0.0};
+};
+
+/* Read stdin with std::getline(std::cin, line) */
+static ingest_result ingest_cin() {
+    ingest_result r {};
+    auto start = std::chrono::steady_clock::now();
+    std::string line {};
+    while (std::getline(std::cin, line)) {
+        ++r.lines;
+        r.bytes += line.size();
+    }
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+/* Read stdin with the bulk line reader */
+static ingest_result ingest_bulk(pg::line_reader::mode m = pg::line_reader::mode::automatic) {
+    ingest_result r {};
+    auto start = std::chrono::steady_clock::now();
+    pg::line_reader reader {STDIN_FILENO, m};
+    std::string_view line {};
+    while (reader.next(line)) {
+        ++r.lines;
+        r.bytes += line.size();
+    }
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+static void report(const char *label, const ingest_result &r) {
+    std::cout << std::left << std::setw(26) << label << std::right
+              << std::setw(12) << r.lines << " lines"
+              << std::setw(10) << std::fixed << std::setprecision(3) << r.seconds << " s"
+              << std::setw(10) << std::setprecision(1)
+              << static_cast<double>(r.bytes) / (1024.0 * 1024.0) / r.seconds << " MB/s" << std::endl;
+}
+
+/* Point stdin (fd 0, C stdio and std::cin) back at the start of the spooled file */
+static void rewind_stdin(int spool_fd) {
+    ::dup2(spool_fd, STDIN_FILENO);
+    ::lseek(STDIN_FILENO, 0, SEEK_SET);
+    std::clearerr(stdin);
+    std::fseek(stdin, 0, SEEK_SET);
+    std::cin.clear();
+}
+
+int main(int argc, char *argv[]) {
+    std::string mode {argc > 1 ? argv[1] : ""};
+
+    /* Bulk stdin ingestion */
+    if (mode == "--bulk") {
+        ingest_result r = ingest_bulk();
+        std::cout << r.lines << " lines, " << r.bytes << " bytes" << std::endl;
+        return 0;
+    }
+
+    /* Compare std::cin against the bulk reader on the same input */
+    if (mode == "--compare") {
+        char spool_name[] {"/tmp/basic_input_output_XXXXXX"};
+        int spool_fd = ::mkstemp(spool_name);
+        if (spool_fd < 0) {
+            std::cerr << "File create error" << std::endl;
+            return 1;
+        }
+        ::unlink(spool_name);                   // removed when the fd is closed
+        pg::copy_result spooled = pg::copy_stream(STDIN_FILENO, spool_fd);
+        if (!spooled.ok) {
+            std::cerr << "stdin read error" << std::endl;
+            return 1;
+        }
+        std::cout << "spooled " << spooled.bytes << " bytes via " << pg::to_string(spooled.used) << std::endl;
+
+        rewind_stdin(spool_fd);
+        ingest_result by_cin = ingest_cin();    // sync_with_stdio(true), the default
+        rewind_stdin(spool_fd);
+        ingest_result by_read = ingest_bulk(pg::line_reader::mode::buffered);
+        rewind_stdin(spool_fd);
+        ingest_result by_mmap = ingest_bulk(pg::line_reader::mode::automatic);
+        ::close(spool_fd);
+
+        report("std::getline(std::cin)", by_cin);
+        report("bulk reader (read)", by_read);
+        report("bulk reader (mmap)", by_mmap);
+        bool same = by_cin.lines == by_read.lines && by_cin.bytes == by_read.bytes
+                 && by_cin.lines == by_mmap.lines && by_cin.bytes == by_mmap.bytes;
+        std::cout << "results match: " << std::boolalpha << same << std::endl;
+        return same ? 0 : 1;
+    }
+
     std::string name;
     std::cout << "Enter your name: ";   // no need for flushes here, before cin
-    
+
     std::getline(std::cin, name);
     std::cout << "You name is " << name << "!" << std::endl;
 
     return 0;
-}
\ No newline at end of file
+}
@@ -0,0 +1,273 @@
+/**
+@file binary_records.h
+
+@brief
+    Binary record files for the num/total/name records
+        binary_record_writer ===> .pgr file ===> mmap ===> record_view (no parsing step)
+
+@par
+    File layout (little-endian, every record starts on an 8-byte boundary):
+        file_header (16 bytes)
+            magic "PGR1", version, header size, record count, byte-order mark
+        record (24 bytes + name, padded to a multiple of 8)
+            uint32 size         -> bytes of this record including padding
+            int32 num
+            double total        -> 8-byte aligned
+            uint16 name_length
+            6 bytes padding
+            char name[name_length], then zero padding
+    Versioning:
+        * version is bumped for incompatible layout changes; readers reject newer versions.
+        * header_size lets a newer writer append header fields older readers skip.
+    Zero-copy reading:
+        * The file is mmapped (page-aligned) and every record is 8-byte aligned, so
+          record_view just points into the mapping; name() is a std::string_view into it.
+        * Every record's size and name length are bounds-checked while iterating, so a
+          truncated or corrupt file ends the iteration with an error instead of a bad read.
+          A file cut on a record boundary is caught by comparing with the header's count.
+    Usage:
+        pg::binary_record_writer out_file {"../records.pgr"};
+        out_file.write(100, 255.67, "Larry");
+        if (!out_file.close())
+            std::cerr << "File write error" << std::endl;
+
+        pg::binary_record_reader in_file {"../records.pgr"};
+        for (pg::record_view r : in_file)
+            std::cout << r.num() << " " << r.total() << " " << r.name() << std::endl;
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_BINARY_RECORDS_H
+#define PG_BINARY_RECORDS_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pg {
+
+static_assert(sizeof(double) == 8, "binary records store IEEE-754 doubles");
+
+struct file_header {
+    char magic[4];
+    std::uint16_t version;
+    std::uint16_t header_size;
+    std::uint32_t record_count;
+    std::uint32_t byte_order;       // 0x01020304 as written by the producer
+};
+
+struct record_header {
+    std::uint32_t size;
+    std::int32_t num;
+    double total;
+    std::uint16_t name_length;
+    std::uint16_t reserved[3];
+};
+
+static_assert(sizeof(file_header) == 16, "file_header layout changed");
+static_assert(sizeof(record_header) == 24 && offsetof(record_header, total) == 8, "record_header layout changed");
+static_assert(std::is_trivially_copyable_v<record_header>, "record_header must be a plain struct");
+
+constexpr char record_magic[4] {'P', 'G', 'R', '1'};
+constexpr std::uint16_t record_version {1};
+constexpr std::uint32_t record_byte_order {0x01020304};
+
+class record_view {
+public:
+    explicit record_view(const record_header *h) : h_ {h} {}
+
+    int num() const { return h_->num; }
+    double total() const { return h_->total; }
+    std::string_view name() const {
+        return std::string_view {reinterpret_cast<const char *>(h_ + 1), h_->name_length};
+    }
+
+private:
+    const record_header *h_;
+};
+
+class binary_record_writer {
+public:
+    explicit binary_record_writer(const std::string &path) {
+        out_file_.rdbuf()->pubsetbuf(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        out_file_.open(path, std::ios::out | std::ios::binary | std::ios::trunc);
+        file_header h {};
+        write_header(h);
+    }
+
+    ~binary_record_writer() { close(); }
+
+    bool is_open() const { return out_file_.is_open(); }
+    explicit operator bool() const { return static_cast<bool>(out_file_); }
+
+    /* Append one record; names longer than 65535 bytes are cut */
+    bool write(int num, double total, std::string_view name) {
+        if (name.size() > 0xFFFF)
+            name = name.substr(0, 0xFFFF);
+        record_header h {};
+        h.size = static_cast<std::uint32_t>(padded(sizeof(record_header) + name.size()));
+        h.num = num;
+        h.total = total;
+        h.name_length = static_cast<std::uint16_t>(name.size());
+        static constexpr char zeros[8] {};
+        out_file_.write(reinterpret_cast<const char *>(&h), sizeof h);
+        out_file_.write(name.data(), static_cast<std::streamsize>(name.size()));
+        out_file_.write(zeros, static_cast<std::streamsize>(h.size - sizeof h - name.size()));
+        ++count_;
+        return static_cast<bool>(out_file_);
+    }
+
+    /* Patch the record count into the header and close; false if any write, the patch or
+       the close failed (e.g. ENOSPC) */
+    bool close() {
+        if (!out_file_.is_open())
+            return static_cast<bool>(out_file_);
+        out_file_.seekp(0);
+        file_header h {};
+        write_header(h);
+        out_file_.close();
+        return static_cast<bool>(out_file_);
+    }
+
+private:
+    static std::size_t padded(std::size_t n) { return (n + 7) & ~std::size_t {7}; }
+
+    void write_header(file_header &h) {
+        std::memcpy(h.magic, record_magic, sizeof h.magic);
+        h.version = record_version;
+        h.header_size = sizeof(file_header);
+        h.record_count = count_;
+        h.byte_order = record_byte_order;
+        out_file_.write(reinterpret_cast<const char *>(&h), sizeof h);
+    }
+
+    std::vector<char> buffer_ = std::vector<char>(1 << 20);    // stream buffer, set before open
+    std::ofstream out_file_ {};
+    std::uint32_t count_ {0};
+};
+
+class binary_record_reader {
+public:
+    enum class status { ok, open_failed, bad_magic, bad_version, bad_byte_order, truncated };
+
+    explicit binary_record_reader(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            status_ = status::open_failed;
+            return;
+        }
+        struct stat st {};
+        if (::fstat(fd, &st) == 0 && static_cast<std::size_t>(st.st_size) >= sizeof(file_header)) {
+            size_ = static_cast<std::size_t>(st.st_size);
+            void *p = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED)
+                data_ = static_cast<const char *>(p);
+        }
+        ::close(fd);
+        if (data_ == nullptr) {
+            status_ = size_ < sizeof(file_header) ? status::truncated : status::open_failed;
+            size_ = 0;
+            return;
+        }
+        ::madvise(const_cast<char *>(data_), size_, MADV_SEQUENTIAL);
+        const file_header *h = reinterpret_cast<const file_header *>(data_);
+        if (std::memcmp(h->magic, record_magic, sizeof h->magic) != 0)
+            status_ = status::bad_magic;
+        else if (h->version > record_version)
+            status_ = status::bad_version;
+        else if (h->byte_order != record_byte_order)
+            status_ = status::bad_byte_order;
+        else if (h->header_size < sizeof(file_header) || h->header_size % 8 != 0 || h->header_size > size_)
+            status_ = status::truncated;
+        else
+            first_ = h->header_size;
+    }
+
+    binary_record_reader(const binary_record_reader &) = delete;
+    binary_record_reader &operator=(const binary_record_reader &) = delete;
+
+    ~binary_record_reader() {
+        if (data_ != nullptr)
+            ::munmap(const_cast<char *>(data_), size_);
+    }
+
+    explicit operator bool() const { return status_ == status::ok; }
+    status error() const { return status_; }
+    std::uint32_t record_count() const {
+        return status_ == status::ok ? reinterpret_cast<const file_header *>(data_)->record_count : 0;
+    }
+
+    class iterator {
+    public:
+        iterator(binary_record_reader *reader, std::size_t offset) : reader_ {reader}, offset_ {offset} {
+            check();
+        }
+        record_view operator*() const {
+            return record_view {reinterpret_cast<const record_header *>(reader_->data_ + offset_)};
+        }
+        iterator &operator++() {
+            offset_ += reinterpret_cast<const record_header *>(reader_->data_ + offset_)->size;
+            ++seen_;
+            check();
+            return *this;
+        }
+        bool operator!=(const iterator &o) const { return offset_ != o.offset_; }
+
+    private:
+        // Stop (and flag) at a record that doesn't fit in the file, or at an end of file
+        // reached before the header's record count
+        void check() {
+            if (reader_ == nullptr)
+                return;
+            if (offset_ == reader_->size_) {
+                if (seen_ != reader_->record_count())
+                    reader_->status_ = status::truncated;
+                return;
+            }
+            std::size_t left = reader_->size_ - offset_;
+            const record_header *h = reinterpret_cast<const record_header *>(reader_->data_ + offset_);
+            if (left < sizeof(record_header) || h->size % 8 != 0 || h->size > left
+                || h->size < sizeof(record_header) + h->name_length) {
+                reader_->status_ = status::truncated;
+                offset_ = reader_->size_;
+            }
+        }
+
+        binary_record_reader *reader_;
+        std::size_t offset_;
+        std::uint32_t seen_ {0};
+    };
+
+    iterator begin() { return iterator {status_ == status::ok ? this : nullptr, status_ == status::ok ? first_ : size_}; }
+    iterator end() { return iterator {nullptr, size_}; }
+
+private:
+    const char *data_ {nullptr};
+    std::size_t size_ {0};
+    std::size_t first_ {0};
+    status status_ {status::ok};
+};
+
+}   // namespace pg
+
+#endif  // PG_BINARY_RECORDS_H
@@ -0,0 +1,191 @@
+/**
+@file binary_records_example.cpp
+
+@brief
+    Writing and reading num/total/name records in the binary format of binary_records.h,
+    benchmarked against the text round trip from file_input_output.cpp.
+
+@par
+    Text round trip (file_input_output.cpp style):
+        out_file << num << "\n" << total << "\n" << name << "\n";
+        in_file >> num >> total >> name;
+    Binary round trip:
+        pg::binary_record_writer::write(num, total, name);
+        for (pg::record_view r : pg::binary_record_reader {path}) ...
+    Reported: encode/decode records per second and file sizes; both must read back the
+    same checksum.
+    Checks (exit code 1 on any mismatch):
+        * the demo records and the benchmark checksums read back unchanged
+        * a file cut inside a record, cut on a record boundary, cut inside the header, or
+          with a bad magic is reported by binary_record_reader::error()
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "binary_records.h"
+
+struct person {
+    int num;
+    double total;
+    std::string name;
+};
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static std::size_t file_size(const std::string &path) {
+    std::ifstream in_file {path, std::ios::binary | std::ios::ate};
+    return static_cast<std::size_t>(in_file.tellg());
+}
+
+/* Two records, 80 bytes: header 16, "Larry" record 32, "Moe" record 32 */
+static bool write_demo(const std::string &path) {
+    pg::binary_record_writer out_file {path};
+    out_file.write(100, 255.67, "Larry");
+    out_file.write(200, 1234.5, "Moe");
+    return out_file.close();
+}
+
+/* Status after reading a damaged copy of the demo file to the end */
+template <typename Damage>
+static pg::binary_record_reader::status read_damaged(const std::string &path, Damage damage) {
+    if (!write_demo(path))
+        return pg::binary_record_reader::status::open_failed;
+    damage();
+    pg::binary_record_reader in_file {path};
+    for (pg::record_view r : in_file)
+        (void)r;
+    pg::binary_record_reader::status st = in_file.error();
+    std::remove(path.c_str());
+    return st;
+}
+
+int main() {
+    bool all_ok {true};
+
+    /* Writing and reading a few records */
+    {
+        if (!write_demo("records_demo.pgr")) {
+            std::cerr << "File write error" << std::endl;
+            return 1;
+        }
+        pg::binary_record_reader in_file {"records_demo.pgr"};
+        if (!in_file) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        std::cout << in_file.record_count() << " records" << std::endl;
+        std::string read_back {};
+        for (pg::record_view r : in_file) {
+            std::cout << r.num() << " " << r.total() << " " << r.name() << std::endl;
+            read_back += std::to_string(r.num()) + " " + std::string {r.name()} + ";";
+        }
+        all_ok = all_ok && in_file && in_file.record_count() == 2 && read_back == "100 Larry;200 Moe;";
+        std::remove("records_demo.pgr");
+    }
+
+    /* Damaged files */
+    {
+        using status = pg::binary_record_reader::status;
+        const std::string path {"records_damaged.pgr"};
+        auto cut = [&](off_t size) { return [&path, size] { ::truncate(path.c_str(), size); }; };
+        status mid_record = read_damaged(path, cut(75));
+        status on_boundary = read_damaged(path, cut(48));
+        status in_header = read_damaged(path, cut(10));
+        status bad_magic = read_damaged(path, [&] {
+            std::fstream f {path, std::ios::in | std::ios::out | std::ios::binary};
+            f.put('X');
+        });
+        bool ok = mid_record == status::truncated && on_boundary == status::truncated
+               && in_header == status::truncated && bad_magic == status::bad_magic;
+        std::cout << "damaged files detected: " << std::boolalpha << ok << std::endl;
+        all_ok = all_ok && ok;
+    }
+
+    /* Benchmark */
+    const std::size_t count {2'000'000};
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    std::vector<person> people {};
+    people.reserve(count);
+    for (std::size_t i {0}; i < count; ++i)
+        people.push_back({static_cast<int>(i), i * 1.25 + 0.1, names[i % 4]});
+
+    double expected {0.0};
+    for (const person &p : people)
+        expected += p.num + p.total + p.name.size();
+
+    // text
+    auto start = std::chrono::steady_clock::now();
+    {
+        std::ofstream out_file {"records_bench.txt"};
+        out_file << std::setprecision(std::numeric_limits<double>::max_digits10);    // exact round trip
+        for (const person &p : people)
+            out_file << p.num << "\n" << p.total << "\n" << p.name << "\n";
+    }
+    double text_encode = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    double text_sum {0.0};
+    {
+        std::ifstream in_file {"records_bench.txt"};
+        int num {};
+        double total {};
+        std::string name {};
+        while (in_file >> num >> total >> name)
+            text_sum += num + total + name.size();
+    }
+    double text_decode = seconds_since(start);
+
+    // binary
+    start = std::chrono::steady_clock::now();
+    {
+        pg::binary_record_writer out_file {"records_bench.pgr"};
+        for (const person &p : people)
+            out_file.write(p.num, p.total, p.name);
+        all_ok = all_ok && out_file.close();
+    }
+    double bin_encode = seconds_since(start);
+    start = std::chrono::steady_clock::now();
+    double bin_sum {0.0};
+    {
+        pg::binary_record_reader in_file {"records_bench.pgr"};
+        for (pg::record_view r : in_file)
+            bin_sum += r.num() + r.total() + r.name().size();
+        if (!in_file)
+            std::cerr << "corrupt binary file" << std::endl;
+        all_ok = all_ok && in_file;
+    }
+    double bin_decode = seconds_since(start);
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "text:   encode " << std::setw(10) << count / text_encode << " rec/s   decode "
+              << std::setw(10) << count / text_decode << " rec/s   " << file_size("records_bench.txt") << " bytes" << std::endl
+              << "binary: encode " << std::setw(10) << count / bin_encode << " rec/s   decode "
+              << std::setw(10) << count / bin_decode << " rec/s   " << file_size("records_bench.pgr") << " bytes" << std::endl;
+
+    all_ok = all_ok && text_sum == expected && bin_sum == expected;
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    std::remove("records_bench.txt");
+    std::remove("records_bench.pgr");
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,635 @@
+/**
+@file compressed_stream.h
+
+@brief
+    Streaming gzip/zstd decompression source and compression sink
+        .gz/.zst file ===> decompress_source ===> pipe fd ===> line_reader / copy_stream
+        copy_stream / write() ===> pipe fd ===> compress_sink ===> .gz/.zst file
+
+@par
+    Plugging into the existing readers and copiers:
+        * Both ends hand out a plain file descriptor (fd()). A decompress_source can be passed
+          to pg::line_reader {src.fd()} or pg::copy_stream(src.fd(), out). A compress_sink is
+          the `out` of copy_stream(in, sink.fd()).
+        * Compression runs on a background thread behind a pipe, so it overlaps with whatever
+          the caller does with the data.
+        * Uncompressed files skip the pipe: fd() is the file itself (line_reader still mmaps it).
+    Formats (detected from the magic bytes on read, from the extension on write):
+        gzip -> zlib; single- and multi-member files
+        zstd -> only when built with PG_HAVE_ZSTD=1; serial streaming decode
+    Multi-threaded decompression:
+        * A plain gzip stream can't be split: one inflate runs on the background thread.
+        * compress_sink writes "blocked gzip": one gzip member per block_size of input, each
+          carrying its compressed size in a "PG" extra subfield. bgzip/BGZF files carry the
+          same information in a "BC" subfield. Any gzip tool still reads these as ordinary
+          multi-member gzip.
+        * When every member has such a size, decompress_source indexes the members and
+          inflates them in parallel on a work_stealing_pool (parallel_scan.h). The output is
+          written in order, and the next batch decodes while the current one is written.
+        * compress_sink compresses its blocks in parallel the same way.
+    Errors:
+        Nothing throws. error() is checked after finish() or close(). A corrupt or truncated
+        stream ends the decompressed output early and sets stream_errc::corrupt.
+    Build:
+        link with -lz; for zstd, define PG_HAVE_ZSTD=1 and link with -lzstd (CMake does both
+        when it finds libzstd)
+    Usage:
+        pg::decompress_source src {"../access.log.gz"};
+        pg::line_reader reader {src.fd()};
+        std::string_view line {};
+        while (reader.next(line))
+            ...
+        if (!src.finish())
+            std::cerr << "corrupt input: " << pg::to_string(src.error()) << std::endl;
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_COMPRESSED_STREAM_H
+#define PG_COMPRESSED_STREAM_H
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <csignal>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <zlib.h>
+
+#ifndef PG_HAVE_ZSTD
+#define PG_HAVE_ZSTD 0              // set by the build together with -lzstd
+#endif
+#if PG_HAVE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "file_copy.h"
+#include "parallel_scan.h"
+
+namespace pg {
+
+enum class compression { none, gzip, zstd };
+
+inline const char *to_string(compression c) {
+    switch (c) {
+        case compression::none: return "none";
+        case compression::gzip: return "gzip";
+        case compression::zstd: return "zstd";
+    }
+    return "?";
+}
+
+enum class stream_errc { ok, open_failed, unsupported, corrupt, write_failed };
+
+inline const char *to_string(stream_errc e) {
+    switch (e) {
+        case stream_errc::ok:           return "ok";
+        case stream_errc::open_failed:  return "open failed";
+        case stream_errc::unsupported:  return "unsupported format";
+        case stream_errc::corrupt:      return "corrupt or truncated data";
+        case stream_errc::write_failed: return "write failed";
+    }
+    return "?";
+}
+
+/* Format from the first bytes of a file */
+inline compression detect_compression(const unsigned char *p, std::size_t n) {
+    if (n >= 2 && p[0] == 0x1F && p[1] == 0x8B)
+        return compression::gzip;
+    if (n >= 4 && p[0] == 0x28 && p[1] == 0xB5 && p[2] == 0x2F && p[3] == 0xFD)
+        return compression::zstd;
+    return compression::none;
+}
+
+/* Format from a file name: ".gz" / ".zst", anything else is uncompressed */
+inline compression compression_for_path(std::string_view path) {
+    auto ends_with = [&](std::string_view suffix) {
+        return path.size() >= suffix.size() && path.substr(path.size() - suffix.size()) == suffix;
+    };
+    if (ends_with(".gz"))
+        return compression::gzip;
+    if (ends_with(".zst"))
+        return compression::zstd;
+    return compression::none;
+}
+
+struct stream_options {
+    unsigned threads {std::thread::hardware_concurrency()};    // block (de)compression workers
+    std::size_t block_size {1u << 20};                          // sink: input bytes per gzip member
+    int level {6};                                              // sink: zlib / zstd level
+};
+
+namespace detail {
+
+constexpr std::size_t gzip_block_header {20};   // 10 fixed + XLEN + "PG" subfield (4 + 4)
+constexpr std::size_t gzip_trailer {8};         // CRC32 + ISIZE
+constexpr std::size_t max_block_output {256u << 20};
+
+struct gzip_block {
+    std::size_t offset;         // member start in the file
+    std::size_t size;           // whole member
+    std::size_t data;           // deflate data start
+    std::uint32_t crc;
+    std::uint32_t isize;
+};
+
+inline std::uint16_t get_le16(const unsigned char *p) { return static_cast<std::uint16_t>(p[0] | p[1] << 8); }
+inline std::uint32_t get_le32(const unsigned char *p) {
+    return p[0] | p[1] << 8 | p[2] << 16 | static_cast<std::uint32_t>(p[3]) << 24;
+}
+inline void put_le32(unsigned char *p, std::uint32_t v) {
+    for (int i {0}; i < 4; ++i)
+        p[i] = static_cast<unsigned char>(v >> (8 * i));
+}
+
+/* Index a blocked gzip file ("PG" or BGZF "BC" member sizes); false if any member lacks one */
+inline bool index_gzip_blocks(const unsigned char *p, std::size_t size, std::vector<gzip_block> &blocks) {
+    std::size_t pos {0};
+    while (pos < size) {
+        std::size_t left = size - pos;
+        const unsigned char *h = p + pos;
+        if (left < 12 + gzip_trailer || h[0] != 0x1F || h[1] != 0x8B || h[2] != 8 || h[3] != 0x04)
+            return false;                       // FLG must be exactly FEXTRA
+        std::size_t xlen = get_le16(h + 10);
+        if (left < 12 + xlen + gzip_trailer)
+            return false;
+        std::size_t member {0};
+        for (std::size_t x {0}; x + 4 <= xlen;) {
+            const unsigned char *sf = h + 12 + x;
+            std::size_t slen = get_le16(sf + 2);
+            if (x + 4 + slen > xlen)
+                return false;
+            if (sf[0] == 'P' && sf[1] == 'G' && slen == 4)
+                member = get_le32(sf + 4);
+            else if (sf[0] == 'B' && sf[1] == 'C' && slen == 2)
+                member = std::size_t {get_le16(sf + 4)} + 1;
+            x += 4 + slen;
+        }
+        if (member < 12 + xlen + gzip_trailer || member > left)
+            return false;
+        gzip_block b {pos, member, pos + 12 + xlen, get_le32(h + member - 8), get_le32(h + member - 4)};
+        if (b.isize > max_block_output)
+            return false;
+        blocks.push_back(b);
+        pos += member;
+    }
+    return !blocks.empty();
+}
+
+inline bool inflate_block(const unsigned char *file, const gzip_block &b, std::vector<char> &out) {
+    out.resize(b.isize);
+    z_stream z {};
+    if (inflateInit2(&z, -MAX_WBITS) != Z_OK)
+        return false;
+    z.next_in = const_cast<Bytef *>(file + b.data);
+    z.avail_in = static_cast<uInt>(b.offset + b.size - gzip_trailer - b.data);
+    z.next_out = reinterpret_cast<Bytef *>(out.data());
+    z.avail_out = static_cast<uInt>(out.size());
+    int rc = inflate(&z, Z_FINISH);
+    bool ok = rc == Z_STREAM_END && z.total_out == b.isize;
+    inflateEnd(&z);
+    return ok && crc32(0, reinterpret_cast<const Bytef *>(out.data()), static_cast<uInt>(out.size())) == b.crc;
+}
+
+/* One gzip member holding `in`, with its size in a "PG" extra subfield */
+inline bool deflate_block(const char *in, std::size_t n, int level, std::vector<unsigned char> &out) {
+    z_stream z {};
+    if (deflateInit2(&z, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+        return false;
+    out.resize(gzip_block_header + deflateBound(&z, static_cast<uLong>(n)) + gzip_trailer);
+    static constexpr unsigned char header[gzip_block_header - 4] {
+        0x1F, 0x8B, 8, 0x04, 0, 0, 0, 0, 0, 0xFF,  // magic, deflate, FEXTRA, mtime, xfl, OS unknown
+        8, 0,                                       // XLEN
+        'P', 'G', 4, 0};                            // subfield id and length
+    std::memcpy(out.data(), header, sizeof header);
+    z.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(in));
+    z.avail_in = static_cast<uInt>(n);
+    z.next_out = out.data() + gzip_block_header;
+    z.avail_out = static_cast<uInt>(out.size() - gzip_block_header - gzip_trailer);
+    int rc = deflate(&z, Z_FINISH);
+    std::size_t member = gzip_block_header + z.total_out + gzip_trailer;
+    deflateEnd(&z);
+    if (rc != Z_STREAM_END)
+        return false;
+    out.resize(member);
+    put_le32(out.data() + 16, static_cast<std::uint32_t>(member));
+    put_le32(out.data() + member - 8,
+             static_cast<std::uint32_t>(crc32(0, reinterpret_cast<const Bytef *>(in), static_cast<uInt>(n))));
+    put_le32(out.data() + member - 4, static_cast<std::uint32_t>(n));
+    return true;
+}
+
+/* A write to a pipe whose reader has gone must fail with EPIPE, not kill the process */
+inline void block_sigpipe() {
+    sigset_t set {};
+    sigemptyset(&set);
+    sigaddset(&set, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &set, nullptr);
+}
+
+inline void grow_pipe(int fd) {
+#ifdef F_SETPIPE_SZ
+    ::fcntl(fd, F_SETPIPE_SZ, 1 << 20);         // best effort, like line_reader
+#endif
+}
+
+}   // namespace detail
+
+class decompress_source {
+public:
+    explicit decompress_source(const std::string &path, stream_options options = {}) : options_ {options} {
+        file_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (file_ < 0) {
+            error_ = stream_errc::open_failed;
+            return;
+        }
+        unsigned char magic[4] {};
+        ssize_t n = ::pread(file_, magic, sizeof magic, 0);
+        format_ = detect_compression(magic, n > 0 ? static_cast<std::size_t>(n) : 0);
+        if (format_ == compression::none)
+            return;                             // fd() is the file itself
+#if !PG_HAVE_ZSTD
+        if (format_ == compression::zstd) {
+            error_ = stream_errc::unsupported;
+            return;
+        }
+#endif
+        int fds[2];
+        if (::pipe2(fds, O_CLOEXEC) != 0) {
+            error_ = stream_errc::open_failed;
+            return;
+        }
+        read_end_ = fds[0];
+        write_end_ = fds[1];
+        detail::grow_pipe(write_end_);
+        worker_ = std::thread {[this] { produce(); }};
+    }
+
+    decompress_source(const decompress_source &) = delete;
+    decompress_source &operator=(const decompress_source &) = delete;
+
+    ~decompress_source() {
+        close_fd(read_end_);                    // unblocks the worker (EPIPE)
+        if (worker_.joinable())
+            worker_.join();
+        close_fd(file_);
+    }
+
+    /* Descriptor to read the decompressed bytes from */
+    int fd() const { return format_ == compression::none ? file_ : read_end_; }
+    explicit operator bool() const { return fd() >= 0 && error_ == stream_errc::ok; }
+    compression format() const { return format_; }
+    bool parallel() const { return parallel_; } // valid after finish()
+
+    /* Done reading: close fd() and wait for the decoder. True if everything decoded so far was
+       clean; stopping before EOF is not an error */
+    bool finish() {
+        close_fd(read_end_);                    // a worker blocked in write() gets EPIPE
+        if (worker_.joinable())
+            worker_.join();
+        return error_ == stream_errc::ok;
+    }
+    stream_errc error() const { return error_; }
+
+private:
+    static void close_fd(int &fd) {
+        if (fd >= 0)
+            ::close(fd);
+        fd = -1;
+    }
+
+    void produce() {
+        detail::block_sigpipe();
+        struct stat st {};
+        std::size_t size {0};
+        void *map {MAP_FAILED};
+        if (::fstat(file_, &st) == 0 && st.st_size > 0) {
+            size = static_cast<std::size_t>(st.st_size);
+            map = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_, 0);
+        }
+        if (map == MAP_FAILED) {
+            error_ = size == 0 ? stream_errc::corrupt : stream_errc::open_failed;
+        } else {
+            ::madvise(map, size, MADV_SEQUENTIAL);
+            const unsigned char *data = static_cast<const unsigned char *>(map);
+            if (format_ == compression::gzip) {
+                std::vector<detail::gzip_block> blocks {};
+                if (options_.threads > 1 && detail::index_gzip_blocks(data, size, blocks)) {
+                    parallel_ = true;
+                    inflate_parallel(data, blocks);
+                } else {
+                    inflate_serial(data, size);
+                }
+            }
+#if PG_HAVE_ZSTD
+            else if (format_ == compression::zstd) {
+                decompress_zstd(data, size);
+            }
+#endif
+            ::munmap(map, size);
+        }
+        close_fd(write_end_);                   // EOF for the reader
+    }
+
+    bool emit(const char *p, std::size_t n) {
+        if (detail::write_all(write_end_, p, n))
+            return true;
+        if (errno != EPIPE)                     // EPIPE: the reader stopped early, not an error
+            error_ = stream_errc::write_failed;
+        return false;
+    }
+
+    // Any gzip stream, members one after another
+    void inflate_serial(const unsigned char *data, std::size_t size) {
+        z_stream z {};
+        if (inflateInit2(&z, MAX_WBITS + 16) != Z_OK) {
+            error_ = stream_errc::corrupt;
+            return;
+        }
+        std::vector<char> out(1u << 20);
+        std::size_t pos {0};
+        int rc {Z_OK};
+        while (pos < size) {
+            std::size_t chunk = std::min<std::size_t>(size - pos, UINT_MAX);
+            z.next_in = const_cast<Bytef *>(data + pos);
+            z.avail_in = static_cast<uInt>(chunk);
+            do {
+                z.next_out = reinterpret_cast<Bytef *>(out.data());
+                z.avail_out = static_cast<uInt>(out.size());
+                rc = inflate(&z, Z_NO_FLUSH);
+                if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) {
+                    error_ = stream_errc::corrupt;
+                    inflateEnd(&z);
+                    return;
+                }
+                if (!emit(out.data(), out.size() - z.avail_out)) {
+                    inflateEnd(&z);
+                    return;
+                }
+                if (rc == Z_STREAM_END && z.avail_in > 0)
+                    inflateReset(&z);           // next member
+            } while (z.avail_out == 0 || (rc == Z_STREAM_END && z.avail_in > 0));
+            pos += chunk - z.avail_in;
+            if (rc == Z_BUF_ERROR && z.avail_in == chunk)
+                break;                          // no progress
+        }
+        if (rc != Z_STREAM_END)
+            error_ = stream_errc::corrupt;      // truncated
+        inflateEnd(&z);
+    }
+
+    // Blocked gzip: decode batch k + 1 on the pool while batch k is written out
+    void inflate_parallel(const unsigned char *data, const std::vector<detail::gzip_block> &blocks) {
+        work_stealing_pool pool {options_.threads};
+        const std::size_t batch = std::size_t {pool.size()} * 2;
+        std::vector<std::vector<char>> current(batch), next(batch);
+        std::vector<char> ok_current(batch), ok_next(batch);
+
+        auto submit = [&](std::size_t first, std::vector<std::vector<char>> &out, std::vector<char> &ok) {
+            for (std::size_t i {0}; i < batch && first + i < blocks.size(); ++i)
+                pool.submit([&, i, first] { ok[i] = detail::inflate_block(data, blocks[first + i], out[i]); });
+        };
+
+        submit(0, current, ok_current);
+        pool.wait();
+        for (std::size_t first {0}; first < blocks.size(); first += batch) {
+            if (first + batch < blocks.size())
+                submit(first + batch, next, ok_next);
+            bool stop {false};
+            for (std::size_t i {0}; i < batch && first + i < blocks.size() && !stop; ++i) {
+                if (!ok_current[i]) {
+                    error_ = stream_errc::corrupt;
+                    stop = true;
+                } else {
+                    stop = !emit(current[i].data(), current[i].size());
+                }
+            }
+            pool.wait();
+            if (stop)
+                return;
+            current.swap(next);
+            ok_current.swap(ok_next);
+        }
+    }
+
+#if PG_HAVE_ZSTD
+    void decompress_zstd(const unsigned char *data, std::size_t size) {
+        ZSTD_DStream *ds = ZSTD_createDStream();
+        std::vector<char> out(ZSTD_DStreamOutSize());
+        ZSTD_inBuffer in {data, size, 0};
+        std::size_t rc {1};
+        while (in.pos < in.size) {
+            ZSTD_outBuffer o {out.data(), out.size(), 0};
+            rc = ZSTD_decompressStream(ds, &o, &in);
+            if (ZSTD_isError(rc)) {
+                error_ = stream_errc::corrupt;
+                break;
+            }
+            if (!emit(out.data(), o.pos))
+                break;
+        }
+        if (rc != 0 && error_ == stream_errc::ok)
+            error_ = stream_errc::corrupt;      // frame not finished
+        ZSTD_freeDStream(ds);
+    }
+#endif
+
+    stream_options options_;
+    int file_ {-1};
+    int read_end_ {-1};
+    int write_end_ {-1};
+    compression format_ {compression::none};
+    std::atomic<stream_errc> error_ {stream_errc::ok};      // set by the worker thread
+    bool parallel_ {false};
+    std::thread worker_ {};
+};
+
+class compress_sink {
+public:
+    /* Compress into `path` (created or truncated); the format comes from the extension */
+    explicit compress_sink(const std::string &path, stream_options options = {})
+        : compress_sink {path, compression_for_path(path), options} {}
+
+    compress_sink(const std::string &path, compression format, stream_options options = {})
+        : options_ {options}, format_ {format} {
+        file_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (file_ < 0) {
+            error_ = stream_errc::open_failed;
+            return;
+        }
+        if (format_ == compression::none)
+            return;                             // fd() is the file itself
+#if !PG_HAVE_ZSTD
+        if (format_ == compression::zstd) {
+            error_ = stream_errc::unsupported;
+            return;
+        }
+#endif
+        if (options_.block_size == 0)
+            options_.block_size = 1u << 20;
+        int fds[2];
+        if (::pipe2(fds, O_CLOEXEC) != 0) {
+            error_ = stream_errc::open_failed;
+            return;
+        }
+        read_end_ = fds[0];
+        write_end_ = fds[1];
+        detail::grow_pipe(write_end_);
+        worker_ = std::thread {[this] { consume(); }};
+    }
+
+    compress_sink(const compress_sink &) = delete;
+    compress_sink &operator=(const compress_sink &) = delete;
+
+    ~compress_sink() { close(); }
+
+    /* Descriptor to write the uncompressed bytes to */
+    int fd() const { return format_ == compression::none ? file_ : write_end_; }
+    explicit operator bool() const { return fd() >= 0 && error_ == stream_errc::ok; }
+    compression format() const { return format_; }
+
+    bool write(std::string_view data) {
+        if (fd() < 0 || !detail::write_all(fd(), data.data(), data.size())) {
+            error_ = stream_errc::write_failed;
+            return false;
+        }
+        return true;
+    }
+
+    /* Flush the last block and close the file; true if everything was written */
+    bool close() {
+        if (write_end_ >= 0) {
+            ::close(write_end_);
+            write_end_ = -1;
+        }
+        if (worker_.joinable())
+            worker_.join();
+        if (read_end_ >= 0) {
+            ::close(read_end_);
+            read_end_ = -1;
+        }
+        if (file_ >= 0) {
+            if (::close(file_) != 0 && error_ == stream_errc::ok)
+                error_ = stream_errc::write_failed;
+            file_ = -1;
+        }
+        return error_ == stream_errc::ok;
+    }
+
+    stream_errc error() const { return error_; }
+    std::size_t bytes_in() const { return bytes_in_; }
+    std::size_t bytes_out() const { return bytes_out_; }
+
+private:
+    // Read a batch of blocks from the pipe, compress them in parallel, write in order
+    void consume() {
+        work_stealing_pool pool {options_.threads == 0 ? 1 : options_.threads};
+        const std::size_t batch = std::size_t {pool.size()} * 2;
+        std::vector<std::vector<char>> input(batch, std::vector<char>(options_.block_size));
+        std::vector<std::size_t> filled(batch);
+        std::vector<std::vector<unsigned char>> output(batch);
+        std::vector<char> ok(batch);
+        bool eof {false};
+        bool any {false};
+
+        while (!eof) {
+            std::size_t blocks {0};
+            for (; blocks < batch && !eof; ++blocks) {
+                filled[blocks] = fill(input[blocks], eof);
+                if (filled[blocks] == 0)
+                    break;
+            }
+            if (blocks == 0 && any)
+                break;
+            if (blocks == 0)
+                blocks = 1;                     // empty input: still write one valid member
+            any = true;
+            for (std::size_t i {0}; i < blocks; ++i)
+                pool.submit([&, i] { ok[i] = compress_block(input[i].data(), filled[i], output[i]); });
+            pool.wait();
+            for (std::size_t i {0}; i < blocks; ++i) {
+                if (!ok[i] || !detail::write_all(file_, reinterpret_cast<const char *>(output[i].data()),
+                                                 output[i].size())) {
+                    error_ = stream_errc::write_failed;
+                    drain_pipe();
+                    return;
+                }
+                bytes_in_ += filled[i];
+                bytes_out_ += output[i].size();
+            }
+        }
+    }
+
+    // Fill one block from the pipe; sets eof at end of input
+    std::size_t fill(std::vector<char> &block, bool &eof) {
+        std::size_t n {0};
+        while (n < block.size()) {
+            ssize_t r = ::read(read_end_, block.data() + n, block.size() - n);
+            if (r > 0) {
+                n += static_cast<std::size_t>(r);
+                continue;
+            }
+            if (r < 0 && errno == EINTR)
+                continue;
+            eof = true;
+            break;
+        }
+        return n;
+    }
+
+    // Keep the writer from blocking forever after an error
+    void drain_pipe() {
+        char scratch[65536];
+        while (::read(read_end_, scratch, sizeof scratch) > 0) {
+        }
+    }
+
+    bool compress_block(const char *in, std::size_t n, std::vector<unsigned char> &out) const {
+#if PG_HAVE_ZSTD
+        if (format_ == compression::zstd) {
+            out.resize(ZSTD_compressBound(n));
+            std::size_t rc = ZSTD_compress(out.data(), out.size(), in, n, options_.level);
+            if (ZSTD_isError(rc))
+                return false;
+            out.resize(rc);                     // one zstd frame per block; frames concatenate
+            return true;
+        }
+#endif
+        return detail::deflate_block(in, n, options_.level, out);
+    }
+
+    stream_options options_;
+    compression format_;
+    int file_ {-1};
+    int read_end_ {-1};
+    int write_end_ {-1};
+    std::atomic<stream_errc> error_ {stream_errc::ok};      // set by the worker thread
+    std::size_t bytes_in_ {0};
+    std::size_t bytes_out_ {0};
+    std::thread worker_ {};
+};
+
+}   // namespace pg
+
+#endif  // PG_COMPRESSED_STREAM_H
@@ -0,0 +1,824 @@
+/**
+@file csv_tokenizer.h
+
+@brief
+    Streaming CSV/TSV tokenizer with vectorized structural-character detection
+        File ===> 64-byte blocks ===> delimiter/quote/'\n' bitmasks ===> field positions ===> std::string_view fields
+
+@par
+    Why not getline + std::istringstream:
+        * std::getline(iss, field, ',') can't tell a ',' inside "..." from a delimiter,
+          copies every field into a std::string and runs a few MB/s.
+        * csv_reader finds every delimiter, quote and '\n' of a 64-byte block with a few
+          SIMD compares (one bitmask each), and works out which of them sit inside quotes
+          with a prefix XOR of the quote mask (carry-less multiply on AVX2 CPUs), as simdjson
+          does. Only the positions left over are visited one at a time.
+    Stages:
+        1. index: strips of the buffer -> positions of delimiters and '\n' outside quotes.
+        2. rows: consecutive positions -> std::string_view fields of one row.
+    Format (RFC 4180):
+        * Fields split by the delimiter, rows by '\n'; a "\r\n" row end drops the '\r'.
+        * "..." fields may hold delimiters, newlines and doubled quotes ("" -> ").
+          The view holds the text between the quotes, with "" unescaped.
+        * A quote inside an unquoted field, or text after a closing quote, is bad_quote;
+          a quote still open at end of input is unterminated_quote.
+        * Spaces are part of the field. An empty line is a row with one empty field.
+        * The last row is returned even without a trailing '\n'.
+        * csv_options::tsv(): tab delimiter, no quoting (quotes are plain text).
+    Views are only valid until the next call to next().
+    Usage:
+        pg::csv_reader reader {"../data.csv"};
+        if (!reader) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        pg::csv_row row {};
+        while (reader.next(row))
+            for (std::string_view field : row)
+                ...
+        if (reader.error() != pg::csv_errc::ok)
+            std::cerr << pg::to_string(reader.error()) << " in row " << reader.error_row() << std::endl;
+    Columnar buffers with type inference:
+        pg::csv_table table = pg::read_csv_columns("../data.csv");
+        const pg::csv_column *total = table.find("total");     // column_type::floating
+        for (double t : total->floats)
+            ...
+        Each column gets the narrowest of boolean (true/false), integer (int64), floating
+        (double) and text that holds every non-empty field. Inference reads the file once
+        and the values a second time; column_options::infer_rows limits the first pass,
+        and later values that don't fit the inferred type count as mismatches.
+        "-" (stdin), pipes and FIFOs can't be read twice: they are read into memory first.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_CSV_TOKENIZER_H
+#define PG_CSV_TOKENIZER_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "newline_scan.h"
+#include "record_parser.h"
+
+namespace pg {
+
+enum class csv_errc { ok, unterminated_quote, bad_quote, row_too_long, read_failed };
+
+inline const char *to_string(csv_errc code) {
+    switch (code) {
+    case csv_errc::ok: return "ok";
+    case csv_errc::unterminated_quote: return "unterminated quote";
+    case csv_errc::bad_quote: return "bad quote";
+    case csv_errc::row_too_long: return "row too long";
+    case csv_errc::read_failed: return "read failed";
+    }
+    return "?";
+}
+
+struct csv_options {
+    char delimiter {','};
+    bool quoting {true};                                // RFC 4180 "..." fields
+    std::size_t buffer_size {std::size_t {1} << 20};    // read() size; grows while one row fills it
+    simd_level level {detected_simd_level()};
+
+    static csv_options tsv() {
+        csv_options o {};
+        o.delimiter = '\t';
+        o.quoting = false;
+        return o;
+    }
+};
+
+namespace csv_scan {
+
+#define PG_CSV_INLINE __attribute__((always_inline)) inline
+
+constexpr std::size_t strip_size {16 * 1024};   // stage 1 runs this far ahead of stage 2
+
+/* One bit per byte of a 64-byte block */
+struct block_masks {
+    std::uint64_t quote;
+    std::uint64_t delim;
+    std::uint64_t newline;
+};
+
+/* Carried from one block to the next */
+struct scan_state {
+    std::uint64_t in_quote {0};     // all ones while a quoted field is open
+    bool saw_quote {false};
+};
+
+/* Bit i = XOR of bits 0..i: 1 between an opening quote and its closing quote */
+PG_CSV_INLINE std::uint64_t prefix_xor(std::uint64_t x) {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+}
+
+// A doubled quote ("") toggles twice, so escaped quotes leave the region as it was
+PG_CSV_INLINE std::uint32_t *emit(const block_masks &m, std::uint64_t quote_region, bool quoting,
+                                  scan_state &s, std::uint32_t base, std::uint32_t *out) {
+    std::uint64_t structural = m.delim | m.newline;
+    if (quoting) {
+        std::uint64_t inside = quote_region ^ s.in_quote;
+        s.in_quote = 0 - (inside >> 63);
+        s.saw_quote |= m.quote != 0;
+        structural &= ~inside;
+    }
+    while (structural != 0) {
+        *out++ = base + static_cast<std::uint32_t>(__builtin_ctzll(structural));
+        structural &= structural - 1;
+    }
+    return out;
+}
+
+/* Last partial block, zero padded; bits past `size` are cleared by the caller */
+PG_CSV_INLINE const char *pad_tail(const char *data, std::size_t size, char (&block)[64]) {
+    std::memset(block, 0, sizeof block);
+    std::memcpy(block, data, size);
+    return block;
+}
+
+PG_CSV_INLINE void clip(block_masks &m, std::size_t size) {
+    std::uint64_t keep = (std::uint64_t {1} << size) - 1;
+    m.quote &= keep;
+    m.delim &= keep;
+    m.newline &= keep;
+}
+
+using index_fn = std::uint32_t *(*)(const char *data, std::size_t size, char delim, bool quoting,
+                                    scan_state &s, std::uint32_t base, std::uint32_t *out);
+
+/* Scalar kernel */
+inline block_masks masks_scalar(const char *p, char delim) {
+    block_masks m {0, 0, 0};
+    for (unsigned i {0}; i < 64; ++i) {
+        std::uint64_t bit = std::uint64_t {1} << i;
+        m.quote |= p[i] == '"' ? bit : 0;
+        m.delim |= p[i] == delim ? bit : 0;
+        m.newline |= p[i] == '\n' ? bit : 0;
+    }
+    return m;
+}
+
+inline std::uint32_t *index_scalar(const char *data, std::size_t size, char delim, bool quoting,
+                                   scan_state &s, std::uint32_t base, std::uint32_t *out) {
+    std::size_t i {0};
+    for (; i + 64 <= size; i += 64) {
+        block_masks m = masks_scalar(data + i, delim);
+        out = emit(m, prefix_xor(m.quote), quoting, s, base + static_cast<std::uint32_t>(i), out);
+    }
+    if (i < size) {
+        char block[64];
+        block_masks m = masks_scalar(pad_tail(data + i, size - i, block), delim);
+        clip(m, size - i);
+        out = emit(m, prefix_xor(m.quote), quoting, s, base + static_cast<std::uint32_t>(i), out);
+    }
+    return out;
+}
+
+#ifdef PG_SCAN_X86
+/* SSE2 kernel */
+PG_CSV_INLINE std::uint64_t movemask_sse2(__m128i a, __m128i b, __m128i c, __m128i d) {
+    return static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(a)))
+         | static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(b))) << 16
+         | static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(c))) << 32
+         | static_cast<std::uint64_t>(static_cast<unsigned>(_mm_movemask_epi8(d))) << 48;
+}
+
+PG_CSV_INLINE block_masks masks_sse2(const char *p, char delim) {
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i sep = _mm_set1_epi8(delim);
+    const __m128i newline = _mm_set1_epi8('\n');
+    __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+    __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 16));
+    __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 32));
+    __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + 48));
+    return {movemask_sse2(_mm_cmpeq_epi8(a, quote), _mm_cmpeq_epi8(b, quote),
+                          _mm_cmpeq_epi8(c, quote), _mm_cmpeq_epi8(d, quote)),
+            movemask_sse2(_mm_cmpeq_epi8(a, sep), _mm_cmpeq_epi8(b, sep),
+                          _mm_cmpeq_epi8(c, sep), _mm_cmpeq_epi8(d, sep)),
+            movemask_sse2(_mm_cmpeq_epi8(a, newline), _mm_cmpeq_epi8(b, newline),
+                          _mm_cmpeq_epi8(c, newline), _mm_cmpeq_epi8(d, newline))};
+}
+
+inline std::uint32_t *index_sse2(const char *data, std::size_t size, char delim, bool quoting,
+                                 scan_state &s, std::uint32_t base, std::uint32_t *out) {
+    std::size_t i {0};
+    for (; i + 64 <= size; i += 64) {
+        block_masks m = masks_sse2(data + i, delim);
+        out = emit(m, prefix_xor(m.quote), quoting, s, base + static_cast<std::uint32_t>(i), out);
+    }
+    if (i < size) {
+        char block[64];
+        block_masks m = masks_sse2(pad_tail(data + i, size - i, block), delim);
+        clip(m, size - i);
+        out = emit(m, prefix_xor(m.quote), quoting, s, base + static_cast<std::uint32_t>(i), out);
+    }
+    return out;
+}
+
+#if defined(__x86_64__)                 // _mm_cvtsi128_si64 is x86-64 only
+/* AVX2 kernel (every AVX2 CPU has PCLMULQDQ) */
+__attribute__((target("avx2,pclmul")))
+PG_CSV_INLINE std::uint64_t movemask_avx2(__m256i lo, __m256i hi) {
+    return static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(lo)))
+         | static_cast<std::uint64_t>(static_cast<unsigned>(_mm256_movemask_epi8(hi))) << 32;
+}
+
+__attribute__((target("avx2,pclmul")))
+PG_CSV_INLINE block_masks masks_avx2(const char *p, char delim) {
+    const __m256i quote = _mm256_set1_epi8('"');
+    const __m256i sep = _mm256_set1_epi8(delim);
+    const __m256i newline = _mm256_set1_epi8('\n');
+    __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p));
+    __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + 32));
+    return {movemask_avx2(_mm256_cmpeq_epi8(lo, quote), _mm256_cmpeq_epi8(hi, quote)),
+            movemask_avx2(_mm256_cmpeq_epi8(lo, sep), _mm256_cmpeq_epi8(hi, sep)),
+            movemask_avx2(_mm256_cmpeq_epi8(lo, newline), _mm256_cmpeq_epi8(hi, newline))};
+}
+
+// Carry-less multiply by all ones == prefix XOR, in one instruction
+__attribute__((target("avx2,pclmul")))
+PG_CSV_INLINE std::uint64_t prefix_xor_clmul(std::uint64_t x) {
+    __m128i r = _mm_clmulepi64_si128(_mm_set_epi64x(0, static_cast<long long>(x)), _mm_set1_epi8(-1), 0);
+    return static_cast<std::uint64_t>(_mm_cvtsi128_si64(r));
+}
+
+__attribute__((target("avx2,pclmul")))
+inline std::uint32_t *index_avx2(const char *data, std::size_t size, char delim, bool quoting,
+                                 scan_state &s, std::uint32_t base, std::uint32_t *out) {
+    std::size_t i {0};
+    for (; i + 64 <= size; i += 64) {
+        block_masks m = masks_avx2(data + i, delim);
+        out = emit(m, prefix_xor_clmul(m.quote), quoting, s, base + static_cast<std::uint32_t>(i), out);
+    }
+    if (i < size) {
+        char block[64];
+        block_masks m = masks_avx2(pad_tail(data + i, size - i, block), delim);
+        clip(m, size - i);
+        out = emit(m, prefix_xor_clmul(m.quote), quoting, s, base + static_cast<std::uint32_t>(i), out);
+    }
+    return out;
+}
+#endif  // __x86_64__
+#endif  // PG_SCAN_X86
+
+#undef PG_CSV_INLINE
+
+/* Kernel for an explicit level (levels the CPU or target lacks fall back to scalar) */
+inline index_fn index_kernel(simd_level level) {
+#ifdef PG_SCAN_X86
+#if defined(__x86_64__)
+    if (level == simd_level::avx2 && __builtin_cpu_supports("avx2") && __builtin_cpu_supports("pclmul"))
+        return index_avx2;
+#endif
+    if (level != simd_level::scalar)
+        return index_sse2;
+#else
+    (void)level;
+#endif
+    return index_scalar;
+}
+
+}   // namespace csv_scan
+
+/* Fields of one row; views into the reader's buffer (or the row's own unescape buffer) */
+class csv_row {
+public:
+    std::size_t size() const { return fields_.size(); }
+    bool empty() const { return fields_.empty(); }
+    std::string_view operator[](std::size_t i) const { return fields_[i]; }
+    const std::string_view *begin() const { return fields_.data(); }
+    const std::string_view *end() const { return fields_.data() + fields_.size(); }
+
+    std::size_t number() const { return number_; }     // 1-based row number (header included)
+
+    /* Typed field, as record_parser.h parses it */
+    template <typename T>
+    parse_errc get(std::size_t i, T &value) const {
+        if (i >= fields_.size())
+            return parse_errc::missing_field;
+        return parse_field(fields_[i], value);
+    }
+
+private:
+    friend class csv_reader;
+
+    struct escaped_field {
+        std::size_t index;
+        std::size_t offset;
+        std::size_t size;
+    };
+
+    void clear() {
+        fields_.clear();
+        scratch_.clear();
+        escaped_.clear();
+    }
+
+    std::vector<std::string_view> fields_ {};
+    std::string scratch_ {};                    // unescaped "" fields; may move while the row grows
+    std::vector<escaped_field> escaped_ {};
+    std::size_t number_ {0};
+};
+
+class csv_reader {
+public:
+    /* Open a file by path; "-" reads from stdin */
+    explicit csv_reader(const std::string &path, const csv_options &options = {}) : options_ {options} {
+        if (path == "-") {
+            fd_ = STDIN_FILENO;
+            owns_fd_ = false;
+        } else {
+            fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            owns_fd_ = true;
+        }
+        init();
+    }
+
+    /* Read from an already open descriptor (not closed by the reader) */
+    explicit csv_reader(int fd, const csv_options &options = {})
+        : options_ {options}, fd_ {fd}, owns_fd_ {false} {
+        init();
+    }
+
+    /* Tokenize text already in memory (not copied; it must outlive the reader) */
+    static csv_reader from_text(std::string_view text, const csv_options &options = {}) {
+        return csv_reader {text_input {}, text, options};
+    }
+
+    csv_reader(const csv_reader &) = delete;
+    csv_reader &operator=(const csv_reader &) = delete;
+
+    ~csv_reader() { close(); }
+
+    bool is_open() const { return in_memory_ || fd_ >= 0; }
+    explicit operator bool() const { return is_open() && error_ == csv_errc::ok; }
+
+    csv_errc error() const { return error_; }
+    std::size_t error_row() const { return error_row_; }        // 1-based
+    std::size_t error_field() const { return error_field_; }    // 0-based
+    std::size_t rows() const { return rows_; }                  // rows returned so far
+
+    /* Get the next row; false at end of input or on an error */
+    bool next(csv_row &row) {
+        row.clear();
+        if (done_ || !*this)
+            return false;
+        std::size_t field_start {row_start_};
+        for (;;) {
+            while (pos_index_ < pos_count_) {
+                std::size_t p {positions_[pos_index_++]};
+                if (base_[p] == '\n') {
+                    if (!finish_row(row, field_start, p))
+                        return false;
+                    row_start_ = p + 1;
+                    return true;
+                }
+                if (!add_field(row, field_start, p))
+                    return false;
+                field_start = p + 1;
+            }
+            if (scanned_ < len_) {
+                index_strip();
+                continue;
+            }
+            if (at_end_) {
+                done_ = true;
+                if (state_.in_quote != 0)
+                    return fail(open_quote_error(field_start), row.size());
+                if (row_start_ == len_)             // nothing after the last '\n'
+                    return false;
+                if (!finish_row(row, field_start, len_))
+                    return false;
+                row_start_ = len_;
+                return true;
+            }
+            if (!refill())
+                return false;
+            row.clear();                            // the partial row moved; index it again
+            field_start = 0;
+        }
+    }
+
+    void close() {
+        if (owns_fd_ && fd_ >= 0)
+            ::close(fd_);
+        fd_ = -1;
+    }
+
+private:
+    static constexpr std::size_t max_window {std::size_t {1} << 31};   // positions are 32-bit
+
+    struct text_input {};
+
+    csv_reader(text_input, std::string_view text, const csv_options &options)
+        : options_ {options}, in_memory_ {true}, text_ {text} {
+        init();
+    }
+
+    void init() {
+        kernel_ = csv_scan::index_kernel(options_.level);
+        window_ = std::max<std::size_t>(options_.buffer_size, 64);
+        positions_.resize(csv_scan::strip_size + 64);
+    }
+
+    bool fail(csv_errc code, std::size_t field) {
+        error_ = code;
+        error_row_ = rows_ + 1;
+        error_field_ = field;
+        done_ = true;
+        return false;
+    }
+
+    void index_strip() {
+        std::size_t size {std::min(csv_scan::strip_size, len_ - scanned_)};
+        std::uint32_t *end = kernel_(base_ + scanned_, size, options_.delimiter, options_.quoting, state_,
+                                     static_cast<std::uint32_t>(scanned_), positions_.data());
+        pos_index_ = 0;
+        pos_count_ = static_cast<std::size_t>(end - positions_.data());
+        scanned_ += size;
+    }
+
+    // Input ended inside quotes: a well-formed field still waiting for its closing quote,
+    // or a stray quote (a"b, "a"b") that opened a region
+    csv_errc open_quote_error(std::size_t first) const {
+        std::string_view rest {base_ + first, len_ - first};
+        if (rest.empty() || rest.front() != '"')
+            return csv_errc::bad_quote;
+        for (std::size_t q {rest.find('"', 1)}; q != std::string_view::npos; q = rest.find('"', q + 2))
+            if (q + 1 >= rest.size() || rest[q + 1] != '"')
+                return csv_errc::bad_quote;
+        return csv_errc::unterminated_quote;
+    }
+
+    bool add_field(csv_row &row, std::size_t first, std::size_t last) {
+        std::string_view raw {base_ + first, last - first};
+        if (!state_.saw_quote) {                    // no quote in this window yet: nothing to check
+            row.fields_.push_back(raw);
+            return true;
+        }
+        if (raw.empty() || raw.front() != '"') {
+            if (raw.find('"') != std::string_view::npos)
+                return fail(csv_errc::bad_quote, row.size());
+            row.fields_.push_back(raw);
+            return true;
+        }
+        if (raw.size() < 2 || raw.back() != '"')
+            return fail(csv_errc::bad_quote, row.size());
+        std::string_view inner {raw.substr(1, raw.size() - 2)};
+        std::size_t q {inner.find('"')};
+        if (q == std::string_view::npos) {
+            row.fields_.push_back(inner);
+            return true;
+        }
+        // "" -> ", into the row's buffer; the views are set once the row is complete
+        std::size_t offset {row.scratch_.size()};
+        std::size_t from {0};
+        while (q != std::string_view::npos) {
+            if (q + 1 >= inner.size() || inner[q + 1] != '"')
+                return fail(csv_errc::bad_quote, row.size());
+            row.scratch_.append(inner.data() + from, q + 1 - from);
+            from = q + 2;
+            q = inner.find('"', from);
+        }
+        row.scratch_.append(inner.data() + from, inner.size() - from);
+        row.escaped_.push_back({row.fields_.size(), offset, row.scratch_.size() - offset});
+        row.fields_.emplace_back();
+        return true;
+    }
+
+    bool finish_row(csv_row &row, std::size_t first, std::size_t last) {
+        if (last > first && base_[last - 1] == '\r')
+            --last;
+        if (!add_field(row, first, last))
+            return false;
+        for (const csv_row::escaped_field &e : row.escaped_)
+            row.fields_[e.index] = std::string_view {row.scratch_.data() + e.offset, e.size};
+        row.number_ = ++rows_;
+        return true;
+    }
+
+    // Move the pending partial row to the front, grow if one row fills the window, then read()
+    bool refill() {
+        if (row_start_ == 0 && len_ == window_) {
+            if (window_ >= max_window)
+                return fail(csv_errc::row_too_long, 0);
+            window_ *= 2;
+        }
+        if (in_memory_) {
+            text_pos_ += row_start_;
+            len_ = std::min(window_, text_.size() - text_pos_);
+            base_ = text_.data() + text_pos_;
+            at_end_ = text_pos_ + len_ == text_.size();
+        } else {
+            std::size_t keep {len_ - row_start_};
+            if (keep > 0)
+                std::memmove(buffer_.data(), buffer_.data() + row_start_, keep);
+            if (buffer_.size() < window_)
+                buffer_.resize(window_);
+            len_ = keep;
+            while (len_ < window_) {
+                ssize_t n = ::read(fd_, buffer_.data() + len_, window_ - len_);
+                if (n > 0) {
+                    len_ += static_cast<std::size_t>(n);
+                    continue;
+                }
+                if (n < 0 && errno == EINTR)
+                    continue;
+                if (n < 0)
+                    return fail(csv_errc::read_failed, 0);
+                at_end_ = true;
+                break;
+            }
+            base_ = buffer_.data();
+        }
+        row_start_ = 0;
+        scanned_ = 0;
+        state_ = {};                                // a row never starts inside quotes
+        pos_index_ = 0;
+        pos_count_ = 0;
+        return true;
+    }
+
+    csv_options options_ {};
+    csv_scan::index_fn kernel_ {nullptr};
+    int fd_ {-1};
+    bool owns_fd_ {false};
+    bool in_memory_ {false};
+    std::string_view text_ {};
+    std::size_t text_pos_ {0};                      // window start in text_
+
+    // window: [base_, base_ + len_), starting at a row boundary
+    std::vector<char> buffer_ {};
+    const char *base_ {nullptr};
+    std::size_t window_ {0};
+    std::size_t len_ {0};
+    std::size_t row_start_ {0};
+    std::size_t scanned_ {0};
+    bool at_end_ {false};
+    bool done_ {false};
+
+    // stage 1 output for the current strip
+    csv_scan::scan_state state_ {};
+    std::vector<std::uint32_t> positions_ {};
+    std::size_t pos_index_ {0};
+    std::size_t pos_count_ {0};
+
+    std::size_t rows_ {0};
+    csv_errc error_ {csv_errc::ok};
+    std::size_t error_row_ {0};
+    std::size_t error_field_ {0};
+};
+
+/* Type inference and columnar buffers */
+enum class column_type { empty, boolean, integer, floating, text };   // narrowest first
+
+inline const char *to_string(column_type type) {
+    switch (type) {
+    case column_type::empty: return "empty";
+    case column_type::boolean: return "boolean";
+    case column_type::integer: return "integer";
+    case column_type::floating: return "floating";
+    case column_type::text: return "text";
+    }
+    return "?";
+}
+
+inline column_type infer_type(std::string_view field) {
+    if (field.empty())
+        return column_type::empty;
+    if (field == "true" || field == "false")
+        return column_type::boolean;
+    std::int64_t i {};
+    if (parse_field(field, i) == parse_errc::ok)
+        return column_type::integer;
+    double d {};
+    if (parse_field(field, d) == parse_errc::ok)
+        return column_type::floating;
+    return column_type::text;
+}
+
+/* Narrowest type holding both */
+inline column_type merge(column_type a, column_type b) {
+    if (a == b || b == column_type::empty)
+        return a;
+    if (a == column_type::empty)
+        return b;
+    if ((a == column_type::integer && b == column_type::floating) ||
+        (a == column_type::floating && b == column_type::integer))
+        return column_type::floating;
+    return column_type::text;
+}
+
+/* One column; only the vector of its type is filled. valid[i] == 0 for empty, missing or mismatched fields */
+struct csv_column {
+    std::string name {};
+    column_type type {column_type::empty};
+    std::vector<std::uint8_t> booleans {};
+    std::vector<std::int64_t> integers {};
+    std::vector<double> floats {};
+    std::string text_data {};                       // text column: every value back to back
+    std::vector<std::size_t> text_offsets {0};      // value i is [text_offsets[i], text_offsets[i + 1])
+    std::vector<std::uint8_t> valid {};
+    std::size_t mismatches {0};
+
+    std::size_t size() const { return valid.size(); }
+
+    std::string_view text(std::size_t i) const {
+        return {text_data.data() + text_offsets[i], text_offsets[i + 1] - text_offsets[i]};
+    }
+
+    void append(std::string_view field) {
+        bool ok {!field.empty()};
+        switch (type) {
+        case column_type::empty:
+            break;
+        case column_type::boolean: {
+            bool b {field == "true"};
+            ok = ok && (b || field == "false");
+            booleans.push_back(b);
+            break;
+        }
+        case column_type::integer: {
+            std::int64_t i {};
+            ok = ok && parse_field(field, i) == parse_errc::ok;
+            integers.push_back(ok ? i : 0);
+            break;
+        }
+        case column_type::floating: {
+            double d {};
+            ok = ok && parse_field(field, d) == parse_errc::ok;
+            floats.push_back(ok ? d : 0.0);
+            break;
+        }
+        case column_type::text:
+            text_data.append(field.data(), field.size());
+            text_offsets.push_back(text_data.size());
+            break;
+        }
+        if (!ok && !field.empty())
+            ++mismatches;
+        valid.push_back(ok);
+    }
+};
+
+struct column_options {
+    bool header {true};             // first row names the columns
+    std::size_t infer_rows {0};     // rows read to infer the types; 0: all of them
+};
+
+struct csv_table {
+    std::vector<csv_column> columns {};
+    std::size_t rows {0};           // data rows (header excluded)
+    csv_errc error {csv_errc::ok};
+    std::size_t error_row {0};
+    bool opened {true};
+
+    explicit operator bool() const { return opened && error == csv_errc::ok; }
+
+    const csv_column *find(std::string_view name) const {
+        for (const csv_column &c : columns)
+            if (c.name == name)
+                return &c;
+        return nullptr;
+    }
+};
+
+namespace csv_detail {
+
+// open() returns a fresh csv_reader over the same input for each pass
+template <typename Open>
+csv_table read_columns(Open open, const column_options &co) {
+    csv_table table {};
+    csv_row row {};
+
+    /* Pass 1: names, column count and types */
+    std::vector<column_type> types {};
+    std::vector<std::string> names {};
+    {
+        csv_reader reader = open();
+        if (!reader) {
+            table.opened = reader.is_open();
+            table.error = reader.error();
+            return table;
+        }
+        if (co.header && reader.next(row))
+            for (std::string_view field : row)
+                names.emplace_back(field);
+        std::size_t inferred {0};
+        while ((co.infer_rows == 0 || inferred < co.infer_rows) && reader.next(row)) {
+            if (types.size() < row.size())
+                types.resize(row.size(), column_type::empty);
+            for (std::size_t i {0}; i < row.size(); ++i)
+                if (types[i] != column_type::text)
+                    types[i] = merge(types[i], infer_type(row[i]));
+            ++inferred;
+        }
+        if (reader.error() != csv_errc::ok) {
+            table.error = reader.error();
+            table.error_row = reader.error_row();
+            return table;
+        }
+    }
+    if (types.size() < names.size())
+        types.resize(names.size(), column_type::empty);
+    table.columns.resize(types.size());
+    for (std::size_t i {0}; i < types.size(); ++i) {
+        table.columns[i].type = types[i];
+        table.columns[i].name = i < names.size() ? names[i] : "column_" + std::to_string(i);
+    }
+
+    /* Pass 2: values (fields past the inferred columns are dropped) */
+    csv_reader reader = open();
+    if (!reader) {
+        table.opened = reader.is_open();
+        return table;
+    }
+    if (co.header)
+        reader.next(row);
+    while (reader.next(row)) {
+        for (std::size_t i {0}; i < table.columns.size(); ++i)
+            table.columns[i].append(i < row.size() ? row[i] : std::string_view {});
+        ++table.rows;
+    }
+    table.error = reader.error();
+    table.error_row = reader.error_row();
+    return table;
+}
+
+// The rest of fd, appended to text; false on a read error
+inline bool read_all(int fd, std::string &text) {
+    char chunk[64 * 1024];
+    for (;;) {
+        ssize_t n = ::read(fd, chunk, sizeof chunk);
+        if (n > 0)
+            text.append(chunk, static_cast<std::size_t>(n));
+        else if (n == 0)
+            return true;
+        else if (errno != EINTR)
+            return false;
+    }
+}
+
+}   // namespace csv_detail
+
+inline csv_table read_csv_columns(const std::string &path, const csv_options &options = {},
+                                  const column_options &co = {}) {
+    struct stat st {};
+    bool stdin_input {path == "-"};
+    if (!stdin_input && (::stat(path.c_str(), &st) != 0 || S_ISREG(st.st_mode)))
+        return csv_detail::read_columns([&] { return csv_reader {path, options}; }, co);
+
+    /* One pass only: read it all, then both passes run over memory */
+    csv_table table {};
+    int fd = stdin_input ? STDIN_FILENO : ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        table.opened = false;
+        return table;
+    }
+    std::string text {};
+    bool read_ok = csv_detail::read_all(fd, text);
+    if (!stdin_input)
+        ::close(fd);
+    if (!read_ok) {
+        table.error = csv_errc::read_failed;
+        return table;
+    }
+    return csv_detail::read_columns([&] { return csv_reader::from_text(text, options); }, co);
+}
+
+inline csv_table read_csv_text_columns(std::string_view text, const csv_options &options = {},
+                                       const column_options &co = {}) {
+    return csv_detail::read_columns([&] { return csv_reader::from_text(text, options); }, co);
+}
+
+}   // namespace pg
+
+#endif  // PG_CSV_TOKENIZER_H
@@ -0,0 +1,473 @@
+/**
+@file csv_tokenizer_example.cpp
+
+@brief
+    Tokenizing CSV with csv_tokenizer.h: RFC 4180 cases, a randomized check against a
+    byte-at-a-time reference, columnar type inference, and a benchmark against the
+    getline + std::istringstream path of file_input_output.cpp on a generated 1 GB file.
+
+@par
+    Usage:
+        csv_tokenizer_example            -> 1 GB benchmark file
+        csv_tokenizer_example --small    -> 16 MB benchmark file
+        csv_tokenizer_example --mb 256   -> 256 MB benchmark file
+    Checks (every kernel level, window sizes from 64 bytes up, in memory and from a file):
+        1. Quoted delimiters and newlines, "" escapes, CRLF, empty fields and lines,
+           no trailing '\n', bad and unterminated quotes, TSV, other delimiters
+        2. Random quoted/unquoted CSV against a reference state machine
+        3. read_csv_text_columns: inferred types, null fields, infer_rows mismatches;
+           read_csv_columns on a FIFO (one pass only) gets every row
+    Benchmarked (rows, fields, field bytes and the sum of the total column must agree):
+        1. std::getline + std::istringstream + std::getline(iss, field, ',') + std::stod
+        2. pg::csv_reader with the scalar, sse2 and avx2 kernels + csv_row::get
+        3. pg::read_csv_columns (two passes: inference, then typed columns)
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <sys/stat.h>
+
+#include "csv_tokenizer.h"
+
+using rows_t = std::vector<std::vector<std::string>>;
+
+struct parsed {
+    rows_t rows {};
+    pg::csv_errc error {pg::csv_errc::ok};
+    bool operator==(const parsed &o) const { return rows == o.rows && error == o.error; }
+};
+
+/* Byte-at-a-time RFC 4180 state machine, the reference for every kernel (no rows on an error) */
+static parsed reference_parse(const std::string &text, char delim = ',') {
+    parsed out {};
+    std::vector<std::string> row {};
+    std::string field {};
+    enum { field_start, unquoted, quoted, quote_in_quoted, after_quote } state {field_start};
+    auto end_row = [&] {
+        if (!field.empty() && field.back() == '\r' && state != after_quote)
+            field.pop_back();
+        row.push_back(field);
+        out.rows.push_back(row);
+        row.clear();
+        field.clear();
+        state = field_start;
+    };
+    for (std::size_t i {0}; i < text.size(); ++i) {
+        char c {text[i]};
+        switch (state) {
+        case field_start:
+        case unquoted:
+            if (c == '"') {
+                if (state == unquoted)
+                    return parsed {{}, pg::csv_errc::bad_quote};
+                state = quoted;
+            } else if (c == delim) {
+                row.push_back(field);
+                field.clear();
+                state = field_start;
+            } else if (c == '\n') {
+                end_row();
+            } else {
+                field += c;
+                state = unquoted;
+            }
+            break;
+        case quoted:
+            if (c == '"')
+                state = quote_in_quoted;
+            else
+                field += c;
+            break;
+        case quote_in_quoted:                           // "" or the closing quote
+            if (c == '"') {
+                field += '"';
+                state = quoted;
+                break;
+            }
+            state = after_quote;
+            [[fallthrough]];
+        case after_quote:
+            if (c == delim) {
+                row.push_back(field);
+                field.clear();
+                state = field_start;
+            } else if (c == '\n') {
+                end_row();
+            } else if (c == '\r' && (i + 1 == text.size() || text[i + 1] == '\n')) {
+                // CRLF (or a last '\r') after a closing quote
+            } else {
+                return parsed {{}, pg::csv_errc::bad_quote};
+            }
+            break;
+        }
+    }
+    if (state == quoted)
+        return parsed {{}, pg::csv_errc::unterminated_quote};
+    if (state != field_start || !row.empty() || (!text.empty() && text.back() != '\n'))
+        end_row();
+    return out;
+}
+
+static parsed tokenize(pg::csv_reader &reader) {
+    parsed out {};
+    pg::csv_row row {};
+    while (reader.next(row))
+        out.rows.emplace_back(row.begin(), row.end());
+    out.error = reader.error();
+    if (out.error != pg::csv_errc::ok)
+        out.rows.clear();                           // the reference stops at the first error
+    return out;
+}
+
+/* Same rows from every kernel, window size and input kind; malformed input only has to fail
+   (a stray quote may show up as bad_quote or, when no quote follows, unterminated_quote) */
+static bool same(const parsed &got, const parsed &expected, bool exact_error) {
+    if (expected.error != pg::csv_errc::ok && !exact_error)
+        return got.error != pg::csv_errc::ok;
+    return got == expected;
+}
+
+static bool check_all(const std::string &text, const pg::csv_options &base, const parsed &expected,
+                      bool exact_error = true) {
+    static int file_id {0};
+    std::string path {"csv_case_" + std::to_string(file_id++) + ".csv"};
+    {
+        std::ofstream out_file {path, std::ios::binary};
+        out_file << text;
+    }
+    bool ok {true};
+    for (pg::simd_level level : {pg::simd_level::scalar, pg::simd_level::sse2, pg::simd_level::avx2}) {
+        for (std::size_t window : {std::size_t {64}, std::size_t {100}, std::size_t {4096}, std::size_t {1} << 20}) {
+            pg::csv_options options {base};
+            options.level = level;
+            options.buffer_size = window;
+            pg::csv_reader memory = pg::csv_reader::from_text(text, options);
+            pg::csv_reader file {path, options};
+            if (!file) {
+                std::cerr << "File open error" << std::endl;
+                ok = false;
+                continue;
+            }
+            ok = ok && same(tokenize(memory), expected, exact_error) && same(tokenize(file), expected, exact_error);
+        }
+    }
+    std::remove(path.c_str());
+    return ok;
+}
+
+static bool rfc4180_cases() {
+    using e = pg::csv_errc;
+    pg::csv_options csv {};
+    pg::csv_options tsv {pg::csv_options::tsv()};
+    pg::csv_options semicolon {};
+    semicolon.delimiter = ';';
+    std::string long_field(300, 'x');
+    for (std::size_t i {0}; i < long_field.size(); i += 7)
+        long_field[i] = i % 3 == 0 ? ',' : (i % 3 == 1 ? '\n' : ' ');
+    std::string long_quoted {'"' + long_field + "\"\"" + long_field + '"'};
+    struct test_case {
+        const char *name;
+        std::string text;
+        pg::csv_options options;
+        parsed expected;
+    };
+    std::vector<test_case> cases {
+        {"plain", "a,b,c\n1,2,3\n", csv, {{{"a", "b", "c"}, {"1", "2", "3"}}, e::ok}},
+        {"quoted", "\"a,b\",\"c\"\"d\",e\r\n\"multi\nline\",,\"\"\n", csv,
+         {{{"a,b", "c\"d", "e"}, {"multi\nline", "", ""}}, e::ok}},
+        {"no trailing newline", "x,y", csv, {{{"x", "y"}}, e::ok}},
+        {"empty lines", "a\n\nb\r\n\r\n", csv, {{{"a"}, {""}, {"b"}, {""}}, e::ok}},
+        {"empty input", "", csv, {{}, e::ok}},
+        {"spaces kept", " a , b \n", csv, {{{" a ", " b "}}, e::ok}},
+        {"unterminated", "a,b\nc,\"de\n", csv, {{}, e::unterminated_quote}},
+        {"quote in field", "ab\"c,d\"\n", csv, {{}, e::bad_quote}},
+        {"text after quote", "\"ab\"x,1\n", csv, {{}, e::bad_quote}},
+        {"lone quote", "a,\"b\"c\"\n", csv, {{}, e::bad_quote}},
+        {"tsv", "a\t\"b\tc\n1\t2\t3", tsv, {{{"a", "\"b", "c"}, {"1", "2", "3"}}, e::ok}},
+        {"semicolon", "a;\"b;c\";d,e\n", semicolon, {{{"a", "b;c", "d,e"}}, e::ok}},
+        {"long rows", "id," + long_quoted + ",end\n2," + long_quoted + "\n", csv,
+         {{{"id", long_field + '"' + long_field, "end"}, {"2", long_field + '"' + long_field}}, e::ok}},
+    };
+    bool all_ok {true};
+    for (const test_case &c : cases) {
+        bool ok = check_all(c.text, c.options, c.expected);
+        if (c.options.quoting && c.options.delimiter == ',')
+            ok = ok && reference_parse(c.text) == c.expected;
+        std::cout << "  " << std::left << std::setw(22) << c.name << std::boolalpha << ok << std::endl;
+        all_ok = all_ok && ok;
+    }
+    return all_ok;
+}
+
+/* Random fields: plain, quoted with delimiters/newlines/"" escapes, empty; CRLF or LF rows */
+static bool random_cases() {
+    std::mt19937 rng {2026};
+    const char alphabet[] {"ab ,\n\"\r1"};
+    bool all_ok {true};
+    for (int round {0}; round < 20; ++round) {
+        std::string text {};
+        bool well_formed {round % 4 != 3};          // every 4th input gets stray bytes anywhere
+        for (int r {0}; r < 200; ++r) {
+            int fields = 1 + static_cast<int>(rng() % 6);
+            for (int f {0}; f < fields; ++f) {
+                if (f > 0)
+                    text += ',';
+                int kind = static_cast<int>(rng() % 3);
+                int length = static_cast<int>(rng() % (rng() % 8 == 0 ? 200 : 12));
+                if (kind == 0) {
+                    for (int i {0}; i < length; ++i)
+                        text += "ab1 x"[rng() % 5];
+                } else if (kind == 1) {
+                    text += '"';
+                    for (int i {0}; i < length; ++i) {
+                        char c {alphabet[rng() % (sizeof alphabet - 1)]};
+                        text += c == '"' ? std::string {"\"\""} : std::string {c};
+                    }
+                    text += '"';
+                }
+                if (!well_formed && rng() % 50 == 0)
+                    text += alphabet[rng() % (sizeof alphabet - 1)];
+            }
+            text += rng() % 4 == 0 ? "\r\n" : "\n";
+        }
+        if (round % 2 == 1)
+            text.pop_back();                        // no trailing '\n'
+        bool ok = check_all(text, pg::csv_options {}, reference_parse(text), false);
+        all_ok = all_ok && ok;
+    }
+    std::cout << "  " << std::left << std::setw(22) << "random vs reference" << std::boolalpha << all_ok << std::endl;
+    return all_ok;
+}
+
+static bool column_cases() {
+    const std::string text {"id,name,total,flag,note\n"
+                            "1,a,1.5,true,\n"
+                            "2,\"b,c\",2,false,\n"
+                            "3,,,true,\n"
+                            "4,d,7,maybe,\n"};
+    pg::csv_table all = pg::read_csv_text_columns(text);
+    const pg::csv_column *id = all.find("id");
+    const pg::csv_column *name = all.find("name");
+    const pg::csv_column *total = all.find("total");
+    const pg::csv_column *flag = all.find("flag");
+    const pg::csv_column *note = all.find("note");
+    bool ok = all && all.rows == 4 && all.columns.size() == 5 && id && name && total && flag && note &&
+              id->type == pg::column_type::integer && id->integers == std::vector<std::int64_t> {1, 2, 3, 4} &&
+              name->type == pg::column_type::text && name->text(1) == "b,c" &&
+              name->valid == std::vector<std::uint8_t> {1, 1, 0, 1} &&
+              total->type == pg::column_type::floating && total->floats[0] == 1.5 && total->floats[3] == 7.0 &&
+              total->valid == std::vector<std::uint8_t> {1, 1, 0, 1} &&
+              flag->type == pg::column_type::text && note->type == pg::column_type::empty &&
+              note->valid == std::vector<std::uint8_t> {0, 0, 0, 0};
+
+    /* Types from the first 3 rows: "maybe" doesn't fit the boolean column */
+    pg::column_options first_three {};
+    first_three.infer_rows = 3;
+    pg::csv_table sampled = pg::read_csv_text_columns(text, pg::csv_options {}, first_three);
+    const pg::csv_column *sampled_flag = sampled.find("flag");
+    ok = ok && sampled && sampled_flag && sampled_flag->type == pg::column_type::boolean &&
+         sampled_flag->booleans == std::vector<std::uint8_t> {1, 0, 1, 0} && sampled_flag->mismatches == 1 &&
+         sampled_flag->valid == std::vector<std::uint8_t> {1, 1, 1, 0};
+
+    /* No header: columns are named column_0.. */
+    pg::column_options no_header {};
+    no_header.header = false;
+    pg::csv_table unnamed = pg::read_csv_text_columns("1,x\n2,y\n", pg::csv_options {}, no_header);
+    ok = ok && unnamed && unnamed.rows == 2 && unnamed.find("column_0") &&
+         unnamed.find("column_0")->type == pg::column_type::integer;
+
+    pg::csv_table broken = pg::read_csv_text_columns("a,b\n1,\"2\n");
+    ok = ok && !broken && broken.error == pg::csv_errc::unterminated_quote;
+
+    /* A FIFO can't be read twice: the rows must still all arrive */
+    const std::string fifo {"csv_columns.fifo"};
+    std::remove(fifo.c_str());
+    if (::mkfifo(fifo.c_str(), 0600) == 0) {
+        std::thread writer {[&] {
+            std::ofstream out_file {fifo, std::ios::binary};
+            out_file << text;
+        }};
+        pg::csv_table piped = pg::read_csv_columns(fifo);
+        writer.join();
+        ok = ok && piped && piped.rows == 4 && piped.find("id") &&
+             piped.find("id")->integers == id->integers;
+        std::remove(fifo.c_str());
+    }
+
+    for (const pg::csv_column &c : all.columns)
+        std::cout << "  column " << std::left << std::setw(6) << c.name << pg::to_string(c.type) << std::endl;
+    std::cout << "  " << std::left << std::setw(22) << "columns" << std::boolalpha << ok << std::endl;
+    return ok;
+}
+
+/* Benchmark file: id,name,num,total,flag,comment rows up to `size` bytes */
+static bool make_bench_file(const std::string &path, std::size_t size) {
+    std::ofstream out_file {path, std::ios::binary};
+    if (!out_file)
+        return false;
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    std::string buffer {"id,name,num,total,flag,comment\n"};
+    std::size_t written {0};
+    for (std::size_t i {0}; written + buffer.size() < size; ++i) {
+        buffer += std::to_string(i);
+        buffer += ',';
+        buffer += names[i % 4];
+        buffer += ',';
+        buffer += std::to_string(i % 1000);
+        buffer += ',';
+        buffer += std::to_string(i % 4096 / 4);
+        buffer += '.';
+        buffer += "0257"[i % 4];
+        buffer += "05"[i % 4 / 2];
+        buffer += i % 3 == 0 ? ",true," : ",false,";
+        buffer += "row of the benchmark file\n";
+        if (buffer.size() > (1u << 20)) {
+            out_file << buffer;
+            written += buffer.size();
+            buffer.clear();
+        }
+    }
+    out_file << buffer;
+    return static_cast<bool>(out_file);
+}
+
+struct totals {
+    std::size_t rows {0};
+    std::size_t fields {0};
+    std::size_t bytes {0};
+    double sum {0.0};
+    bool operator==(const totals &o) const {
+        return rows == o.rows && fields == o.fields && bytes == o.bytes && sum == o.sum;
+    }
+};
+
+/* The file_input_output.cpp way: a line, a std::istringstream, getline per field */
+static totals istringstream_path(const std::string &path) {
+    totals t {};
+    std::ifstream in_file {path};
+    std::string line {};
+    std::string field {};
+    std::getline(in_file, line);                    // header
+    while (std::getline(in_file, line)) {
+        std::istringstream iss {line};
+        std::size_t column {0};
+        while (std::getline(iss, field, ',')) {
+            ++t.fields;
+            t.bytes += field.size();
+            if (column++ == 3)
+                t.sum += std::stod(field);
+        }
+        ++t.rows;
+    }
+    return t;
+}
+
+static totals csv_reader_path(const std::string &path, pg::simd_level level) {
+    totals t {};
+    pg::csv_options options {};
+    options.level = level;
+    pg::csv_reader reader {path, options};
+    pg::csv_row row {};
+    reader.next(row);                               // header
+    while (reader.next(row)) {
+        for (std::string_view field : row)
+            t.bytes += field.size();
+        t.fields += row.size();
+        double total {};
+        if (row.get(3, total) == pg::parse_errc::ok)
+            t.sum += total;
+        ++t.rows;
+    }
+    if (reader.error() != pg::csv_errc::ok)
+        t.rows = 0;
+    return t;
+}
+
+static totals columns_path(const std::string &path) {
+    totals t {};
+    pg::csv_table table = pg::read_csv_columns(path);
+    const pg::csv_column *total = table.find("total");
+    if (!table || total == nullptr || total->type != pg::column_type::floating)
+        return t;
+    t.rows = table.rows;
+    for (double v : total->floats)
+        t.sum += v;
+    return t;
+}
+
+template <typename Body>
+static totals timed(const char *label, std::size_t bytes, Body body) {
+    auto start = std::chrono::steady_clock::now();
+    totals t = body();
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "  " << std::left << std::setw(30) << label << std::right << std::setw(10) << t.rows << " rows"
+              << std::setw(10) << std::fixed << std::setprecision(1) << double(bytes) / s / 1e6 << " MB/s"
+              << std::endl;
+    return t;
+}
+
+int main(int argc, char *argv[]) {
+    std::size_t megabytes {1024};
+    for (int i {1}; i < argc; ++i) {
+        std::string arg {argv[i]};
+        if (arg == "--small")
+            megabytes = 16;
+        else if (arg == "--mb" && i + 1 < argc)
+            megabytes = std::stoul(argv[++i]);
+    }
+    std::cout << "detected kernel: " << pg::to_string(pg::detected_simd_level()) << std::endl;
+
+    std::cout << "RFC 4180 cases:" << std::endl;
+    bool cases_ok = rfc4180_cases();
+    bool random_ok = random_cases();
+    bool columns_ok = column_cases();
+
+    const std::string path {"csv_bench.csv"};
+    std::size_t size {megabytes << 20};
+    if (!make_bench_file(path, size)) {
+        std::cerr << "File create error" << std::endl;
+        return 1;
+    }
+    {
+        pg::csv_reader warm_up {path};              // page cache
+        pg::csv_row row {};
+        while (warm_up.next(row)) {
+        }
+    }
+    std::cout << "\n" << megabytes << " MB file:" << std::endl;
+    totals expected = timed("getline + istringstream", size, [&] { return istringstream_path(path); });
+    bool bench_ok {expected.rows > 0};
+    for (pg::simd_level level : {pg::simd_level::scalar, pg::simd_level::sse2, pg::simd_level::avx2}) {
+        std::string label {std::string {"csv_reader "} + pg::to_string(level)};
+        totals got = timed(label.c_str(), size, [&] { return csv_reader_path(path, level); });
+        bench_ok = bench_ok && got == expected;
+    }
+    totals columns = timed("read_csv_columns", size, [&] { return columns_path(path); });
+    bench_ok = bench_ok && columns.rows == expected.rows && columns.sum == expected.sum;
+    std::remove(path.c_str());
+
+    bool all_ok = cases_ok && random_ok && columns_ok && bench_ok;
+    std::cout << "\nbenchmark results agree: " << std::boolalpha << bench_ok << "\n"
+              << "results match: " << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
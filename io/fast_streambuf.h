@@ -0,0 +1,461 @@
+/**
+@file fast_streambuf.h
+
+@brief
+    Drop-in stream buffers for existing iostream code
+        std::ifstream in_file {path};     ===>  pg::fast_ifstream in_file {path};
+        std::ofstream out_file {path};    ===>  pg::fast_ofstream out_file {path};
+        std::istringstream iss {info};    ===>  pg::memory_istream iss {info};
+        std::ostringstream oss {};        ===>  pg::memory_ostream oss {};
+    The <<, >>, getline and get/put loops stay as they are; only the construction changes.
+
+@par
+    fast_filebuf (fd_streambuf.h, opened by path):
+        * One large buffer (filebuf_options::buffer_size, 1 MiB by default) instead of the
+          stock filebuf's BUFSIZ-sized one: fewer read()/write() calls per MB.
+        * Input is mmapped (input_mode::automatic, files of mmap_threshold or more): the get
+          area is the whole mapping, so there is no read() and no copy into a buffer at all.
+        * access_hint -> posix_fadvise (read path) or madvise (mapped path) on open.
+        * direct -> O_DIRECT with a page-aligned buffer: transfers skip the page cache (large
+          one-pass files that shouldn't evict everything else). Filesystems that refuse
+          O_DIRECT (tmpfs) fall back to buffered I/O; is_direct() tells which one is used.
+          Direct output writes whole blocks only; the last partial block goes out at close().
+        * flush_on_sync = false -> flush() and std::endl don't write; the buffer goes out when
+          full and at close(). Loops that end every line with std::endl stop making one
+          write() per line.
+        * Large xsputn/xsgetn (write(), read()) bypass the buffer.
+        * Reading or writing, not both: in | out fails to open (use std::fstream for that).
+        * Like any mmap reader, a mapped file truncated by another process raises SIGBUS.
+    memory_buf (std::streambuf over memory):
+        * Output grows geometrically in one std::string. view() returns the written bytes
+          without a copy, take() moves them out; str() copies, as std::stringbuf::str() does.
+          Neither view() nor str() touches the buffer, so calling them in a loop is cheap.
+        * seekp() back overwrites in place and keeps what follows, as std::stringbuf does.
+        * Input reads a std::string_view in place; std::istringstream copies its string first.
+    Usage:
+        pg::filebuf_options options {};
+        options.flush_on_sync = false;
+        pg::fast_ofstream out_file {"../copy.txt", std::ios::out, options};
+        pg::fast_ifstream in_file {"../myfile.txt"};
+        std::string line {};
+        while (std::getline(in_file, line))
+            out_file << line << std::endl;
+
+        pg::memory_ostream oss {};
+        oss << name << " " << num << " " << total;
+        std::string_view text = oss.view();
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_FAST_STREAMBUF_H
+#define PG_FAST_STREAMBUF_H
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <ios>
+#include <istream>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "fd_streambuf.h"
+
+namespace pg {
+
+enum class access_hint { normal, sequential, random, willneed, noreuse };
+enum class input_mode { automatic, read, mmap };
+
+inline const char *to_string(access_hint hint) {
+    switch (hint) {
+    case access_hint::normal: return "normal";
+    case access_hint::sequential: return "sequential";
+    case access_hint::random: return "random";
+    case access_hint::willneed: return "willneed";
+    case access_hint::noreuse: return "noreuse";
+    }
+    return "?";
+}
+
+inline const char *to_string(input_mode mode) {
+    switch (mode) {
+    case input_mode::automatic: return "automatic";
+    case input_mode::read: return "read";
+    case input_mode::mmap: return "mmap";
+    }
+    return "?";
+}
+
+struct filebuf_options {
+    std::size_t buffer_size {std::size_t {1} << 20};        // rounded up to direct_alignment
+    access_hint hint {access_hint::sequential};
+    input_mode input {input_mode::automatic};
+    std::size_t mmap_threshold {std::size_t {1} << 20};     // automatic: map files at least this big
+    bool direct {false};                                    // O_DIRECT (never mapped)
+    bool flush_on_sync {true};                              // false: flush()/std::endl don't write
+};
+
+namespace detail {
+
+inline int fadvise_flag(access_hint hint) {
+    switch (hint) {
+    case access_hint::normal: return POSIX_FADV_NORMAL;
+    case access_hint::sequential: return POSIX_FADV_SEQUENTIAL;
+    case access_hint::random: return POSIX_FADV_RANDOM;
+    case access_hint::willneed: return POSIX_FADV_WILLNEED;
+    case access_hint::noreuse: return POSIX_FADV_NOREUSE;
+    }
+    return POSIX_FADV_NORMAL;
+}
+
+inline int madvise_flag(access_hint hint) {
+    switch (hint) {
+    case access_hint::sequential: return MADV_SEQUENTIAL;
+    case access_hint::random: return MADV_RANDOM;
+    case access_hint::willneed: return MADV_WILLNEED;
+    default: return MADV_NORMAL;
+    }
+}
+
+}   // namespace detail
+
+/* fd_streambuf opened by path, with mmap input, O_DIRECT and access hints; for fast_ifstream and fast_ofstream */
+class fast_filebuf : public fd_streambuf {
+public:
+    fast_filebuf() = default;
+
+    ~fast_filebuf() override { close(); }
+
+    /* Like std::filebuf::open: this, or nullptr with error() set */
+    fast_filebuf *open(const std::string &path, std::ios::openmode mode, const filebuf_options &options = {}) {
+        if (is_open())
+            return nullptr;
+        options_ = options;
+        set_error(0);
+        bool in = (mode & std::ios::in) != 0;
+        bool out = (mode & (std::ios::out | std::ios::app)) != 0;
+        if (in == out) {
+            set_error(EINVAL);
+            return nullptr;
+        }
+        int flags = detail::open_flags(mode);
+        int fd {-1};
+        bool direct {false};
+#ifdef O_DIRECT
+        if (options_.direct) {
+            fd = ::open(path.c_str(), flags | O_DIRECT, 0666);
+            direct = fd >= 0;
+        }
+#endif
+        if (fd < 0)
+            fd = ::open(path.c_str(), flags, 0666);
+        if (fd < 0) {
+            set_error(errno);
+            return nullptr;
+        }
+        bool ok {};
+        if (in) {
+            ok = open_input(fd, direct);
+        } else {
+            ::posix_fadvise(fd, 0, 0, detail::fadvise_flag(options_.hint));
+            ok = attach(fd, true, mode, std::max(options_.buffer_size, direct_alignment), direct);
+        }
+        return ok ? this : nullptr;             // a failed attach has closed fd and set error()
+    }
+
+    /* Like std::filebuf::close: this, or nullptr if nothing was open or the last write failed */
+    fast_filebuf *close() {
+        if (!is_open())
+            return nullptr;
+        if (map_ != nullptr) {
+            setg(nullptr, nullptr, nullptr);
+            ::munmap(map_, map_size_);
+            map_ = nullptr;
+            map_size_ = 0;
+        }
+        return detach() ? this : nullptr;
+    }
+
+    bool is_mapped() const { return map_ != nullptr; }
+
+protected:
+    int sync() override {
+        if (!options_.flush_on_sync)
+            return 0;
+        return fd_streambuf::sync();
+    }
+
+    // The mapping is the whole get area: seeks just move gptr()
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode which) override {
+        if (map_ == nullptr)
+            return fd_streambuf::seekoff(off, dir, which);
+        off_type target = dir == std::ios_base::beg ? off
+                        : dir == std::ios_base::cur ? (gptr() - eback()) + off
+                        : off_type(map_size_) + off;
+        if (target < 0 || target > off_type(map_size_))
+            return pos_type(off_type(-1));
+        setg(map_, map_ + target, map_ + map_size_);
+        return pos_type(target);
+    }
+
+private:
+    bool open_input(int fd, bool direct) {
+        struct stat st {};
+        bool regular = ::fstat(fd, &st) == 0 && S_ISREG(st.st_mode);
+        std::size_t size = regular ? static_cast<std::size_t>(st.st_size) : 0;
+        bool map = !direct && size > 0 &&
+                   (options_.input == input_mode::mmap ||
+                    (options_.input == input_mode::automatic && size >= options_.mmap_threshold));
+        if (map) {
+            void *p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                if (!attach(fd, true, std::ios::in, 0)) {      // no buffer: the mapping is the get area
+                    ::munmap(p, size);
+                    return false;
+                }
+                map_ = static_cast<char *>(p);
+                map_size_ = size;
+                ::madvise(map_, map_size_, detail::madvise_flag(options_.hint));
+                setg(map_, map_, map_ + map_size_);     // read-only: putback of another char fails
+                return true;
+            }
+        }
+        ::posix_fadvise(fd, 0, 0, detail::fadvise_flag(options_.hint));
+        return attach(fd, true, std::ios::in, std::max(options_.buffer_size, direct_alignment), direct);
+    }
+
+    filebuf_options options_ {};
+    char *map_ {nullptr};
+    std::size_t map_size_ {0};
+};
+
+/* Growable output / in-place input streambuf, for memory_ostream and memory_istream */
+class memory_buf : public detail::put_area_streambuf {
+public:
+    memory_buf() = default;
+
+    /* Read `input` in place (not copied; it must outlive the buffer) */
+    explicit memory_buf(std::string_view input) { set_input(input); }
+
+    memory_buf(const memory_buf &) = delete;
+    memory_buf &operator=(const memory_buf &) = delete;
+
+    void set_input(std::string_view input) {
+        char *p = const_cast<char *>(input.data());     // never written: putback of another char fails
+        input_ = true;
+        setg(p, p, p + input.size());
+        setp(nullptr, nullptr);
+    }
+
+    /* Written bytes (output, up to the furthest write) or the unread input; valid until the next write */
+    std::string_view view() const {
+        if (input_)
+            return {gptr(), static_cast<std::size_t>(egptr() - gptr())};
+        return {pbase(), size()};
+    }
+
+    std::string str() const { return std::string {view()}; }   // a copy, as std::stringbuf::str()
+
+    /* Replace the output with a copy of s; writes continue after it */
+    void str(std::string_view s) {
+        reset();
+        reserve(s.size());
+        std::memcpy(storage_.data(), s.data(), s.size());
+        set_put(storage_.data(), s.size(), storage_.size());
+        high_ = s.size();
+    }
+
+    /* Written bytes, moved out; the buffer starts over empty (and without capacity) */
+    std::string take() {
+        storage_.resize(view().size());
+        std::string out {std::move(storage_)};
+        storage_ = std::string {};
+        reset();
+        return out;
+    }
+
+    /* Empty, keeping the capacity */
+    void reset() {
+        input_ = false;
+        high_ = 0;
+        setg(nullptr, nullptr, nullptr);
+        setp(storage_.data(), storage_.data() + storage_.size());
+    }
+
+    void reserve(std::size_t n) {
+        if (n > storage_.size())
+            grow(n);
+    }
+
+    std::size_t capacity() const { return storage_.size(); }
+
+protected:
+    int_type overflow(int_type c) override {
+        if (traits_type::eq_int_type(c, traits_type::eof()))
+            return traits_type::not_eof(c);
+        grow(put_offset() + 1);
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+        return c;
+    }
+
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+        if (n <= 0)
+            return 0;
+        if (epptr() - pptr() < n)
+            grow(put_offset() + static_cast<std::size_t>(n));
+        std::memcpy(pptr(), s, static_cast<std::size_t>(n));
+        set_put(storage_.data(), put_offset() + static_cast<std::size_t>(n), storage_.size());
+        return n;
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override {
+        off_type current = input_ ? gptr() - eback() : off_type(put_offset());
+        off_type end = input_ ? egptr() - eback() : off_type(size());
+        off_type target = dir == std::ios_base::beg ? off : dir == std::ios_base::cur ? current + off : end + off;
+        if (target < 0 || target > end)
+            return pos_type(off_type(-1));
+        if (input_) {
+            setg(eback(), eback() + target, egptr());
+        } else {                                        // seekp back keeps what follows
+            high_ = size();
+            set_put(storage_.data(), static_cast<std::size_t>(target), storage_.size());
+        }
+        return pos_type(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    std::size_t put_offset() const { return static_cast<std::size_t>(pptr() - pbase()); }
+    std::size_t size() const { return std::max(high_, put_offset()); }
+
+    // Capacity doubles (at least 256 bytes), so n appends cost O(n) in total
+    void grow(std::size_t needed) {
+        std::size_t used {put_offset()};
+        std::size_t capacity = std::max<std::size_t>({needed, storage_.size() * 2, 256});
+        storage_.resize(capacity);
+        setg(nullptr, nullptr, nullptr);
+        set_put(storage_.data(), used, storage_.size());
+    }
+
+    std::string storage_ {};                    // size() is the capacity; the put area covers all of it
+    std::size_t high_ {0};                      // furthest write before the last seekp back
+    bool input_ {false};
+};
+
+/* Drop-in for std::ifstream */
+class fast_ifstream : public std::istream {
+public:
+    fast_ifstream() : std::istream {nullptr} { init(&buf_); }
+
+    explicit fast_ifstream(const std::string &path, std::ios::openmode mode = std::ios::in,
+                           const filebuf_options &options = {})
+        : fast_ifstream {} {
+        open(path, mode, options);
+    }
+
+    void open(const std::string &path, std::ios::openmode mode = std::ios::in, const filebuf_options &options = {}) {
+        if (buf_.open(path, mode | std::ios::in, options) == nullptr)
+            setstate(std::ios::failbit);
+        else
+            clear();
+    }
+
+    bool is_open() const { return buf_.is_open(); }
+    void close() {
+        if (buf_.close() == nullptr)
+            setstate(std::ios::failbit);
+    }
+    int error() const { return buf_.error(); }          // errno of a failed open or read
+    fast_filebuf *rdbuf() const { return const_cast<fast_filebuf *>(&buf_); }
+
+private:
+    fast_filebuf buf_ {};
+};
+
+/* Drop-in for std::ofstream (open modes: detail::open_flags) */
+class fast_ofstream : public std::ostream {
+public:
+    fast_ofstream() : std::ostream {nullptr} { init(&buf_); }
+
+    explicit fast_ofstream(const std::string &path, std::ios::openmode mode = std::ios::out,
+                           const filebuf_options &options = {})
+        : fast_ofstream {} {
+        open(path, mode, options);
+    }
+
+    void open(const std::string &path, std::ios::openmode mode = std::ios::out, const filebuf_options &options = {}) {
+        if (buf_.open(path, (mode | std::ios::out) & ~std::ios::in, options) == nullptr)
+            setstate(std::ios::failbit);
+        else
+            clear();
+    }
+
+    bool is_open() const { return buf_.is_open(); }
+    void close() {
+        if (buf_.close() == nullptr)
+            setstate(std::ios::failbit);
+    }
+    int error() const { return buf_.error(); }
+    fast_filebuf *rdbuf() const { return const_cast<fast_filebuf *>(&buf_); }
+
+private:
+    fast_filebuf buf_ {};
+};
+
+/* Drop-in for std::istringstream that reads the text in place */
+class memory_istream : public std::istream {
+public:
+    explicit memory_istream(std::string_view text) : std::istream {nullptr}, buf_ {text} { init(&buf_); }
+    explicit memory_istream(const char *text) : memory_istream {std::string_view {text}} {}
+    memory_istream(std::string &&) = delete;            // the text must outlive the stream
+
+    void str(std::string_view text) {
+        buf_.set_input(text);
+        clear();
+    }
+    std::string_view view() const { return buf_.view(); }
+
+private:
+    memory_buf buf_;
+};
+
+/* Drop-in for std::ostringstream: view() and take() don't copy */
+class memory_ostream : public std::ostream {
+public:
+    memory_ostream() : std::ostream {nullptr} { init(&buf_); }
+
+    std::string_view view() const { return buf_.view(); }
+    std::string str() const { return buf_.str(); }
+    void str(std::string_view s) { buf_.str(s); }
+    std::string take() { return buf_.take(); }
+    void reset() { buf_.reset(); }
+    void reserve(std::size_t n) { buf_.reserve(n); }
+    std::size_t capacity() const { return buf_.capacity(); }
+
+private:
+    memory_buf buf_ {};
+};
+
+}   // namespace pg
+
+#endif  // PG_FAST_STREAMBUF_H
@@ -0,0 +1,416 @@
+/**
+@file fast_streambuf_example.cpp
+
+@brief
+    The file_input_output.cpp loops on the stock streams and on the drop-in streams of
+    fast_streambuf.h (large buffer, mmap, O_DIRECT, no flush per std::endl, in-place
+    string streams). Only the stream declarations differ between the two runs.
+
+@par
+    Usage:
+        fast_streambuf_example            -> 2,000,000-line file
+        fast_streambuf_example --small    -> 200,000 lines
+    Loops (results must match the std stream run):
+        1. Reading text file one line at a time (getline)
+        2. Reading name/num/total with >>
+        3. Copying a text file one line at a time (<< std::endl)
+        4. Copying a text file one character at a time (get/put)
+        5. Reading from a stringstream, one record per line
+        6. Writing to a stringstream, looking at the text every 100 records
+    Checks: tellg/seekg (read, mmap and O_DIRECT input), large read()/write(), unget,
+    std::ios::app, a failed open, and seekp/str() on the memory streams.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "fast_streambuf.h"
+
+/* name num total lines, as read by file_input_output.cpp */
+static bool make_test_file(const std::string &path, std::size_t lines) {
+    std::ofstream out_file {path};
+    if (!out_file)
+        return false;
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    for (std::size_t i {0}; i < lines; ++i)
+        out_file << names[i % 4] << " " << i % 1000 << " " << double(i % 4096) * 0.25 << "\n";
+    return static_cast<bool>(out_file);
+}
+
+static std::string slurp(const std::string &path) {
+    std::ifstream in_file {path, std::ios::binary};
+    std::stringstream ss {};
+    ss << in_file.rdbuf();
+    return ss.str();
+}
+
+struct totals {
+    std::size_t lines {0};
+    std::size_t bytes {0};
+    double sum {0.0};
+    bool operator==(const totals &o) const { return lines == o.lines && bytes == o.bytes && sum == o.sum; }
+};
+
+/* Reading text file one line at a time */
+template <typename In>
+static totals read_lines(In &in_file) {
+    totals t {};
+    std::string line {};
+    while (std::getline(in_file, line)) {
+        ++t.lines;
+        t.bytes += line.size();
+    }
+    return t;
+}
+
+/* Reading from files using >> */
+template <typename In>
+static totals read_fields(In &in_file) {
+    totals t {};
+    std::string name {};
+    int num {};
+    double total {};
+    while (in_file >> name >> num >> total) {
+        ++t.lines;
+        t.bytes += name.size() + static_cast<std::size_t>(num);
+        t.sum += total;
+    }
+    return t;
+}
+
+/* Copying a text file one line at a time */
+template <typename In, typename Out>
+static void copy_lines(In &in_file, Out &out_file) {
+    std::string line {};
+    while (std::getline(in_file, line))
+        out_file << line << std::endl;
+}
+
+/* Copy a text file one character at a time (get/put) */
+template <typename In, typename Out>
+static void copy_chars(In &in_file, Out &out_file) {
+    char c;
+    while (in_file.get(c))
+        out_file.put(c);
+}
+
+/* Reading from a stringstream, one per record */
+template <typename Iss>
+static totals parse_records(const std::vector<std::string> &records) {
+    totals t {};
+    std::string name {};
+    int num {};
+    double total {};
+    for (const std::string &info : records) {
+        Iss iss {info};
+        if (iss >> name >> num >> total) {
+            ++t.lines;
+            t.bytes += name.size();
+            t.sum += total;
+        }
+    }
+    return t;
+}
+
+/* Writing to a stringstream; the text is looked at as it grows */
+template <typename Oss, typename Text>
+static totals build_text(std::size_t records, Text text) {
+    totals t {};
+    Oss oss {};
+    for (std::size_t i {0}; i < records; ++i) {
+        oss << "Moe" << " " << i % 1000 << " " << 1234.5 << "\n";
+        if (i % 100 == 99)
+            t.bytes += text(oss).size();
+    }
+    t.lines = text(oss).size();
+    return t;
+}
+
+template <typename Body>
+static double seconds(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *loop, const char *variant, double s, double std_s, bool ok) {
+    std::cout << "  " << std::left << std::setw(20) << loop << std::setw(26) << variant << std::right
+              << std::fixed << std::setprecision(3) << std::setw(8) << s << " s" << std::setprecision(2)
+              << std::setw(8) << std_s / s << "x  " << (ok ? "ok" : "MISMATCH") << std::endl;
+}
+
+/* Input variants: stock ifstream first */
+static std::vector<std::pair<const char *, pg::filebuf_options>> input_variants() {
+    pg::filebuf_options read {};
+    read.input = pg::input_mode::read;
+    pg::filebuf_options mapped {};
+    mapped.input = pg::input_mode::mmap;
+    pg::filebuf_options direct {};
+    direct.direct = true;
+    return {{"fast (1 MiB read())", read}, {"fast (mmap)", mapped}, {"fast (O_DIRECT)", direct}};
+}
+
+static std::vector<std::pair<const char *, pg::filebuf_options>> output_variants() {
+    pg::filebuf_options flush {};
+    pg::filebuf_options no_flush {};
+    no_flush.flush_on_sync = false;
+    pg::filebuf_options direct {};
+    direct.direct = true;
+    direct.flush_on_sync = false;
+    return {{"fast (flush per endl)", flush}, {"fast (no flush on sync)", no_flush}, {"fast (O_DIRECT)", direct}};
+}
+
+static bool check_seek(const std::string &path) {
+    bool ok {true};
+    std::ifstream expected {path};
+    std::string line {};
+    for (int i {0}; i < 1000; ++i)
+        std::getline(expected, line);
+    std::streampos mark = expected.tellg();
+    std::string after_mark {};
+    std::getline(expected, after_mark);
+    std::string contents = slurp(path);
+    std::string last_five {contents.substr(contents.size() - 5)};
+    for (auto &[name, options] : input_variants()) {
+        pg::fast_ifstream in_file {path, std::ios::in, options};
+        for (int i {0}; i < 1000; ++i)
+            std::getline(in_file, line);
+        bool tell = in_file.tellg() == mark;
+        std::getline(in_file, line);
+        bool next = line == after_mark;
+        in_file.seekg(0);
+        std::getline(in_file, line);
+        in_file.seekg(mark);                        // unaligned offset (O_DIRECT seeks to the block below)
+        bool tell_after_seek = in_file.tellg() == mark;
+        std::string again {};
+        std::getline(in_file, again);
+        in_file.unget();                            // back over the '\n'
+        bool unget = in_file.get() == '\n';
+        in_file.seekg(-5, std::ios::end);
+        char tail[8] {};
+        in_file.read(tail, 8);
+        bool end = in_file.gcount() == 5 && std::string {tail} == last_five;
+        bool case_ok = tell && next && tell_after_seek && again == after_mark && unget && end;
+        if (!case_ok)
+            std::cerr << "seek check failed: " << name << std::endl;
+        ok = ok && case_ok;
+    }
+    return ok;
+}
+
+static bool check_misc(const std::string &path) {
+    bool ok {true};
+
+    /* A failed open: like std::ifstream, the stream tests false; error() has the errno */
+    pg::fast_ifstream missing {"no_such_file.txt"};
+    ok = ok && !missing && !missing.is_open() && missing.error() == ENOENT;
+
+    /* Large read() and write() bypass the buffer */
+    std::string contents = slurp(path);
+    {
+        pg::fast_ifstream in_file {path, std::ios::binary, input_variants()[0].second};
+        std::string copy(contents.size(), '\0');
+        in_file.read(copy.data(), static_cast<std::streamsize>(copy.size()));
+        ok = ok && in_file.gcount() == static_cast<std::streamsize>(contents.size()) && copy == contents;
+    }
+    {
+        pg::fast_ofstream out_file {"fast_streambuf_big.txt"};
+        out_file << "head\n";
+        out_file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+        out_file << "tail\n";
+        bool tellp = out_file.tellp() == static_cast<std::streampos>(contents.size() + 10);
+        out_file.close();
+        ok = ok && tellp && out_file && slurp("fast_streambuf_big.txt") == "head\n" + contents + "tail\n";
+    }
+
+    /* std::ios::app, plain and O_DIRECT (appending at an unaligned offset) */
+    for (bool direct : {false, true}) {
+        pg::filebuf_options options {};
+        options.direct = direct;
+        {
+            pg::fast_ofstream out_file {"fast_streambuf_app.txt", std::ios::out, options};
+            out_file << "first\n";
+        }
+        {
+            pg::fast_ofstream out_file {"fast_streambuf_app.txt", std::ios::app, options};
+            out_file << "second\n";
+        }
+        ok = ok && slurp("fast_streambuf_app.txt") == "first\nsecond\n";
+    }
+
+    /* read | write isn't supported: the open fails */
+    pg::fast_filebuf both {};
+    ok = ok && both.open(path, std::ios::in | std::ios::out) == nullptr && both.error() == EINVAL;
+
+    /* Memory streams; seekp back overwrites in place, like std::ostringstream */
+    pg::memory_ostream oss {};
+    std::ostringstream std_oss {};
+    for (std::ostream *os : {static_cast<std::ostream *>(&oss), static_cast<std::ostream *>(&std_oss)}) {
+        *os << "Moe" << " " << 100 << " " << 1234.5;
+        std::streampos mark = os->tellp();
+        *os << " extra";
+        os->seekp(mark);
+        *os << "!";
+        os->seekp(0);
+        *os << "J";
+        os->seekp(0, std::ios::end);
+        *os << ".";
+    }
+    ok = ok && std_oss.str() == "Joe 100 1234.5!extra." && oss.view() == std_oss.str() && oss.str() == std_oss.str();
+    std::string taken = oss.take();
+    ok = ok && taken == "Joe 100 1234.5!extra." && oss.view().empty();
+    oss << 42;
+    ok = ok && oss.view() == "42";
+
+    pg::memory_istream iss {"Moe 100 1234.5"};
+    std::string name {};
+    int num {};
+    double total {};
+    iss >> name >> num;
+    ok = ok && iss.view() == " 1234.5" && (iss >> total) && total == 1234.5 && !(iss >> total);
+    iss.str("7 8");
+    ok = ok && (iss >> num) && num == 7;
+
+    std::remove("fast_streambuf_big.txt");
+    std::remove("fast_streambuf_app.txt");
+    return ok;
+}
+
+int main(int argc, char *argv[]) {
+    bool small {argc > 1 && std::string {argv[1]} == "--small"};
+    const std::string path {"fast_streambuf_input.txt"};
+    const std::string copy_path {"fast_streambuf_copy.txt"};
+    const std::size_t line_count {small ? 200'000u : 2'000'000u};
+    if (!make_test_file(path, line_count)) {
+        std::cerr << "File create error" << std::endl;
+        return 1;
+    }
+    std::string contents = slurp(path);            // also warms the page cache
+    std::cout << line_count << " lines, " << contents.size() / 1024 << " KB\n"
+              << "  loop                variant                      time   vs std" << std::endl;
+    bool all_ok {true};
+
+    /* 1, 2: reading */
+    totals expected_lines {}, expected_fields {};
+    double std_lines = seconds([&] {
+        std::ifstream in_file {path};
+        expected_lines = read_lines(in_file);
+    });
+    report("getline", "std::ifstream", std_lines, std_lines, true);
+    for (auto &[name, options] : input_variants()) {
+        totals got {};
+        double s = seconds([&] {
+            pg::fast_ifstream in_file {path, std::ios::in, options};
+            got = read_lines(in_file);
+        });
+        report("getline", name, s, std_lines, got == expected_lines);
+        all_ok = all_ok && got == expected_lines;
+    }
+    double std_fields = seconds([&] {
+        std::ifstream in_file {path};
+        expected_fields = read_fields(in_file);
+    });
+    report(">>", "std::ifstream", std_fields, std_fields, true);
+    for (auto &[name, options] : input_variants()) {
+        totals got {};
+        double s = seconds([&] {
+            pg::fast_ifstream in_file {path, std::ios::in, options};
+            got = read_fields(in_file);
+        });
+        report(">>", name, s, std_fields, got == expected_fields);
+        all_ok = all_ok && got == expected_fields;
+    }
+
+    /* 3, 4: copying */
+    double std_copy = seconds([&] {
+        std::ifstream in_file {path};
+        std::ofstream out_file {copy_path};
+        copy_lines(in_file, out_file);
+    });
+    bool std_copied = slurp(copy_path) == contents;
+    report("copy (<< endl)", "std::ofstream", std_copy, std_copy, std_copied);
+    for (auto &[name, options] : output_variants()) {
+        double s = seconds([&] {
+            pg::fast_ifstream in_file {path};
+            pg::fast_ofstream out_file {copy_path, std::ios::out, options};
+            copy_lines(in_file, out_file);
+        });
+        bool copied = slurp(copy_path) == contents;
+        report("copy (<< endl)", name, s, std_copy, copied);
+        all_ok = all_ok && copied;
+    }
+    double std_chars = seconds([&] {
+        std::ifstream in_file {path};
+        std::ofstream out_file {copy_path};
+        copy_chars(in_file, out_file);
+    });
+    std_copied = std_copied && slurp(copy_path) == contents;
+    report("copy (get/put)", "std::ofstream", std_chars, std_chars, std_copied);
+    for (auto &[name, options] : output_variants()) {
+        double s = seconds([&] {
+            pg::fast_ifstream in_file {path};
+            pg::fast_ofstream out_file {copy_path, std::ios::out, options};
+            copy_chars(in_file, out_file);
+        });
+        bool copied = slurp(copy_path) == contents;
+        report("copy (get/put)", name, s, std_chars, copied);
+        all_ok = all_ok && copied;
+    }
+    all_ok = all_ok && std_copied;
+
+    /* 5, 6: string streams */
+    std::vector<std::string> records {};
+    {
+        std::istringstream lines {contents};
+        std::string line {};
+        while (std::getline(lines, line))
+            records.push_back(line);
+    }
+    totals expected_records {}, got_records {};
+    double std_parse = seconds([&] { expected_records = parse_records<std::istringstream>(records); });
+    double fast_parse = seconds([&] { got_records = parse_records<pg::memory_istream>(records); });
+    report("istringstream >>", "std::istringstream", std_parse, std_parse, true);
+    report("istringstream >>", "pg::memory_istream", fast_parse, std_parse, got_records == expected_records);
+    all_ok = all_ok && got_records == expected_records && expected_records.lines == line_count;
+
+    totals expected_text {}, got_text {};
+    std::size_t record_count {line_count / 10};
+    double std_build = seconds([&] {
+        expected_text = build_text<std::ostringstream>(record_count, [](std::ostringstream &o) { return o.str(); });
+    });
+    double fast_build = seconds([&] {
+        got_text = build_text<pg::memory_ostream>(record_count, [](pg::memory_ostream &o) { return o.view(); });
+    });
+    report("ostringstream str()", "std::ostringstream", std_build, std_build, true);
+    report("ostringstream str()", "pg::memory_ostream view()", fast_build, std_build, got_text == expected_text);
+    all_ok = all_ok && got_text == expected_text;
+
+    bool seek_ok = check_seek(path);
+    bool misc_ok = check_misc(path);
+    std::cout << "\nseek/tell: " << std::boolalpha << seek_ok << "\n"
+              << "read/write/app/errors/memory streams: " << misc_ok << std::endl;
+    all_ok = all_ok && seek_ok && misc_ok;
+
+    std::remove(path.c_str());
+    std::remove(copy_path.c_str());
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
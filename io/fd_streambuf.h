@@ -0,0 +1,376 @@
+/**
+@file fd_streambuf.h
+
+@brief
+    Buffered std::streambuf on a file descriptor, shared by the file streams
+        fd_streambuf ===> fast_filebuf (fast_streambuf.h: open by path, mmap, O_DIRECT, hints)
+                     ===> instrumented_streambuf (io_stats.h: counters and latency histograms)
+
+@par
+    One direction per descriptor, chosen by attach(): reading or writing.
+        * The buffer is page aligned (posix_memalign), so O_DIRECT transfers can use it.
+        * Large xsgetn/xsputn (read(), write()) bypass the buffer.
+        * tellg()/tellp() come from the tracked file offset: no flush, no syscall.
+        * O_DIRECT (attach(..., direct = true)): a seek goes to the block below and the next
+          read skips up to the target; output is written in whole blocks, the last partial
+          block at detach().
+        * A descriptor that isn't owned (stdin) is seeked back over the unread input at
+          detach(), when it can seek, so the next reader continues at the right place.
+    Derived classes see every read()/write() through read_fd()/write_fd(), and refills,
+    flushes and errors through on_refill()/on_flush()/on_error(). They call detach() from
+    their own destructor: the hooks are gone by the time ~fd_streambuf() runs.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_FD_STREAMBUF_H
+#define PG_FD_STREAMBUF_H
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <ios>
+#include <streambuf>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pg {
+
+constexpr std::size_t direct_alignment {4096};      // O_DIRECT buffer, size and offset alignment
+
+namespace detail {
+
+/* open() flags for a stream: in reads; otherwise std::ios::app appends, anything else truncates */
+inline int open_flags(std::ios::openmode mode) {
+    if (mode & std::ios::in)
+        return O_RDONLY | O_CLOEXEC;
+    return O_WRONLY | O_CREAT | O_CLOEXEC | ((mode & std::ios::app) ? O_APPEND : O_TRUNC);
+}
+
+/* std::streambuf with a put area that may hold more than INT_MAX bytes */
+class put_area_streambuf : public std::streambuf {
+protected:
+    // pbump() takes an int: more than INT_MAX bytes take several
+    void set_put(char *base, std::size_t used, std::size_t capacity) {
+        setp(base, base + capacity);
+        while (used > 0) {
+            int step = static_cast<int>(std::min<std::size_t>(used, INT_MAX));
+            pbump(step);
+            used -= static_cast<std::size_t>(step);
+        }
+    }
+};
+
+}   // namespace detail
+
+class fd_streambuf : public detail::put_area_streambuf {
+public:
+    fd_streambuf() = default;
+
+    fd_streambuf(const fd_streambuf &) = delete;
+    fd_streambuf &operator=(const fd_streambuf &) = delete;
+
+    ~fd_streambuf() override { detach(); }
+
+    bool is_open() const { return fd_ >= 0; }
+    int fd() const { return fd_; }
+    bool is_direct() const { return direct_; }
+    std::size_t buffer_size() const { return capacity_; }
+    int error() const { return error_; }        // errno of the last failed open/read/write/close
+
+protected:
+    /* Take over an open descriptor. which: std::ios::in reads, anything else writes
+       (std::ios::app: from the end). buffer_size 0 leaves the get area to the caller. */
+    bool attach(int fd, bool owns_fd, std::ios::openmode which, std::size_t buffer_size, bool direct = false) {
+        detach();
+        fd_ = fd;
+        owns_fd_ = owns_fd;
+        reading_ = (which & std::ios::in) != 0;
+        direct_ = direct;
+        error_ = 0;
+        off_t pos = ::lseek(fd_, 0, !reading_ && (which & std::ios::app) ? SEEK_END : SEEK_CUR);
+        seekable_ = pos >= 0;
+        file_pos_ = pos > 0 ? static_cast<std::size_t>(pos) : 0;
+        if (direct_ && file_pos_ % direct_alignment != 0)
+            drop_direct();                          // starting at an unaligned offset
+        capacity_ = direct_ ? (std::max(buffer_size, direct_alignment) + direct_alignment - 1)
+                                  / direct_alignment * direct_alignment
+                            : buffer_size;
+        if (capacity_ > 0) {
+            void *raw {nullptr};
+            if (::posix_memalign(&raw, direct_alignment, capacity_) != 0) {
+                detach();
+                error_ = ENOMEM;
+                return false;
+            }
+            buffer_ = static_cast<char *>(raw);
+        }
+        if (reading_)
+            setg(buffer_, buffer_, buffer_);
+        else
+            setp(buffer_, buffer_ + capacity_);
+        return true;
+    }
+
+    /* Flush, hand back unread input (descriptor not owned), close if owned; false if a write
+       or the close failed */
+    bool detach() {
+        if (fd_ < 0)
+            return true;
+        bool ok {true};
+        if (!reading_) {
+            if (pptr() != pbase())
+                on_flush();
+            ok = flush_put(true) == 0;
+        } else if (!owns_fd_ && seekable_) {
+            ::lseek(fd_, static_cast<off_t>(position()), SEEK_SET);
+        }
+        if (owns_fd_ && ::close(fd_) != 0 && ok) {
+            fail(errno);
+            ok = false;
+        }
+        std::free(buffer_);
+        fd_ = -1;
+        owns_fd_ = false;
+        buffer_ = nullptr;
+        capacity_ = 0;
+        direct_ = false;
+        file_pos_ = 0;
+        skip_ = 0;
+        setg(nullptr, nullptr, nullptr);
+        setp(nullptr, nullptr);
+        return ok;
+    }
+
+    void set_error(int e) { error_ = e; }
+
+    // One read()/write(), retried on EINTR; -1 with errno set on failure
+    virtual ssize_t read_fd(char *p, std::size_t n) {
+        ssize_t got;
+        do
+            got = ::read(fd_, p, n);
+        while (got < 0 && errno == EINTR);
+        return got;
+    }
+
+    virtual ssize_t write_fd(const char *p, std::size_t n) {
+        ssize_t w;
+        do
+            w = ::write(fd_, p, n);
+        while (w < 0 && errno == EINTR);
+        return w;
+    }
+
+    virtual void on_refill() {}
+    virtual void on_flush() {}
+    virtual void on_error() {}
+
+    int_type underflow() override {
+        if (gptr() < egptr())
+            return traits_type::to_int_type(*gptr());
+        if (fd_ < 0 || !reading_ || capacity_ == 0)
+            return traits_type::eof();
+        for (;;) {
+            ssize_t n = read_some(buffer_, capacity_);
+            if (n <= 0)
+                return traits_type::eof();
+            file_pos_ += static_cast<std::size_t>(n);
+            if (skip_ < static_cast<std::size_t>(n)) {      // direct reads start at an aligned offset
+                setg(buffer_, buffer_ + skip_, buffer_ + n);
+                skip_ = 0;
+                on_refill();
+                return traits_type::to_int_type(*gptr());
+            }
+            skip_ -= static_cast<std::size_t>(n);
+        }
+    }
+
+    // Without a buffer (caller-owned get area) what is left in the get area is all there is
+    std::streamsize showmanyc() override {
+        if (fd_ < 0 || !reading_)
+            return -1;
+        if (egptr() > gptr())
+            return egptr() - gptr();
+        return capacity_ == 0 ? -1 : 0;
+    }
+
+    // Large reads go straight into the caller's memory
+    std::streamsize xsgetn(char *s, std::streamsize n) override {
+        if (fd_ < 0 || !reading_ || capacity_ == 0 || direct_ || skip_ != 0 ||
+            n < static_cast<std::streamsize>(capacity_))
+            return std::streambuf::xsgetn(s, n);
+        std::streamsize got = std::min<std::streamsize>(n, egptr() - gptr());
+        std::memcpy(s, gptr(), static_cast<std::size_t>(got));
+        setg(buffer_, buffer_, buffer_);
+        while (got < n) {
+            ssize_t r = read_some(s + got, static_cast<std::size_t>(n - got));
+            if (r <= 0)
+                break;
+            file_pos_ += static_cast<std::size_t>(r);
+            got += r;
+        }
+        return got;
+    }
+
+    int_type overflow(int_type c) override {
+        if (fd_ < 0 || reading_ || flush_put(false) < 0)
+            return traits_type::eof();
+        if (!traits_type::eq_int_type(c, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(c);
+            pbump(1);
+        }
+        return traits_type::not_eof(c);
+    }
+
+    // Large writes skip the buffer (not with O_DIRECT: the caller's memory isn't aligned)
+    std::streamsize xsputn(const char *s, std::streamsize n) override {
+        if (fd_ < 0 || reading_ || direct_ || n < static_cast<std::streamsize>(capacity_))
+            return std::streambuf::xsputn(s, n);
+        if (flush_put(true) < 0 || !write_all(s, static_cast<std::size_t>(n)))
+            return 0;
+        return n;
+    }
+
+    int sync() override {
+        if (fd_ < 0 || reading_)
+            return 0;
+        on_flush();
+        return flush_put(false);
+    }
+
+    pos_type seekoff(off_type off, std::ios_base::seekdir dir, std::ios_base::openmode) override {
+        if (fd_ < 0 || !seekable_)
+            return pos_type(off_type(-1));
+        off_type current = off_type(position());
+        if (dir == std::ios_base::cur && off == 0)      // tellg()/tellp(): no flush, no syscall
+            return pos_type(current);
+        off_type target = off;
+        if (dir == std::ios_base::cur) {
+            target += current;
+        } else if (dir == std::ios_base::end) {
+            struct stat st {};
+            if (!reading_ && flush_put(true) < 0)
+                return pos_type(off_type(-1));
+            if (::fstat(fd_, &st) != 0)
+                return pos_type(off_type(-1));
+            target += off_type(st.st_size);
+        }
+        return seek_to(target);
+    }
+
+    pos_type seekpos(pos_type pos, std::ios_base::openmode which) override {
+        return seekoff(off_type(pos), std::ios_base::beg, which);
+    }
+
+private:
+    // Stream position: file offset of the next byte read or written
+    std::size_t position() const {
+        if (reading_)
+            return file_pos_ + skip_ - static_cast<std::size_t>(egptr() - gptr());
+        return file_pos_ + static_cast<std::size_t>(pptr() - pbase());
+    }
+
+    pos_type seek_to(off_type target) {
+        if (target < 0)
+            return pos_type(off_type(-1));
+        if (reading_) {
+            std::size_t aligned = direct_ ? static_cast<std::size_t>(target) / direct_alignment * direct_alignment
+                                          : static_cast<std::size_t>(target);
+            if (::lseek(fd_, static_cast<off_t>(aligned), SEEK_SET) < 0)
+                return pos_type(off_type(-1));
+            file_pos_ = aligned;
+            skip_ = static_cast<std::size_t>(target) - aligned;
+            setg(buffer_, buffer_, buffer_);
+            return pos_type(target);
+        }
+        if (flush_put(true) < 0)
+            return pos_type(off_type(-1));
+        if (direct_ && target % off_type(direct_alignment) != 0)
+            drop_direct();
+        if (::lseek(fd_, static_cast<off_t>(target), SEEK_SET) < 0)
+            return pos_type(off_type(-1));
+        file_pos_ = static_cast<std::size_t>(target);
+        return pos_type(target);
+    }
+
+    // all == false with O_DIRECT: whole blocks only, the tail moves to the front of the buffer
+    int flush_put(bool all) {
+        if (pbase() == nullptr)
+            return 0;
+        std::size_t used = static_cast<std::size_t>(pptr() - pbase());
+        std::size_t n = direct_ && !all ? used / direct_alignment * direct_alignment : used;
+        if (direct_ && n % direct_alignment != 0)
+            drop_direct();                              // last partial block: O_DIRECT can't write it
+        if (n > 0 && !write_all(buffer_, n))
+            return -1;
+        std::size_t tail = used - n;
+        if (tail > 0)
+            std::memmove(buffer_, buffer_ + n, tail);
+        set_put(buffer_, tail, capacity_);
+        return 0;
+    }
+
+    void drop_direct() {
+#ifdef O_DIRECT
+        int flags = ::fcntl(fd_, F_GETFL);
+        if (flags >= 0)
+            ::fcntl(fd_, F_SETFL, flags & ~O_DIRECT);
+#endif
+        direct_ = false;
+    }
+
+    void fail(int e) {
+        error_ = e;
+        on_error();
+    }
+
+    ssize_t read_some(char *p, std::size_t n) {
+        ssize_t got = read_fd(p, n);
+        if (got < 0)
+            fail(errno);
+        return got;
+    }
+
+    bool write_all(const char *p, std::size_t n) {
+        while (n > 0) {
+            ssize_t w = write_fd(p, n);
+            if (w <= 0) {
+                fail(w < 0 ? errno : EIO);
+                return false;
+            }
+            p += w;
+            n -= static_cast<std::size_t>(w);
+            file_pos_ += static_cast<std::size_t>(w);
+        }
+        return true;
+    }
+
+    int fd_ {-1};
+    bool owns_fd_ {false};
+    bool reading_ {false};
+    bool direct_ {false};
+    bool seekable_ {false};
+    int error_ {0};
+    char *buffer_ {nullptr};                    // page aligned (posix_memalign)
+    std::size_t capacity_ {0};
+    std::size_t file_pos_ {0};                  // file offset of egptr() (reading) or pbase() (writing)
+    std::size_t skip_ {0};                      // bytes to drop from the next read (aligned seeks)
+};
+
+}   // namespace pg
+
+#endif  // PG_FD_STREAMBUF_H
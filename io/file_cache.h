@@ -0,0 +1,335 @@
+/**
+@file file_cache.h
+
+@brief
+    Process-wide cache of file contents
+        path ===> (hit) shared immutable buffer
+              ===> (miss) read once ===> cache (LRU, memory budget) ===> shared immutable buffer
+
+@par
+    Why:
+        * Code in the style of file_input_output.cpp opens and rereads the same file
+          (../myfile.txt, config files, reference tables) from scratch every time it needs it.
+        * The cache reads a file once and hands every later caller the same buffer.
+    Buffers:
+        * get() returns std::shared_ptr<const file_buffer>; the bytes never change, and a
+          buffer stays valid for as long as someone holds it, even after eviction or
+          invalidation (the cache only drops its own reference).
+        * Contents are copied into memory rather than mmapped, so a writer changing the file
+          can't change a buffer that is already in use.
+    Keys and freshness:
+        * Entries are keyed by path and remember the device, inode, size and mtime.
+        * validation::inotify (default) -> each cached file has an inotify watch; pending events
+          are drained at the start of every get() and drop the entries they touch, so a hit
+          needs no syscall besides one non-blocking read() of the inotify descriptor.
+        * validation::stat -> every get() stat()s the file and compares inode/size/mtime.
+          Used automatically when inotify isn't available.
+        * A path that is replaced (rename over it) shows up as a different inode / IN_DELETE_SELF.
+    Budget:
+        * budget_bytes caps the cached bytes; least recently used entries are evicted first.
+        * A file larger than the whole budget is returned but not cached.
+    Counters (stats()): hits, misses, evictions, invalidations, cached bytes and entries.
+    Usage:
+        std::shared_ptr<const pg::file_buffer> config = pg::file_cache::global().get("../myfile.txt");
+        if (!config) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        std::string_view text = config->view();
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_FILE_CACHE_H
+#define PG_FILE_CACHE_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pg {
+
+/* Identity of a file version: a different inode, size or mtime is a different file */
+struct file_stamp {
+    dev_t device {0};
+    ino_t inode {0};
+    off_t size {0};
+    std::int64_t mtime_ns {0};
+
+    static file_stamp of(const struct stat &st) {
+        return {st.st_dev, st.st_ino, st.st_size,
+                static_cast<std::int64_t>(st.st_mtim.tv_sec) * 1'000'000'000 + st.st_mtim.tv_nsec};
+    }
+    bool operator==(const file_stamp &o) const {
+        return device == o.device && inode == o.inode && size == o.size && mtime_ns == o.mtime_ns;
+    }
+    bool operator!=(const file_stamp &o) const { return !(*this == o); }
+};
+
+class file_buffer {
+public:
+    file_buffer(std::string data, file_stamp stamp) : data_ {std::move(data)}, stamp_ {stamp} {}
+
+    std::string_view view() const { return data_; }
+    const char *data() const { return data_.data(); }
+    std::size_t size() const { return data_.size(); }
+    const file_stamp &stamp() const { return stamp_; }
+
+private:
+    const std::string data_;
+    const file_stamp stamp_;
+};
+
+struct cache_stats {
+    std::uint64_t hits {0};
+    std::uint64_t misses {0};
+    std::uint64_t evictions {0};        // dropped to stay under the budget
+    std::uint64_t invalidations {0};    // dropped because the file changed
+    std::size_t bytes {0};              // currently cached
+    std::size_t entries {0};
+};
+
+class file_cache {
+public:
+    enum class validation { inotify, stat };
+
+    static constexpr std::size_t default_budget {64u << 20};    // 64 MiB
+
+    explicit file_cache(std::size_t budget_bytes = default_budget, validation v = validation::inotify)
+        : budget_ {budget_bytes}, validation_ {v} {
+        if (validation_ == validation::inotify) {
+            inotify_fd_ = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (inotify_fd_ < 0)
+                validation_ = validation::stat;
+        }
+    }
+
+    file_cache(const file_cache &) = delete;
+    file_cache &operator=(const file_cache &) = delete;
+
+    ~file_cache() {
+        if (inotify_fd_ >= 0)
+            ::close(inotify_fd_);
+    }
+
+    /* The cache shared by the whole process */
+    static file_cache &global() {
+        static file_cache cache {};
+        return cache;
+    }
+
+    /* Contents of `path`; nullptr if it can't be read */
+    std::shared_ptr<const file_buffer> get(const std::string &path) {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            drain_events();
+            auto it = entries_.find(path);
+            if (it != entries_.end()) {
+                bool fresh {true};
+                if (validation_ == validation::stat || it->second.wd < 0) {
+                    struct stat st {};
+                    fresh = ::stat(path.c_str(), &st) == 0 && file_stamp::of(st) == it->second.buffer->stamp();
+                }
+                if (fresh) {
+                    ++stats_.hits;
+                    lru_.splice(lru_.begin(), lru_, it->second.lru);
+                    return it->second.buffer;
+                }
+                ++stats_.invalidations;
+                erase(it);
+            }
+            ++stats_.misses;
+        }
+
+        // Read without the lock so other paths aren't held up by this one
+        std::shared_ptr<const file_buffer> buffer = read_file(path);
+        if (!buffer)
+            return nullptr;
+
+        std::lock_guard<std::mutex> lock {mutex_};
+        auto it = entries_.find(path);
+        if (it != entries_.end()) {             // another thread got here first
+            if (it->second.buffer->stamp() == buffer->stamp())
+                return it->second.buffer;
+            erase(it);
+        }
+        if (buffer->size() <= budget_)
+            insert(path, buffer);
+        return buffer;
+    }
+
+    /* Drop one path (e.g. after writing it from this process) */
+    void invalidate(const std::string &path) {
+        std::lock_guard<std::mutex> lock {mutex_};
+        auto it = entries_.find(path);
+        if (it != entries_.end()) {
+            ++stats_.invalidations;
+            erase(it);
+        }
+    }
+
+    void clear() {
+        std::lock_guard<std::mutex> lock {mutex_};
+        while (!entries_.empty())
+            erase(entries_.begin());
+    }
+
+    void set_budget(std::size_t budget_bytes) {
+        std::lock_guard<std::mutex> lock {mutex_};
+        budget_ = budget_bytes;
+        evict_to(budget_);
+    }
+
+    cache_stats stats() const {
+        std::lock_guard<std::mutex> lock {mutex_};
+        cache_stats s = stats_;
+        s.bytes = bytes_;
+        s.entries = entries_.size();
+        return s;
+    }
+
+    validation mode() const { return validation_; }
+
+private:
+    struct entry {
+        std::shared_ptr<const file_buffer> buffer;
+        std::list<std::string>::iterator lru;
+        int wd {-1};                            // inotify watch, -1 if none
+    };
+
+    static std::shared_ptr<const file_buffer> read_file(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return nullptr;
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+            ::close(fd);
+            return nullptr;
+        }
+        std::string data(static_cast<std::size_t>(st.st_size), '\0');
+        std::size_t got {0};
+        for (;;) {
+            if (got == data.size())
+                data.resize(data.size() + 4096);   // the file grew since fstat
+            ssize_t n = ::read(fd, &data[got], data.size() - got);
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0) {
+                ::close(fd);
+                return nullptr;
+            }
+            if (n == 0)
+                break;
+            got += static_cast<std::size_t>(n);
+        }
+        data.resize(got);
+        // Stamp after reading: a write during the read changes mtime and the next get() rereads
+        if (::fstat(fd, &st) != 0) {
+            ::close(fd);
+            return nullptr;
+        }
+        ::close(fd);
+        return std::make_shared<const file_buffer>(std::move(data), file_stamp::of(st));
+    }
+
+    void insert(const std::string &path, std::shared_ptr<const file_buffer> buffer) {
+        int wd {-1};
+        if (validation_ == validation::inotify) {
+            wd = ::inotify_add_watch(inotify_fd_, path.c_str(),
+                                     IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+            // Same inode under another path: the kernel returned that entry's watch, which
+            // isn't ours to remove; validate this path by stat instead
+            if (wd >= 0 && watched_.count(wd) != 0)
+                wd = -1;
+            // A change between the read and the watch would go unnoticed: check once more
+            struct stat st {};
+            if (wd >= 0 && (::stat(path.c_str(), &st) != 0 || file_stamp::of(st) != buffer->stamp())) {
+                ::inotify_rm_watch(inotify_fd_, wd);
+                return;
+            }
+        }
+        evict_to(budget_ - buffer->size());
+        lru_.push_front(path);
+        entry e {std::move(buffer), lru_.begin(), wd};
+        if (wd >= 0)
+            watched_[wd] = path;
+        bytes_ += e.buffer->size();
+        entries_.emplace(path, std::move(e));
+    }
+
+    void erase(std::unordered_map<std::string, entry>::iterator it) {
+        if (it->second.wd >= 0) {
+            ::inotify_rm_watch(inotify_fd_, it->second.wd);
+            watched_.erase(it->second.wd);
+        }
+        bytes_ -= it->second.buffer->size();
+        lru_.erase(it->second.lru);
+        entries_.erase(it);
+    }
+
+    void evict_to(std::size_t limit) {
+        while (bytes_ > limit && !lru_.empty()) {
+            ++stats_.evictions;
+            erase(entries_.find(lru_.back()));
+        }
+    }
+
+    // Drop every entry an inotify event was reported for
+    void drain_events() {
+        if (inotify_fd_ < 0 || watched_.empty())
+            return;
+        alignas(inotify_event) char events[4096];
+        for (;;) {
+            ssize_t n = ::read(inotify_fd_, events, sizeof events);
+            if (n <= 0)
+                return;                         // EAGAIN: nothing pending
+            for (ssize_t off {0}; off < n;) {
+                const inotify_event *ev = reinterpret_cast<const inotify_event *>(events + off);
+                auto w = watched_.find(ev->wd);
+                if (w != watched_.end()) {
+                    auto it = entries_.find(w->second);
+                    if (it != entries_.end()) {
+                        ++stats_.invalidations;
+                        erase(it);
+                    }
+                }
+                off += static_cast<ssize_t>(sizeof(inotify_event) + ev->len);
+            }
+        }
+    }
+
+    mutable std::mutex mutex_ {};
+    std::size_t budget_;
+    validation validation_;
+    int inotify_fd_ {-1};
+    std::unordered_map<std::string, entry> entries_ {};
+    std::unordered_map<int, std::string> watched_ {};
+    std::list<std::string> lru_ {};             // front = most recently used
+    std::size_t bytes_ {0};
+    cache_stats stats_ {};
+};
+
+}   // namespace pg
+
+#endif  // PG_FILE_CACHE_H
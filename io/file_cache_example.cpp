@@ -0,0 +1,143 @@
+/**
+@file file_cache_example.cpp
+
+@brief
+    Rereading the same input file many times, as file_input_output.cpp does with
+    ../myfile.txt: std::ifstream + std::getline every time vs pg::file_cache (file_cache.h).
+
+@par
+    Shows:
+        * hit/miss counters for repeated reads
+        * a write to the file is picked up (inotify invalidation) on the next get()
+        * the same through a second path (hardlink) to a file that is already watched
+        * LRU eviction with a budget smaller than the working set
+        * a buffer handed out earlier stays valid after its entry is evicted
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <unistd.h>
+
+#include "file_cache.h"
+#include "newline_scan.h"
+
+static void print_stats(const std::string &label, const pg::file_cache &cache) {
+    pg::cache_stats s = cache.stats();
+    std::cout << std::left << std::setw(18) << label << std::right
+              << "hits " << s.hits << "  misses " << s.misses << "  evictions " << s.evictions
+              << "  invalidations " << s.invalidations << "  cached " << s.entries << " files / "
+              << s.bytes << " bytes" << std::endl;
+}
+
+static bool write_file(const std::string &path, const std::string &text) {
+    std::ofstream out_file {path};
+    out_file << text;
+    return static_cast<bool>(out_file);
+}
+
+int main() {
+    const std::string path {"file_cache_demo.txt"};
+    std::string text {};
+    for (int i {0}; i < 20000; ++i)
+        text += "Larry " + std::to_string(i) + " 255.67\n";
+    if (!write_file(path, text)) {
+        std::cerr << "File create error" << std::endl;
+        return 1;
+    }
+
+    /* Reread 1000 times */
+    const int rounds {1000};
+    auto start = std::chrono::steady_clock::now();
+    std::size_t stream_lines {0};
+    for (int r {0}; r < rounds; ++r) {
+        std::ifstream in_file {path};
+        if (!in_file) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        std::string line {};
+        while (std::getline(in_file, line))
+            ++stream_lines;
+    }
+    double s_stream = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    pg::file_cache cache {};
+    start = std::chrono::steady_clock::now();
+    std::size_t cache_lines {0};
+    for (int r {0}; r < rounds; ++r) {
+        std::shared_ptr<const pg::file_buffer> file = cache.get(path);
+        if (!file) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        cache_lines += pg::count_lines(file->data(), file->size());
+    }
+    double s_cache = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "ifstream + getline " << std::setw(8) << s_stream << " s" << std::endl
+              << "file_cache         " << std::setw(8) << s_cache << " s   x" << std::setprecision(1)
+              << s_stream / s_cache << "   (" << (cache.mode() == pg::file_cache::validation::inotify ? "inotify" : "stat")
+              << " validation)" << std::endl;
+    print_stats("after rereads:", cache);
+    bool ok = stream_lines == cache_lines;
+
+    /* Invalidation: the writer changes the file, the next get() sees it */
+    std::shared_ptr<const pg::file_buffer> before = cache.get(path);
+    ok = write_file(path, "Moe 1 2.5\n") && ok;
+    std::shared_ptr<const pg::file_buffer> after = cache.get(path);
+    ok = ok && after->view() == "Moe 1 2.5\n" && before->size() == text.size();
+    std::cout << "sees new contents: " << std::boolalpha << (after->view() == "Moe 1 2.5\n")
+              << ", old buffer intact: " << (before->size() == text.size()) << std::endl;
+    print_stats("after write:", cache);
+
+    /* Two paths, one inode: the second path shares the first one's watch */
+    const std::string link {"file_cache_demo.link"};
+    std::remove(link.c_str());
+    if (::link(path.c_str(), link.c_str()) == 0) {
+        cache.get(path);
+        cache.get(link);
+        ok = write_file(path, "Curly 3 7.5\n") && ok;
+        bool both = cache.get(path)->view() == "Curly 3 7.5\n" && cache.get(link)->view() == "Curly 3 7.5\n";
+        std::cout << "hardlink sees new contents: " << std::boolalpha << both << std::endl;
+        ok = ok && both;
+        std::remove(link.c_str());
+    }
+
+    /* Eviction: 8 files of ~40 KB under a 128 KB budget */
+    std::vector<std::string> names {};
+    for (int i {0}; i < 8; ++i) {
+        names.push_back("file_cache_demo" + std::to_string(i) + ".txt");
+        write_file(names.back(), std::string(40000, static_cast<char>('a' + i)));
+    }
+    pg::file_cache small {128 * 1024};
+    std::shared_ptr<const pg::file_buffer> first = small.get(names[0]);
+    for (int round {0}; round < 3; ++round)
+        for (const std::string &name : names)
+            small.get(name);
+    ok = ok && small.stats().bytes <= 128 * 1024 && small.stats().evictions > 0 && first->view() == std::string(40000, 'a');
+    print_stats("small budget:", small);
+
+    std::cout << "results match: " << std::boolalpha << ok << std::endl;
+    std::remove(path.c_str());
+    for (const std::string &name : names)
+        std::remove(name.c_str());
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,297 @@
+/**
+@file file_copy.h
+
+@brief
+    High-throughput file copy
+        Source file ===> (aligned buffer | kernel copy | mmap) ===> Destination file
+
+@par
+    Backends:
+        copy_backend::buffered -> read()/write() through a large page-aligned buffer.
+        copy_backend::kernel -> copy_file_range(), then sendfile(); data never enters user space.
+        copy_backend::mmap -> map the source and write() straight from the mapping.
+        copy_backend::automatic -> pick by file size (see choose_backend()).
+        copy_stream(in_fd, out_fd) -> descriptors of unknown length; splice() when one is a pipe.
+    Fallbacks:
+        * kernel falls back to sendfile() and then to buffered when the file system refuses
+          (EXDEV, ENOSYS, EINVAL, EOPNOTSUPP).
+        * mmap falls back to buffered when the source can't be mapped (pipes, empty files).
+    Results:
+        copy_file() never throws; check copy_result::ok and copy_result::error (errno).
+        copy_result::mb_per_sec() gives the throughput of the copy.
+    Usage:
+        pg::copy_result r = pg::copy_file("../myfile.txt", "../copy.txt");
+        if (!r.ok)
+            std::cerr << "File copy error: " << std::strerror(r.error) << std::endl;
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_FILE_COPY_H
+#define PG_FILE_COPY_H
+
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace pg {
+
+enum class copy_backend { automatic, buffered, kernel, mmap };
+
+inline const char *to_string(copy_backend b) {
+    switch (b) {
+    case copy_backend::automatic: return "automatic";
+    case copy_backend::buffered: return "buffered";
+    case copy_backend::kernel: return "kernel";
+    case copy_backend::mmap: return "mmap";
+    }
+    return "?";
+}
+
+struct copy_result {
+    bool ok {false};
+    copy_backend used {copy_backend::automatic};    // backend that actually moved the bytes
+    std::size_t bytes {0};
+    double seconds {0.0};
+    int error {0};                                  // errno on failure
+
+    double mb_per_sec() const {
+        return seconds > 0.0 ? static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+};
+
+constexpr std::size_t default_copy_buffer_size {1 << 20};   // 1 MiB
+
+/* Small files: one read()/write() pair beats any setup cost; the rest: let the kernel copy */
+inline copy_backend choose_backend(std::size_t file_size) {
+    constexpr std::size_t small_file {64 * 1024};
+    return file_size < small_file ? copy_backend::buffered : copy_backend::kernel;
+}
+
+namespace detail {
+
+inline bool write_all(int fd, const char *p, std::size_t n) {
+    while (n > 0) {
+        ssize_t w = ::write(fd, p, n);
+        if (w < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        p += w;
+        n -= static_cast<std::size_t>(w);
+    }
+    return true;
+}
+
+inline bool copy_buffered(int in, int out, std::size_t buffer_size, std::size_t &bytes) {
+    constexpr std::size_t page {4096};
+    buffer_size = (buffer_size + page - 1) / page * page;
+    void *raw {nullptr};
+    if (int e = ::posix_memalign(&raw, page, buffer_size); e != 0) {
+        errno = e;                              // posix_memalign returns the error instead
+        return false;
+    }
+    char *buffer = static_cast<char *>(raw);
+    bool ok {true};
+    for (;;) {
+        ssize_t n = ::read(in, buffer, buffer_size);
+        if (n == 0)
+            break;
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            ok = false;
+            break;
+        }
+        if (!write_all(out, buffer, static_cast<std::size_t>(n))) {
+            ok = false;
+            break;
+        }
+        bytes += static_cast<std::size_t>(n);
+    }
+    int saved = errno;
+    std::free(buffer);
+    errno = saved;
+    return ok;
+}
+
+inline bool kernel_unsupported(int e) {
+    return e == EXDEV || e == ENOSYS || e == EINVAL || e == EOPNOTSUPP || e == EBADF;
+}
+
+// true: done; false with errno: failed; false with unsupported errno before any byte: try next.
+// An early end of input (the source shrank after fstat) fails with EIO.
+inline bool copy_kernel(int in, int out, std::size_t size, std::size_t &bytes) {
+    while (bytes < size) {
+        ssize_t n = ::copy_file_range(in, nullptr, out, nullptr, size - bytes, 0);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n == 0)
+            errno = bytes == 0 ? ENOSYS : EIO;  // nothing at all: some special files, let sendfile try
+        if (n <= 0)
+            break;
+        bytes += static_cast<std::size_t>(n);
+    }
+    if (bytes == size)
+        return true;
+    if (bytes > 0 || !kernel_unsupported(errno))
+        return bytes == size;
+    while (bytes < size) {
+        ssize_t n = ::sendfile(out, in, nullptr, size - bytes);
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n == 0)
+            errno = EIO;
+        if (n <= 0)
+            break;
+        bytes += static_cast<std::size_t>(n);
+    }
+    return bytes == size;
+}
+
+inline bool copy_mmap(int in, int out, std::size_t size, std::size_t &bytes) {
+    void *p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, in, 0);
+    if (p == MAP_FAILED)
+        return false;
+    ::madvise(p, size, MADV_SEQUENTIAL);
+    bool ok = write_all(out, static_cast<const char *>(p), size);
+    int saved = errno;
+    ::munmap(p, size);
+    errno = saved;
+    if (ok)
+        bytes = size;
+    return ok;
+}
+
+inline bool copy_splice(int in, int out, std::size_t &bytes) {
+    constexpr std::size_t chunk {1 << 20};
+    for (;;) {
+        ssize_t n = ::splice(in, nullptr, out, nullptr, chunk, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (n == 0)
+            return true;
+        if (n < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        bytes += static_cast<std::size_t>(n);
+    }
+}
+
+}   // namespace detail
+
+/* Copy `from` to `to` (created or truncated, like std::ofstream); EINVAL if both name the same file */
+inline copy_result copy_file(const std::string &from, const std::string &to,
+                             copy_backend backend = copy_backend::automatic,
+                             std::size_t buffer_size = default_copy_buffer_size) {
+    copy_result r {};
+    auto start = std::chrono::steady_clock::now();
+
+    int in = ::open(from.c_str(), O_RDONLY | O_CLOEXEC);
+    if (in < 0) {
+        r.error = errno;
+        return r;
+    }
+    struct stat st {};
+    if (::fstat(in, &st) != 0) {
+        r.error = errno;
+        ::close(in);
+        return r;
+    }
+    int out = ::open(to.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);     // truncated below
+    if (out < 0) {
+        r.error = errno;
+        ::close(in);
+        return r;
+    }
+    struct stat out_st {};
+    if (::fstat(out, &out_st) != 0) {
+        r.error = errno;
+    } else if (out_st.st_dev == st.st_dev && out_st.st_ino == st.st_ino) {
+        r.error = EINVAL;                       // same path, hardlink or symlink: truncating would wipe the input
+    } else if (S_ISREG(out_st.st_mode) && ::ftruncate(out, 0) != 0) {
+        r.error = errno;
+    }
+    if (r.error != 0) {
+        ::close(in);
+        ::close(out);
+        return r;
+    }
+
+    bool regular = S_ISREG(st.st_mode);
+    std::size_t size = regular ? static_cast<std::size_t>(st.st_size) : 0;
+    if (backend == copy_backend::automatic)
+        backend = regular ? choose_backend(size) : copy_backend::buffered;
+    if (!regular || size == 0)
+        backend = copy_backend::buffered;       // unknown length or nothing to map
+
+    if (regular)
+        ::posix_fadvise(in, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    bool ok {false};
+    if (backend == copy_backend::kernel) {
+        ok = detail::copy_kernel(in, out, size, r.bytes);
+        if (!ok && r.bytes == 0 && detail::kernel_unsupported(errno))
+            backend = copy_backend::buffered;
+    } else if (backend == copy_backend::mmap) {
+        ok = detail::copy_mmap(in, out, size, r.bytes);
+        if (!ok && r.bytes == 0 && (errno == ENODEV || errno == EINVAL || errno == EACCES))
+            backend = copy_backend::buffered;
+    }
+    if (backend == copy_backend::buffered) {
+        ::lseek(in, 0, SEEK_SET);
+        ok = detail::copy_buffered(in, out, buffer_size, r.bytes);
+    }
+    if (!ok)
+        r.error = errno;
+
+    ::close(in);
+    if (::close(out) != 0 && ok) {
+        ok = false;
+        r.error = errno;
+    }
+    r.ok = ok;
+    r.used = backend;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+/* Copy everything from an open descriptor (e.g. a stdin pipe) to another, until EOF.
+   splice() moves pipe pages inside the kernel; other descriptors use the buffered path. */
+inline copy_result copy_stream(int in, int out, std::size_t buffer_size = default_copy_buffer_size) {
+    copy_result r {};
+    auto start = std::chrono::steady_clock::now();
+    r.used = copy_backend::kernel;
+    bool ok = detail::copy_splice(in, out, r.bytes);
+    if (!ok && r.bytes == 0 && detail::kernel_unsupported(errno)) {
+        r.used = copy_backend::buffered;
+        ok = detail::copy_buffered(in, out, buffer_size, r.bytes);
+    }
+    r.ok = ok;
+    if (!ok)
+        r.error = errno;
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+}   // namespace pg
+
+#endif  // PG_FILE_COPY_H
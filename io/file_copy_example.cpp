@@ -0,0 +1,163 @@
+/**
+@file file_copy_example.cpp
+
+@brief
+    Copying files fast (file_copy.h), benchmarked against the two copy loops
+    from file_input_output.cpp.
+
+@par
+    Usage:
+        file_copy_example                   -> generates a 256 MB test file and benchmarks it
+        file_copy_example --small           -> 8 MB test file
+        file_copy_example <from> <to>       -> copies <from> to <to> with the automatic backend
+    Benchmarked copies (MB/s):
+        1. getline + out_file << line << std::endl     (flushes every line)
+        2. in_file.get(c) + out_file.put(c)             (one character at a time)
+        3. pg::copy_file with each backend: buffered, kernel, mmap, automatic
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
+#include <string>
+
+#include <unistd.h>
+
+#include "file_copy.h"
+
+/* Write a test file of about `size` bytes */
+static bool make_test_file(const std::string &path, std::size_t size) {
+    std::ofstream out_file {path, std::ios::binary};
+    std::string line {};
+    std::size_t written {0};
+    for (std::size_t i {0}; out_file && written < size; ++i) {
+        line = "Larry " + std::to_string(i) + " " + std::to_string(i * 2.5) + "\n";
+        out_file << line;
+        written += line.size();
+    }
+    return static_cast<bool>(out_file);
+}
+
+static bool same_contents(const std::string &a, const std::string &b) {
+    std::ifstream fa {a, std::ios::binary}, fb {b, std::ios::binary};
+    return std::equal(std::istreambuf_iterator<char>(fa), std::istreambuf_iterator<char>(),
+                      std::istreambuf_iterator<char>(fb), std::istreambuf_iterator<char>());
+}
+
+static void report(const std::string &label, double seconds, std::size_t bytes, bool ok) {
+    std::cout << std::left << std::setw(34) << label << std::right
+              << std::setw(10) << std::fixed << std::setprecision(3) << seconds << " s"
+              << std::setw(10) << std::setprecision(1)
+              << static_cast<double>(bytes) / (1024.0 * 1024.0) / seconds << " MB/s"
+              << (ok ? "" : "  (MISMATCH)") << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    /* Copying a file */
+    bool small {argc == 2 && std::string {argv[1]} == "--small"};
+    if (argc == 3) {
+        pg::copy_result r = pg::copy_file(argv[1], argv[2]);
+        if (!r.ok) {
+            std::cerr << "File copy error: " << std::strerror(r.error) << std::endl;
+            return 1;
+        }
+        std::cout << r.bytes << " bytes via " << pg::to_string(r.used)
+                  << ", " << std::fixed << std::setprecision(1) << r.mb_per_sec() << " MB/s" << std::endl;
+        return 0;
+    }
+
+    const std::string from {"file_copy_bench.txt"};
+    const std::string to {"file_copy_bench.copy"};
+    std::cout << "Generating " << from << " ..." << std::endl;
+    if (!make_test_file(from, small ? 8u << 20 : 256u << 20)) {
+        std::cerr << "File create error" << std::endl;
+        return 1;
+    }
+    std::size_t size {0};
+    {
+        std::ifstream probe {from, std::ios::binary | std::ios::ate};
+        size = static_cast<std::size_t>(probe.tellg());
+    }
+    bool all_ok {true};
+
+    /* Copy a text file one line at a time (getline + endl) */
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::ifstream in_file {from};
+        std::ofstream out_file {to};
+        std::string line {};
+        while (std::getline(in_file, line))
+            out_file << line << std::endl;          // flush on every line
+        out_file.close();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bool ok = same_contents(from, to);
+        report("getline + endl", s, size, ok);
+        all_ok = all_ok && ok;
+    }
+
+    /* Copy a text file one character at a time (get/put) */
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::ifstream in_file {from};
+        std::ofstream out_file {to};
+        char c;
+        while (in_file.get(c))
+            out_file.put(c);
+        out_file.close();
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bool ok = same_contents(from, to);
+        report("get/put", s, size, ok);
+        all_ok = all_ok && ok;
+    }
+
+    /* pg::copy_file backends */
+    for (pg::copy_backend b : {pg::copy_backend::buffered, pg::copy_backend::kernel,
+                               pg::copy_backend::mmap, pg::copy_backend::automatic}) {
+        pg::copy_result r = pg::copy_file(from, to, b);
+        if (!r.ok) {
+            std::cerr << "File copy error (" << pg::to_string(b) << "): "
+                      << std::strerror(r.error) << std::endl;
+            all_ok = false;
+            continue;
+        }
+        bool ok = same_contents(from, to);
+        report(std::string {"copy_file "} + pg::to_string(b) + " -> " + pg::to_string(r.used),
+               r.seconds, r.bytes, ok);
+        all_ok = all_ok && ok;
+    }
+
+    /* Copying a file onto itself (directly or through a hardlink) must fail and keep the input */
+    {
+        const std::string link {to + ".link"};
+        std::remove(link.c_str());
+        bool linked = ::link(from.c_str(), link.c_str()) == 0;
+        pg::copy_result self = pg::copy_file(from, from);
+        pg::copy_result hard = linked ? pg::copy_file(from, link) : self;
+        bool ok = !self.ok && self.error == EINVAL && !hard.ok && hard.error == EINVAL
+               && same_contents(from, to);
+        std::cout << "copy onto itself rejected: " << std::boolalpha << ok << std::endl;
+        all_ok = all_ok && ok;
+        std::remove(link.c_str());
+    }
+
+    std::remove(from.c_str());
+    std::remove(to.c_str());
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,331 @@
+/**
+@file format_layout.h
+
+@brief
+    Compile-time format layouts
+        "{:*>10.3f}{:->10}" ===> parsed by the compiler ===> format_writer calls with constant specs
+
+@par
+    Layout syntax (a subset of std::format):
+        {}                  -> next argument, default spec
+        {:[[fill]align][sign][#][0][width][.precision][type]}
+            align -> '<' left, '>' right, '^' center
+            sign -> '+' always show the sign, '-' only for negatives (default)
+            '#' -> show the base (0x, 0)
+            '0' -> pad with zeros after the sign (same as iostream std::internal)
+            type -> d x X o (integers), f F e E g G (floating point), s (text, bool as true/false)
+        {{ and }} -> literal braces
+    Differences from std::format:
+        Floats without a type follow iostreams (%g, precision 6), like format_writer.
+    Compile-time checks (static_assert):
+        * A malformed layout string.
+        * Wrong number of arguments.
+        * An argument that doesn't fit its field's type (e.g. a string for {:.3f}).
+    Size precomputation:
+        layout<S>::max_size<Args...>() is the largest possible output when every field is
+        bounded (numbers, bools, chars), or 0 when a field is unbounded (text). write()
+        reserves that many bytes up front.
+    Usage (the layout string needs static storage so it can be a template argument):
+        static constexpr char row_layout[] = "{:*>10.3f}{:->10}\n";
+        pg::format_writer out {};
+        pg::layout<row_layout>::write(out, 1234.5678, "Hello");    // **1234.568-----Hello
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_FORMAT_LAYOUT_H
+#define PG_FORMAT_LAYOUT_H
+
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "format_writer.h"
+
+namespace pg {
+
+enum class layout_errc { ok, unmatched_open, unmatched_close, bad_spec };
+
+struct layout_field {
+    format_spec spec {};
+    char type {'\0'};           // '\0' when the layout gives no type
+    std::size_t text_begin {0}; // literal text printed before this field
+    std::size_t text_size {0};
+};
+
+namespace detail {
+
+constexpr std::size_t c_length(const char *s) {
+    std::size_t n {0};
+    while (s[n] != '\0')
+        ++n;
+    return n;
+}
+
+// Upper bound on fields: every '{' that doesn't start "{{"
+constexpr std::size_t count_fields(const char *s) {
+    std::size_t n {0};
+    for (std::size_t i {0}; s[i] != '\0'; ++i) {
+        if (s[i] == '{' && s[i + 1] == '{')
+            ++i;
+        else if (s[i] == '{')
+            ++n;
+    }
+    return n;
+}
+
+constexpr bool is_digit(char c) { return c >= '0' && c <= '9'; }
+constexpr bool is_align(char c) { return c == '<' || c == '>' || c == '^'; }
+
+template <std::size_t N, std::size_t L>
+struct parsed_layout {
+    std::array<layout_field, N> fields {};
+    std::array<char, L> text {};            // all literal text, braces unescaped
+    std::size_t text_size {0};
+    std::size_t tail_begin {0};             // literal text after the last field
+    layout_errc error {layout_errc::ok};
+    std::size_t error_pos {0};
+};
+
+constexpr format_spec apply_align(format_spec spec, char a) {
+    return a == '<' ? spec.left() : a == '^' ? spec.center() : spec.right();
+}
+
+// Parses one "{...}" starting after the '{'; returns the position after '}' or 0 on error
+constexpr std::size_t parse_field_spec(const char *s, std::size_t i, layout_field &f) {
+    if (s[i] == '}')
+        return i + 1;
+    if (s[i] != ':')
+        return 0;                           // argument indices aren't supported
+    ++i;
+    bool aligned {false};
+    if (s[i] != '\0' && s[i] != '{' && s[i] != '}' && is_align(s[i + 1])) {
+        f.spec = apply_align(f.spec.setfill(s[i]), s[i + 1]);
+        aligned = true;
+        i += 2;
+    } else if (is_align(s[i])) {
+        f.spec = apply_align(f.spec, s[i]);
+        aligned = true;
+        ++i;
+    }
+    if (s[i] == '+') {
+        f.spec = f.spec.showpos();
+        ++i;
+    } else if (s[i] == '-') {
+        ++i;
+    }
+    if (s[i] == '#') {
+        f.spec = f.spec.showbase();
+        ++i;
+    }
+    if (s[i] == '0') {
+        if (!aligned)
+            f.spec = f.spec.setfill('0').internal();
+        ++i;
+    }
+    int width {0};
+    while (is_digit(s[i]))
+        width = width * 10 + (s[i++] - '0');
+    f.spec = f.spec.setw(width);
+    if (s[i] == '.') {
+        ++i;
+        if (!is_digit(s[i]))
+            return 0;
+        int precision {0};
+        while (is_digit(s[i]))
+            precision = precision * 10 + (s[i++] - '0');
+        f.spec = f.spec.setprecision(precision);
+    }
+    if (s[i] == '}')
+        return i + 1;
+    switch (s[i]) {
+    case 'd': f.spec = f.spec.dec(); break;
+    case 'x': f.spec = f.spec.hex(); break;
+    case 'X': f.spec = f.spec.hex().uppercase(); break;
+    case 'o': f.spec = f.spec.oct(); break;
+    case 'f': f.spec = f.spec.fixed(); break;
+    case 'F': f.spec = f.spec.fixed().uppercase(); break;
+    case 'e': f.spec = f.spec.scientific(); break;
+    case 'E': f.spec = f.spec.scientific().uppercase(); break;
+    case 'g': break;
+    case 'G': f.spec = f.spec.uppercase(); break;
+    case 's': f.spec = f.spec.boolalpha(); break;
+    default: return 0;                      // unknown type
+    }
+    f.type = s[i++];
+    return s[i] == '}' ? i + 1 : 0;
+}
+
+template <std::size_t N, std::size_t L>
+constexpr parsed_layout<N, L> parse_layout(const char *s) {
+    parsed_layout<N, L> out {};
+    std::size_t i {0};
+    std::size_t n {0};
+    std::size_t segment {0};
+    while (s[i] != '\0') {
+        char c = s[i];
+        if (c == '{' && s[i + 1] == '{') {
+            out.text[out.text_size++] = '{';
+            i += 2;
+        } else if (c == '}' && s[i + 1] == '}') {
+            out.text[out.text_size++] = '}';
+            i += 2;
+        } else if (c == '}') {
+            out.error = layout_errc::unmatched_close;
+            out.error_pos = i;
+            return out;
+        } else if (c == '{') {
+            layout_field f {};
+            f.text_begin = segment;
+            f.text_size = out.text_size - segment;
+            std::size_t next = parse_field_spec(s, i + 1, f);
+            if (next == 0) {
+                std::size_t close = std::string_view {s + i + 1}.find_first_of("{}");
+                out.error = close != std::string_view::npos && s[i + 1 + close] == '}'
+                          ? layout_errc::bad_spec : layout_errc::unmatched_open;
+                out.error_pos = i;
+                return out;
+            }
+            out.fields[n++] = f;
+            segment = out.text_size;
+            i = next;
+        } else {
+            out.text[out.text_size++] = c;
+            ++i;
+        }
+    }
+    out.tail_begin = segment;
+    return out;
+}
+
+template <typename T>
+constexpr bool is_text_v = std::is_convertible_v<const T &, std::string_view>;
+
+// Can an argument of type T go in a field of this type?
+template <typename T>
+constexpr bool field_accepts(char type) {
+    using U = std::decay_t<T>;
+    switch (type) {
+    case '\0':
+        return true;
+    case 'd': case 'x': case 'X': case 'o':
+        return std::is_integral_v<U> && !std::is_same_v<U, bool> && !std::is_same_v<U, char>;
+    case 'f': case 'F': case 'e': case 'E': case 'g': case 'G':
+        return std::is_floating_point_v<U>;
+    case 's':
+        return is_text_v<U> || std::is_same_v<U, bool>;
+    default:
+        return false;
+    }
+}
+
+// Largest output of one field, or 0 when unbounded
+template <typename T>
+constexpr std::size_t field_max_size(const format_spec &spec) {
+    using U = std::decay_t<T>;
+    std::size_t n {0};
+    if constexpr (std::is_same_v<U, bool>) {
+        n = 5;
+    } else if constexpr (std::is_same_v<U, char>) {
+        n = 1;
+    } else if constexpr (std::is_integral_v<U>) {
+        constexpr std::size_t bits = sizeof(U) * 8;
+        n = spec.base == 16 ? bits / 4 + 2
+          : spec.base == 8 ? (bits + 2) / 3 + 1
+          : static_cast<std::size_t>(std::numeric_limits<U>::digits10) + 2;
+    } else if constexpr (std::is_floating_point_v<U>) {
+        std::size_t precision = static_cast<std::size_t>(spec.precision);
+        n = spec.floatfield == float_style::fixed
+                ? static_cast<std::size_t>(std::numeric_limits<U>::max_exponent10) + precision + 3
+                : precision + 10;           // sign, point, e+XXXX
+    } else {
+        return 0;
+    }
+    std::size_t width = static_cast<std::size_t>(spec.width);
+    return n > width ? n : width;
+}
+
+}   // namespace detail
+
+template <const char *S>
+class layout {
+    static constexpr std::size_t max_fields = detail::count_fields(S);
+    static constexpr auto parsed = detail::parse_layout<max_fields, detail::c_length(S) + 1>(S);
+
+    static_assert(parsed.error != layout_errc::unmatched_open, "pg::layout: '{' without a matching '}'");
+    static_assert(parsed.error != layout_errc::unmatched_close, "pg::layout: '}' without a matching '{' (use '}}')");
+    static_assert(parsed.error != layout_errc::bad_spec, "pg::layout: malformed field spec");
+
+public:
+    static constexpr std::size_t field_count = max_fields;
+
+    static constexpr const layout_field &field(std::size_t i) { return parsed.fields[i]; }
+
+    /* Largest possible output for these argument types, 0 if unbounded */
+    template <typename... Args>
+    static constexpr std::size_t max_size() {
+        static_assert(sizeof...(Args) == field_count, "pg::layout: argument count doesn't match the layout");
+        return max_size_of<Args...>(std::index_sequence_for<Args...> {});
+    }
+
+    template <typename... Args>
+    static void write(format_writer &out, const Args &...args) {
+        static_assert(sizeof...(Args) == field_count, "pg::layout: argument count doesn't match the layout");
+        if constexpr (sizeof...(Args) == field_count) {
+            static_assert(types_match<Args...>(std::index_sequence_for<Args...> {}),
+                          "pg::layout: an argument doesn't match its field type");
+            constexpr std::size_t reserve = max_size<Args...>();
+            if constexpr (reserve > 0)
+                out.reserve(reserve);
+            write_fields(out, std::index_sequence_for<Args...> {}, args...);
+            out.append(text(parsed.tail_begin, parsed.text_size - parsed.tail_begin));
+        }
+    }
+
+private:
+    static constexpr std::string_view text(std::size_t begin, std::size_t size) {
+        return std::string_view {parsed.text.data() + begin, size};
+    }
+
+    template <typename... Args, std::size_t... I>
+    static constexpr bool types_match(std::index_sequence<I...>) {
+        return (detail::field_accepts<Args>(parsed.fields[I].type) && ...);
+    }
+
+    template <typename... Args, std::size_t... I>
+    static constexpr std::size_t max_size_of(std::index_sequence<I...>) {
+        bool bounded {((detail::field_max_size<Args>(parsed.fields[I].spec) != 0) && ...)};
+        return bounded ? (parsed.text_size + ... + detail::field_max_size<Args>(parsed.fields[I].spec)) : 0;
+    }
+
+    template <std::size_t... I, typename... Args>
+    static void write_fields(format_writer &out, std::index_sequence<I...>, const Args &...args) {
+        ((out.append(text(parsed.fields[I].text_begin, parsed.fields[I].text_size)),
+          write_one<I>(out, args)), ...);
+    }
+
+    template <std::size_t I, typename T>
+    static void write_one(format_writer &out, const T &value) {
+        constexpr format_spec spec = parsed.fields[I].spec;
+        if constexpr (detail::is_text_v<T>)
+            out.write(std::string_view {value}, spec);
+        else
+            out.write(value, spec);
+    }
+};
+
+}   // namespace pg
+
+#endif  // PG_FORMAT_LAYOUT_H
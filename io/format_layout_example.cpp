@@ -0,0 +1,129 @@
+/**
+@file format_layout_example.cpp
+
+@brief
+    The setw/setfill table layouts of advanced_input_output.cpp written as compile-time
+    layouts (format_layout.h).
+
+@par
+    Each layout string is parsed by the compiler; a typo in a layout, a wrong argument
+    count or a wrong argument type is a build error (see the commented-out lines).
+    Checks (exit code 1 on any mismatch):
+        * every demo row equals the output shown in its comment
+        * the format_spec loop and the layout<> loop of the benchmark write the same bytes
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "format_layout.h"
+
+/* FNV-1a, continued over consecutive pieces of output */
+static std::uint64_t checksum(std::uint64_t h, std::string_view bytes) {
+    for (unsigned char c : bytes)
+        h = (h ^ c) * 1099511628211ull;
+    return h;
+}
+
+/* Layout strings need static storage to be template arguments */
+static constexpr char right_10[] = "{:>10}{}\n";
+static constexpr char fill_star_dash[] = "{:*>10}{:->10}{:->15}\n";
+static constexpr char left_right[] = "{:<10}{:>10}{:>15}\n";
+static constexpr char money_row[] = "|{:>6d}|{:*>12.2f}|{:-<10}|{:#10x}|\n";
+// static constexpr char typo[] = "{:*>10.f}";     // error: malformed field spec
+
+int main() {
+    pg::format_writer out {};
+    double num6 {1234.5678};
+    std::string hello {"Hello"};
+    bool all_ok {true};
+    auto expect = [&](std::string_view want) {
+        all_ok = all_ok && out.view() == want;
+        out.flush(std::cout);
+    };
+
+    /* Field Width, Alignment & Fill */
+    pg::layout<right_10>::write(out, num6, hello);
+    expect("   1234.57Hello\n");
+    /*
+    1234567890123456789012345678901234567890
+       1234.57Hello
+    */
+    pg::layout<fill_star_dash>::write(out, num6, hello, hello);
+    expect("***1234.57-----Hello----------Hello\n");
+    /*
+    1234567890123456789012345678901234567890
+    ***1234.57-----Hello----------Hello
+    */
+    pg::layout<left_right>::write(out, num6, hello, hello);
+    expect("1234.57        Hello          Hello\n");
+    /*
+    1234567890123456789012345678901234567890
+    1234.57        Hello          Hello
+    */
+    // pg::layout<left_right>::write(out, num6, hello);             // error: argument count
+    // pg::layout<money_row>::write(out, 1, "x", "y", 4);           // error: "x" for {:*>12.2f}
+
+    /* An upper bound on the output size is known when every field is a number */
+    constexpr std::size_t row_max = pg::layout<money_row>::max_size<int, double, char, unsigned>();
+    std::cout << "money_row needs at most " << row_max << " bytes" << std::endl;
+    pg::layout<money_row>::write(out, 42, 1234.5678, 'x', 255u);   // |    42|*****1234.57|x---------|      0xff|
+    expect("|    42|*****1234.57|x---------|      0xff|\n");
+
+    /* Benchmark: runtime specs vs compile-time layout */
+    const int rows {5'000'000};
+    constexpr auto id_spec = pg::format_spec {}.setw(6);
+    constexpr auto price_spec = pg::format_spec {}.setw(12).setfill('*').fixed().setprecision(2);
+    constexpr auto hex_spec = pg::format_spec {}.setw(10).hex().showbase();
+    std::size_t bytes {0};
+    std::uint64_t sum_spec {14695981039346656037ull}, sum_layout {sum_spec};
+    auto drain = [&](std::uint64_t &sum) {
+        bytes += out.size();
+        sum = checksum(sum, out.view());
+        out.clear();
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i {0}; i < rows; ++i) {
+        out.append("|").write(i, id_spec).append("|").write(i * 0.5, price_spec)
+           .append("|").write('x', pg::format_spec {}.setw(10).setfill('-').left())
+           .append("|").write(static_cast<unsigned>(i), hex_spec).append("|\n");
+        if (out.size() > 60 * 1024)
+            drain(sum_spec);
+    }
+    drain(sum_spec);
+    double s_spec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int i {0}; i < rows; ++i) {
+        pg::layout<money_row>::write(out, i, i * 0.5, 'x', static_cast<unsigned>(i));
+        if (out.size() > 60 * 1024)
+            drain(sum_layout);
+    }
+    drain(sum_layout);
+    double s_layout = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "format_spec calls: " << std::setw(12) << rows / s_spec << " rows/s" << std::endl
+              << "layout<>:          " << std::setw(12) << rows / s_layout << " rows/s" << std::endl
+              << "(" << bytes << " bytes formatted)" << std::endl;
+
+    all_ok = all_ok && sum_spec == sum_layout;
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,232 @@
+/**
+@file format_writer.h
+
+@brief
+    Formatted output without stream state
+        value + format_spec ===> std::to_chars ===> reusable byte buffer ===> ostream / FILE*
+
+@par
+    Why not <iomanip> on std::cout:
+        * Manipulators change sticky flags on the stream; every value must set and reset them.
+        * Every << goes through the stream's locale and sentry.
+        * format_writer takes the options per call and never touches any stream state.
+    format_spec (names follow <iomanip>, each returns a new spec so they chain):
+        setw(n), setfill(c)                 -> field width and fill character
+        left(), right(), internal()         -> alignment (internal pads after sign / base)
+        center()                            -> centered, extra fill goes right (no iostream equivalent)
+        dec(), hex(), oct()                 -> integer base
+        showbase(), showpos(), uppercase()  -> 0x / + / upper-case digits and exponent
+        setprecision(n), fixed(), scientific() -> floating point style like std::fixed etc.
+        boolalpha()                         -> true/false instead of 1/0
+    Usage:
+        constexpr auto money = pg::format_spec {}.setw(10).setfill('*').fixed().setprecision(2);
+        pg::format_writer out {};
+        out.write(1234.5678, money).write("Hello", pg::format_spec {}.setw(10).left()).newline();
+        out.flush(std::cout);               // ***1234.57Hello
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_FORMAT_WRITER_H
+#define PG_FORMAT_WRITER_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace pg {
+
+enum class align { right, left, internal, center };
+enum class float_style { general, fixed, scientific };
+
+struct format_spec {
+    int width {0};
+    char fill {' '};
+    align adjust {align::right};
+    int base {10};
+    int precision {6};
+    float_style floatfield {float_style::general};
+    bool show_pos {false};
+    bool show_base {false};
+    bool upper {false};
+    bool bool_alpha {false};
+
+    constexpr format_spec setw(int n) const { format_spec s {*this}; s.width = n; return s; }
+    constexpr format_spec setfill(char c) const { format_spec s {*this}; s.fill = c; return s; }
+    constexpr format_spec left() const { format_spec s {*this}; s.adjust = align::left; return s; }
+    constexpr format_spec right() const { format_spec s {*this}; s.adjust = align::right; return s; }
+    constexpr format_spec internal() const { format_spec s {*this}; s.adjust = align::internal; return s; }
+    constexpr format_spec center() const { format_spec s {*this}; s.adjust = align::center; return s; }
+    constexpr format_spec dec() const { format_spec s {*this}; s.base = 10; return s; }
+    constexpr format_spec hex() const { format_spec s {*this}; s.base = 16; return s; }
+    constexpr format_spec oct() const { format_spec s {*this}; s.base = 8; return s; }
+    constexpr format_spec showbase() const { format_spec s {*this}; s.show_base = true; return s; }
+    constexpr format_spec showpos() const { format_spec s {*this}; s.show_pos = true; return s; }
+    constexpr format_spec uppercase() const { format_spec s {*this}; s.upper = true; return s; }
+    constexpr format_spec setprecision(int n) const { format_spec s {*this}; s.precision = n; return s; }
+    constexpr format_spec fixed() const { format_spec s {*this}; s.floatfield = float_style::fixed; return s; }
+    constexpr format_spec scientific() const { format_spec s {*this}; s.floatfield = float_style::scientific; return s; }
+    constexpr format_spec boolalpha() const { format_spec s {*this}; s.bool_alpha = true; return s; }
+};
+
+class format_writer {
+public:
+    explicit format_writer(std::size_t reserve = 64 * 1024) { buf_.reserve(reserve); }
+
+    /* Integers */
+    template <typename T>
+    std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool> && !std::is_same_v<T, char>,
+                     format_writer &>
+    write(T value, const format_spec &spec = {}) {
+        char digits[72];
+        char *last = digits + sizeof digits;
+        std::to_chars_result r {};
+        if constexpr (std::is_signed_v<T>) {
+            if (spec.base == 10)
+                r = std::to_chars(digits, last, static_cast<long long>(value));
+            else                                // iostreams print negatives as unsigned in hex/oct
+                r = std::to_chars(digits, last,
+                                  static_cast<unsigned long long>(static_cast<std::make_unsigned_t<T>>(value)),
+                                  spec.base);
+        } else {
+            r = std::to_chars(digits, last, static_cast<unsigned long long>(value), spec.base);
+        }
+        std::string_view body {digits, static_cast<std::size_t>(r.ptr - digits)};
+        std::string_view prefix {};
+        if (!body.empty() && body.front() == '-') {
+            prefix = "-";
+            body.remove_prefix(1);
+        } else if (spec.show_pos && spec.base == 10 && std::is_signed_v<T>) {
+            prefix = "+";
+        } else if (spec.show_base && spec.base != 10 && value != 0) {    // no base shown for 0
+            prefix = spec.base == 16 ? (spec.upper ? "0X" : "0x") : "0";
+        }
+        if (spec.upper && spec.base == 16)
+            upper_case(digits + (body.data() - digits), body.size());
+        return pad(prefix, body, spec);
+    }
+
+    /* Floating point */
+    template <typename T>
+    std::enable_if_t<std::is_floating_point_v<T>, format_writer &>
+    write(T value, const format_spec &spec = {}) {
+        char digits[400];
+        std::chars_format style = spec.floatfield == float_style::fixed ? std::chars_format::fixed
+                                : spec.floatfield == float_style::scientific ? std::chars_format::scientific
+                                : std::chars_format::general;
+        int precision = spec.precision;
+        if (style == std::chars_format::general && precision == 0)
+            precision = 1;                      // %g treats 0 as 1, like iostreams
+        char *first = digits;
+        std::to_chars_result r = std::to_chars(first, digits + sizeof digits, value, style, precision);
+        std::string big {};
+        while (r.ec != std::errc {}) {          // large fixed values or precisions: retry on the heap
+            big.resize(big.empty() ? sizeof digits + static_cast<std::size_t>(precision) : big.size() * 2);
+            first = big.data();
+            r = std::to_chars(first, first + big.size(), value, style, precision);
+        }
+        std::string_view body {first, static_cast<std::size_t>(r.ptr - first)};
+        std::string_view prefix {};
+        if (!body.empty() && body.front() == '-') {
+            prefix = "-";
+            body.remove_prefix(1);
+        } else if (spec.show_pos) {
+            prefix = "+";
+        }
+        if (spec.upper)
+            upper_case(first + (body.data() - first), body.size());
+        return pad(prefix, body, spec);
+    }
+
+    /* Text */
+    format_writer &write(std::string_view text, const format_spec &spec = {}) {
+        return pad({}, text, spec);
+    }
+
+    format_writer &write(const char *text, const format_spec &spec = {}) {
+        return write(std::string_view {text}, spec);
+    }
+
+    format_writer &write(char c, const format_spec &spec = {}) {
+        return pad({}, std::string_view {&c, 1}, spec);
+    }
+
+    format_writer &write(bool value, const format_spec &spec = {}) {
+        if (spec.bool_alpha)
+            return pad({}, value ? "true" : "false", spec);
+        return pad({}, value ? "1" : "0", spec);
+    }
+
+    /* Raw text, no padding */
+    format_writer &append(std::string_view text) {
+        buf_.append(text.data(), text.size());
+        return *this;
+    }
+
+    format_writer &newline() {
+        buf_.push_back('\n');
+        return *this;
+    }
+
+    std::string_view view() const { return buf_; }
+    std::size_t size() const { return buf_.size(); }
+    void clear() { buf_.clear(); }          // keeps the capacity for the next batch
+    void reserve(std::size_t extra) { buf_.reserve(buf_.size() + extra); }
+
+    /* Write out the buffered text and clear it */
+    void flush(std::ostream &os) {
+        os.write(buf_.data(), static_cast<std::streamsize>(buf_.size()));
+        buf_.clear();
+    }
+
+    void flush(std::FILE *file) {
+        std::fwrite(buf_.data(), 1, buf_.size(), file);
+        buf_.clear();
+    }
+
+private:
+    static void upper_case(char *p, std::size_t n) {
+        for (std::size_t i {0}; i < n; ++i)
+            if (p[i] >= 'a' && p[i] <= 'z')
+                p[i] = static_cast<char>(p[i] - 'a' + 'A');
+    }
+
+    format_writer &pad(std::string_view prefix, std::string_view body, const format_spec &spec) {
+        std::size_t len {prefix.size() + body.size()};
+        std::size_t fill_count {spec.width > 0 && static_cast<std::size_t>(spec.width) > len
+                                    ? static_cast<std::size_t>(spec.width) - len : 0};
+        if (spec.adjust == align::right)
+            buf_.append(fill_count, spec.fill);
+        if (spec.adjust == align::center)
+            buf_.append(fill_count / 2, spec.fill);
+        buf_.append(prefix.data(), prefix.size());
+        if (spec.adjust == align::internal)
+            buf_.append(fill_count, spec.fill);
+        buf_.append(body.data(), body.size());
+        if (spec.adjust == align::left)
+            buf_.append(fill_count, spec.fill);
+        if (spec.adjust == align::center)
+            buf_.append(fill_count - fill_count / 2, spec.fill);
+        return *this;
+    }
+
+    std::string buf_;
+};
+
+}   // namespace pg
+
+#endif  // PG_FORMAT_WRITER_H
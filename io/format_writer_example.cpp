@@ -0,0 +1,137 @@
+/**
+@file format_writer_example.cpp
+
+@brief
+    The advanced_input_output.cpp manipulator demos redone with format_writer.h,
+    plus a rows/sec benchmark of tabular output against std::cout-style manipulator chains.
+
+@par
+    Each demo line is printed twice: once with <iomanip>, once with pg::format_writer.
+    The benchmark formats the same table with both and checks the bytes are identical.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "format_writer.h"
+
+struct row {
+    int id;
+    double price;
+    std::string name;
+};
+
+/* One table row with manipulators, resetting the sticky flags afterwards */
+static void put_row(std::ostream &os, const row &r) {
+    os << std::setw(8) << std::setfill(' ') << std::right << r.id
+       << std::setw(12) << std::setfill('*') << std::fixed << std::setprecision(2) << r.price
+       << std::setw(10) << std::setfill('-') << std::left << r.name
+       << std::setw(10) << std::setfill(' ') << std::right << std::hex << std::showbase << r.id
+       << '\n';
+    os << std::dec << std::noshowbase << std::resetiosflags(std::ios::floatfield);
+}
+
+/* The same row with per-call format specs */
+static void put_row(pg::format_writer &out, const row &r) {
+    constexpr auto id_spec = pg::format_spec {}.setw(8);
+    constexpr auto price_spec = pg::format_spec {}.setw(12).setfill('*').fixed().setprecision(2);
+    constexpr auto name_spec = pg::format_spec {}.setw(10).setfill('-').left();
+    constexpr auto hex_spec = pg::format_spec {}.setw(10).hex().showbase();
+    out.write(r.id, id_spec)
+       .write(r.price, price_spec)
+       .write(r.name, name_spec)
+       .write(r.id, hex_spec)
+       .newline();
+}
+
+int main() {
+    pg::format_writer out {};
+
+    /* Formatting Integer Types */
+    int num {255};
+    std::cout << std::hex << std::showbase << std::uppercase << num << std::endl;   // 0XFF
+    std::cout << std::dec << std::noshowbase << std::nouppercase;
+    out.write(num, pg::format_spec {}.hex().showbase().uppercase()).newline();        // 0XFF
+    out.write(num, pg::format_spec {}.oct().showbase()).newline();                    // 0377
+    out.write(num, pg::format_spec {}.showpos()).newline();                           // +255
+
+    /* Floating Point Types Precisions */
+    double num3 {123456789.987654321};
+    out.write(num3).newline();                                                        // 1.23457e+08
+    out.write(num3, pg::format_spec {}.setprecision(9)).newline();                    // 123456790
+    out.write(num3, pg::format_spec {}.fixed().setprecision(3)).newline();            // 123456789.988
+    out.write(num3, pg::format_spec {}.scientific().setprecision(3)).newline();       // 1.235e+08
+    out.write(num3, pg::format_spec {}.fixed().setprecision(3).showpos()).newline();  // +123456789.988
+
+    /* Field Width, Alignment & Fill */
+    double num6 {1234.5678};
+    std::string hello {"Hello"};
+    out.write(num6, pg::format_spec {}.setw(10).setfill('*'))
+       .write(hello, pg::format_spec {}.setw(10).setfill('-'))
+       .write(hello, pg::format_spec {}.setw(15).setfill('-'))
+       .newline();                                                                    // ***1234.57-----Hello----------Hello
+    out.write(-42, pg::format_spec {}.setw(8).setfill('0').internal()).newline();     // -0000042
+    out.write(true, pg::format_spec {}.boolalpha()).newline();                        // true
+    out.flush(std::cout);
+
+    /* Both writers must produce the same bytes */
+    std::ostringstream expected {};
+    pg::format_writer check {};
+    for (int i {-50}; i < 50; ++i) {
+        row r {i, i * 3.14159, "item" + std::to_string(i)};
+        put_row(expected, r);
+        put_row(check, r);
+    }
+    bool same = expected.str() == check.view();
+
+    /* Values wider than the stack buffer: 1e308 fixed with 100 decimals */
+    for (double big : {1e308, -1.7976931348623157e308}) {
+        std::ostringstream big_expected {};
+        big_expected << std::fixed << std::setprecision(100) << big;
+        pg::format_writer big_check {};
+        big_check.write(big, pg::format_spec {}.fixed().setprecision(100));
+        same = same && big_expected.str() == big_check.view();
+    }
+    std::cout << "results match: " << std::boolalpha << same << std::endl;
+
+    /* Benchmark: rows/sec into /dev/null */
+    const int rows {2'000'000};
+    std::ofstream sink {"/dev/null"};
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i {0}; i < rows; ++i)
+        put_row(sink, row {i, i * 0.5, "widget"});
+    sink.flush();
+    double s_stream = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    pg::format_writer table {};
+    for (int i {0}; i < rows; ++i) {
+        put_row(table, row {i, i * 0.5, "widget"});
+        if (table.size() > 60 * 1024)
+            table.flush(sink);
+    }
+    table.flush(sink);
+    sink.flush();
+    double s_writer = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "iomanip:       " << std::setw(12) << rows / s_stream << " rows/s" << std::endl
+              << "format_writer: " << std::setw(12) << rows / s_writer << " rows/s" << std::endl;
+    return same ? 0 : 1;
+}
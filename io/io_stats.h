@@ -0,0 +1,584 @@
+/**
+@file io_stats.h
+
+@brief
+    I/O instrumentation: per-stream counters and latency histograms
+        instrumented_ifstream / instrumented_ofstream / instrumented_stdio
+            ===> instrumented_streambuf (fd_streambuf.h: read()/write() on a descriptor)
+            ===> stream_stats (counters + open/read/write histograms)
+            ===> io_stats::global() ===> text / JSON snapshot, on demand or at exit
+
+@par
+    Why:
+        * A failed stream in file_input_output.cpp prints "File open error" and nothing else.
+          Nobody can tell how many bytes or lines a stream moved, how many syscalls it made,
+          or whether a slow run came from one slow input.
+    Recorded per stream name (streams opened with the same name add up):
+        opens, open failures (with the last errno), bytes and records (lines) read and written,
+        read()/write() calls, buffer refills, flushes, errors,
+        open/read/write latency histograms.
+    Histograms (latency_histogram):
+        * HDR-style log-linear buckets: exact below 32 ns, then 32 buckets per power of two
+          (about 3% relative error) up to 2^64 ns, with no allocation and no locks.
+        * Reported: count, min, mean, p50, p90, p99, p99.9, max.
+    Cost:
+        * The counters are only touched once per buffer refill or flush (64 KiB by default),
+          never per character; the get/put areas of std::streambuf stay inline.
+        * Disabled at run time (io_stats::set_enabled(false), or PG_IO_STATS_DISABLE in the
+          environment): streams opened after that get no stats and skip the clock reads.
+        * Disabled at compile time (-DPG_IO_STATS=0): all recording code compiles out.
+        * The counters show what the stream really does: std::cin is tied to std::cout, so
+          under instrumented_stdio every read of std::cin shows up as a flush of std::cout
+          (std::cin.tie(nullptr) removes them).
+    Export:
+        io_stats::global().write_text(std::cerr) / write_json(out)
+        io_stats::global().dump_at_exit("io_stats.json")   ("-" = stderr, *.json = JSON)
+        PG_IO_STATS_DUMP=<path> in the environment does the same without code changes.
+    Usage:
+        pg::instrumented_ifstream in_file {"../myfile.txt"};
+        if (!in_file) {
+            std::cerr << "File open error: " << std::strerror(in_file.error()) << std::endl;
+            return 1;
+        }
+        std::string line {};
+        while (std::getline(in_file, line))
+            std::cout << line << std::endl;
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_IO_STATS_H
+#define PG_IO_STATS_H
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "fd_streambuf.h"
+#include "newline_scan.h"
+
+#ifndef PG_IO_STATS
+#define PG_IO_STATS 1               // 0 compiles all recording out
+#endif
+
+namespace pg {
+
+/* Lock-free log-linear histogram of nanosecond values */
+class latency_histogram {
+public:
+    static constexpr int sub_bits {5};
+    static constexpr std::size_t sub_count {std::size_t {1} << sub_bits};     // buckets per power of two
+    static constexpr std::size_t bucket_count {(64 - sub_bits + 1) * sub_count};
+
+    void record(std::uint64_t ns) {
+        counts_[index_of(ns)].fetch_add(1, std::memory_order_relaxed);
+        count_.fetch_add(1, std::memory_order_relaxed);
+        sum_.fetch_add(ns, std::memory_order_relaxed);
+        std::uint64_t seen = max_.load(std::memory_order_relaxed);
+        while (ns > seen && !max_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+        seen = min_.load(std::memory_order_relaxed);
+        while (ns < seen && !min_.compare_exchange_weak(seen, ns, std::memory_order_relaxed)) {
+        }
+    }
+
+    std::uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    std::uint64_t max() const { return max_.load(std::memory_order_relaxed); }
+    std::uint64_t min() const { return count() ? min_.load(std::memory_order_relaxed) : 0; }
+    double mean() const { return count() ? double(sum_.load(std::memory_order_relaxed)) / double(count()) : 0.0; }
+
+    /* Highest value in the bucket that holds the p-th percentile (0 < p <= 100) */
+    std::uint64_t percentile(double p) const {
+        std::uint64_t total = count();
+        if (total == 0)
+            return 0;
+        std::uint64_t rank = static_cast<std::uint64_t>(p / 100.0 * double(total) + 0.5);
+        rank = rank < 1 ? 1 : rank > total ? total : rank;
+        std::uint64_t seen {0};
+        for (std::size_t i {0}; i < bucket_count; ++i) {
+            seen += counts_[i].load(std::memory_order_relaxed);
+            if (seen >= rank)
+                return std::min(upper_bound(i), max());
+        }
+        return max();
+    }
+
+    void reset() {
+        for (auto &c : counts_)
+            c.store(0, std::memory_order_relaxed);
+        count_.store(0, std::memory_order_relaxed);
+        sum_.store(0, std::memory_order_relaxed);
+        max_.store(0, std::memory_order_relaxed);
+        min_.store(UINT64_MAX, std::memory_order_relaxed);
+    }
+
+    static std::size_t index_of(std::uint64_t v) {
+        if (v < sub_count)
+            return static_cast<std::size_t>(v);
+        int shift = 63 - __builtin_clzll(v) - sub_bits;     // v >> shift is in [sub_count, 2 * sub_count)
+        return static_cast<std::size_t>(shift) * sub_count + static_cast<std::size_t>(v >> shift);
+    }
+
+    static std::uint64_t upper_bound(std::size_t index) {
+        if (index < sub_count)
+            return index;
+        std::size_t shift = index / sub_count - 1;
+        std::uint64_t top = index % sub_count + sub_count;
+        return ((top + 1) << shift) - 1;
+    }
+
+private:
+    std::atomic<std::uint64_t> counts_[bucket_count] {};
+    std::atomic<std::uint64_t> count_ {0};
+    std::atomic<std::uint64_t> sum_ {0};
+    std::atomic<std::uint64_t> max_ {0};
+    std::atomic<std::uint64_t> min_ {UINT64_MAX};
+};
+
+struct stream_stats {
+    explicit stream_stats(std::string stream_name) : name {std::move(stream_name)} {}
+
+    const std::string name;
+    std::atomic<std::uint64_t> opens {0};
+    std::atomic<std::uint64_t> open_failures {0};
+    std::atomic<int> last_errno {0};
+    std::atomic<std::uint64_t> bytes_read {0};
+    std::atomic<std::uint64_t> records_read {0};        // '\n' read
+    std::atomic<std::uint64_t> read_calls {0};
+    std::atomic<std::uint64_t> refills {0};             // get area refilled by underflow()
+    std::atomic<std::uint64_t> bytes_written {0};
+    std::atomic<std::uint64_t> records_written {0};     // '\n' written
+    std::atomic<std::uint64_t> write_calls {0};
+    std::atomic<std::uint64_t> flushes {0};
+    std::atomic<std::uint64_t> errors {0};
+    latency_histogram open_ns {};
+    latency_histogram read_ns {};
+    latency_histogram write_ns {};
+
+    void add(std::atomic<std::uint64_t> &counter, std::uint64_t n) { counter.fetch_add(n, std::memory_order_relaxed); }
+};
+
+namespace detail {
+
+inline std::uint64_t now_ns() {
+    return static_cast<std::uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+            .count());
+}
+
+inline void json_string(std::ostream &os, std::string_view s) {
+    os << '"';
+    for (char c : s) {
+        if (c == '"' || c == '\\')
+            os << '\\' << c;
+        else if (static_cast<unsigned char>(c) < 0x20) {
+            char escaped[8];
+            std::snprintf(escaped, sizeof escaped, "\\u%04x", static_cast<unsigned>(c));
+            os << escaped;
+        } else
+            os << c;
+    }
+    os << '"';
+}
+
+inline void json_histogram(std::ostream &os, const latency_histogram &h) {
+    os << "{\"count\": " << h.count() << ", \"min\": " << h.min() << ", \"mean\": " << std::fixed
+       << std::setprecision(1) << h.mean() << ", \"p50\": " << h.percentile(50) << ", \"p90\": " << h.percentile(90)
+       << ", \"p99\": " << h.percentile(99) << ", \"p999\": " << h.percentile(99.9) << ", \"max\": " << h.max()
+       << "}";
+}
+
+inline void text_histogram(std::ostream &os, const latency_histogram &h) {
+    auto us = [](std::uint64_t ns) { return double(ns) / 1000.0; };
+    os << std::fixed << std::setprecision(1) << "p50 " << us(h.percentile(50)) << "us  p90 " << us(h.percentile(90))
+       << "us  p99 " << us(h.percentile(99)) << "us  max " << us(h.max()) << "us";
+}
+
+}   // namespace detail
+
+/* Registry of every instrumented stream in the process */
+class io_stats {
+public:
+    enum class format { text, json };
+
+    /* Never destroyed, so streams closed and snapshots taken during exit still find it */
+    static io_stats &global() {
+        static io_stats *stats = new io_stats {};
+        return *stats;
+    }
+
+    static bool enabled() { return PG_IO_STATS && enabled_flag().load(std::memory_order_relaxed); }
+    static void set_enabled(bool on) { enabled_flag().store(on, std::memory_order_relaxed); }
+
+    /* Stats for a stream name, created on first use; nullptr while disabled */
+    stream_stats *track(std::string_view name) {
+        if (!enabled())
+            return nullptr;
+        std::lock_guard<std::mutex> lock {mutex_};
+        for (const auto &s : streams_) {
+            if (s->name == name)
+                return s.get();
+        }
+        streams_.push_back(std::make_unique<stream_stats>(std::string {name}));
+        return streams_.back().get();
+    }
+
+    void write_text(std::ostream &os) const {
+        std::lock_guard<std::mutex> lock {mutex_};
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        for (const auto &s : streams_) {
+            os << s->name;
+            if (s->opens) {
+                os << "\n  open   " << s->opens << " (" << s->open_failures << " failed";
+                if (s->open_failures)
+                    os << ", last: " << std::strerror(s->last_errno);
+                os << ")   ";
+                detail::text_histogram(os, s->open_ns);
+            }
+            if (s->read_calls) {
+                os << "\n  read   " << s->bytes_read << " bytes, " << s->records_read << " lines, " << s->read_calls
+                   << " calls, " << s->refills << " refills   ";
+                detail::text_histogram(os, s->read_ns);
+            }
+            if (s->write_calls) {
+                os << "\n  write  " << s->bytes_written << " bytes, " << s->records_written << " lines, "
+                   << s->write_calls << " calls, " << s->flushes << " flushes   ";
+                detail::text_histogram(os, s->write_ns);
+            }
+            if (s->errors)
+                os << "\n  errors " << s->errors;
+            os << "\n";
+        }
+        os.flags(flags);
+        os.precision(precision);
+        os.flush();
+    }
+
+    void write_json(std::ostream &os) const {
+        std::lock_guard<std::mutex> lock {mutex_};
+        std::ios::fmtflags flags = os.flags();
+        std::streamsize precision = os.precision();
+        os << "{\n  \"streams\": [";
+        for (std::size_t i {0}; i < streams_.size(); ++i) {
+            const stream_stats &s = *streams_[i];
+            os << (i ? ",\n" : "\n") << "    {\"name\": ";
+            detail::json_string(os, s.name);
+            os << ", \"opens\": " << s.opens << ", \"open_failures\": " << s.open_failures
+               << ", \"last_errno\": " << s.last_errno << ", \"bytes_read\": " << s.bytes_read
+               << ", \"records_read\": " << s.records_read << ", \"read_calls\": " << s.read_calls
+               << ", \"refills\": " << s.refills << ", \"bytes_written\": " << s.bytes_written
+               << ", \"records_written\": " << s.records_written << ", \"write_calls\": " << s.write_calls
+               << ", \"flushes\": " << s.flushes << ", \"errors\": " << s.errors << ",\n     \"open_ns\": ";
+            detail::json_histogram(os, s.open_ns);
+            os << ",\n     \"read_ns\": ";
+            detail::json_histogram(os, s.read_ns);
+            os << ",\n     \"write_ns\": ";
+            detail::json_histogram(os, s.write_ns);
+            os << "}";
+        }
+        os << "\n  ]\n}" << std::endl;
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    /* Snapshot to a file ("-" = stderr); JSON when the path ends in .json */
+    bool dump(const std::string &path) const {
+        format f = path.size() > 5 && path.compare(path.size() - 5, 5, ".json") == 0 ? format::json : format::text;
+        if (path == "-") {
+            write_text(std::cerr);
+            return true;
+        }
+        std::ofstream out_file {path};
+        if (!out_file)
+            return false;
+        if (f == format::json)
+            write_json(out_file);
+        else
+            write_text(out_file);
+        return static_cast<bool>(out_file);
+    }
+
+    /* Write a snapshot when the process exits normally */
+    void dump_at_exit(std::string path) {
+        std::lock_guard<std::mutex> lock {mutex_};
+        bool first = exit_path_.empty();
+        exit_path_ = std::move(path);
+        if (first)
+            std::atexit([] { global().dump(global().exit_path()); });
+    }
+
+    /* Forget all streams (streams still open keep their stats object alive until then) */
+    void reset() {
+        std::lock_guard<std::mutex> lock {mutex_};
+        for (auto &s : streams_)
+            retired_.push_back(std::move(s));
+        streams_.clear();
+    }
+
+private:
+    io_stats() {
+        if (std::getenv("PG_IO_STATS_DISABLE"))
+            set_enabled(false);
+        if (const char *path = std::getenv("PG_IO_STATS_DUMP"))
+            dump_at_exit(path);
+    }
+
+    static std::atomic<bool> &enabled_flag() {
+        static std::atomic<bool> flag {true};
+        return flag;
+    }
+
+    std::string exit_path() const {
+        std::lock_guard<std::mutex> lock {mutex_};
+        return exit_path_;
+    }
+
+    mutable std::mutex mutex_ {};
+    std::vector<std::unique_ptr<stream_stats>> streams_ {};
+    std::vector<std::unique_ptr<stream_stats>> retired_ {};
+    std::string exit_path_ {};
+};
+
+/* fd_streambuf that reports to a stream_stats (or to nothing) */
+class instrumented_streambuf : public fd_streambuf {
+public:
+    static constexpr std::size_t default_buffer_size {64 * 1024};
+
+    instrumented_streambuf() = default;
+
+    instrumented_streambuf(int fd, bool owns_fd, std::ios::openmode which, stream_stats *stats,
+                           std::size_t buffer_size = default_buffer_size) {
+        attach(fd, owns_fd, which, stats, buffer_size);
+    }
+
+    ~instrumented_streambuf() override { close(); }
+
+    /* which: std::ios::in reads, std::ios::out writes; false (error() set) if the buffer
+       can't be allocated */
+    bool attach(int fd, bool owns_fd, std::ios::openmode which, stream_stats *stats,
+                std::size_t buffer_size = default_buffer_size) {
+        close();
+        stats_ = stats;
+        return fd_streambuf::attach(fd, owns_fd, which, buffer_size ? buffer_size : 1);
+    }
+
+    /* Flush, then close the descriptor if owned; false if the flush or close failed.
+       A descriptor that isn't owned gets its unread input back (lseek), when it can seek. */
+    bool close() { return detach(); }
+
+    stream_stats *stats() const { return stats_; }
+
+protected:
+    ssize_t read_fd(char *p, std::size_t n) override {
+        if (!(PG_IO_STATS && stats_))
+            return fd_streambuf::read_fd(p, n);
+        std::uint64_t start = detail::now_ns();
+        ssize_t got = fd_streambuf::read_fd(p, n);
+        int e = errno;
+        stats_->read_ns.record(detail::now_ns() - start);
+        stats_->add(stats_->read_calls, 1);
+        if (got > 0) {
+            stats_->add(stats_->bytes_read, static_cast<std::uint64_t>(got));
+            stats_->add(stats_->records_read, count_byte(p, p + got, '\n'));
+        }
+        errno = e;
+        return got;
+    }
+
+    ssize_t write_fd(const char *p, std::size_t n) override {
+        if (!(PG_IO_STATS && stats_))
+            return fd_streambuf::write_fd(p, n);
+        std::uint64_t start = detail::now_ns();
+        ssize_t w = fd_streambuf::write_fd(p, n);
+        int e = errno;
+        stats_->write_ns.record(detail::now_ns() - start);
+        stats_->add(stats_->write_calls, 1);
+        if (w > 0) {
+            stats_->add(stats_->bytes_written, static_cast<std::uint64_t>(w));
+            stats_->add(stats_->records_written, count_byte(p, p + w, '\n'));
+        }
+        errno = e;
+        return w;
+    }
+
+    void on_refill() override {
+        if (PG_IO_STATS && stats_)
+            stats_->add(stats_->refills, 1);
+    }
+
+    void on_flush() override {
+        if (PG_IO_STATS && stats_)
+            stats_->add(stats_->flushes, 1);
+    }
+
+    void on_error() override {
+        if (PG_IO_STATS && stats_)
+            stats_->add(stats_->errors, 1);
+    }
+
+private:
+    stream_stats *stats_ {nullptr};
+};
+
+namespace detail {
+
+/* Opens path for a stream and records the open in stats; -1 on failure (errno set) */
+inline int instrumented_open(const std::string &path, int flags, stream_stats *stats) {
+    std::uint64_t start = PG_IO_STATS && stats ? now_ns() : 0;
+    int fd = ::open(path.c_str(), flags | O_CLOEXEC, 0666);
+    int e = errno;
+    if (PG_IO_STATS && stats) {
+        stats->open_ns.record(now_ns() - start);
+        stats->add(stats->opens, 1);
+        if (fd < 0) {
+            stats->add(stats->open_failures, 1);
+            stats->last_errno.store(e, std::memory_order_relaxed);
+        }
+    }
+    errno = e;
+    return fd;
+}
+
+}   // namespace detail
+
+/* Drop-in for std::ifstream (text reading: >>, getline, get) */
+class instrumented_ifstream : public std::istream {
+public:
+    instrumented_ifstream() : std::istream {nullptr} { init(&buf_); }
+
+    explicit instrumented_ifstream(const std::string &path, std::size_t buffer_size = instrumented_streambuf::default_buffer_size)
+        : instrumented_ifstream {} {
+        open(path, buffer_size);
+    }
+
+    /* name groups the stats, e.g. one name for all inputs of a kind; default is the path */
+    void open(const std::string &path, std::size_t buffer_size = instrumented_streambuf::default_buffer_size,
+              std::string_view name = {}) {
+        stream_stats *stats = io_stats::global().track(name.empty() ? std::string_view {path} : name);
+        int fd = detail::instrumented_open(path, detail::open_flags(std::ios::in), stats);
+        error_ = fd < 0 ? errno : 0;
+        if (fd < 0) {
+            setstate(std::ios::failbit);
+            return;
+        }
+        if (!buf_.attach(fd, true, std::ios::in, stats, buffer_size)) {
+            error_ = buf_.error();
+            setstate(std::ios::failbit);
+            return;
+        }
+        clear();
+    }
+
+    bool is_open() const { return buf_.is_open(); }
+    void close() {
+        if (!buf_.close())
+            setstate(std::ios::failbit);
+    }
+    int error() const { return error_; }        // errno of a failed open
+
+private:
+    instrumented_streambuf buf_ {};
+    int error_ {0};
+};
+
+/* Drop-in for std::ofstream that reports to io_stats (open modes: detail::open_flags) */
+class instrumented_ofstream : public std::ostream {
+public:
+    instrumented_ofstream() : std::ostream {nullptr} { init(&buf_); }
+
+    explicit instrumented_ofstream(const std::string &path, std::ios::openmode mode = std::ios::out,
+                                   std::size_t buffer_size = instrumented_streambuf::default_buffer_size)
+        : instrumented_ofstream {} {
+        open(path, mode, buffer_size);
+    }
+
+    void open(const std::string &path, std::ios::openmode mode = std::ios::out,
+              std::size_t buffer_size = instrumented_streambuf::default_buffer_size, std::string_view name = {}) {
+        stream_stats *stats = io_stats::global().track(name.empty() ? std::string_view {path} : name);
+        int fd = detail::instrumented_open(path, detail::open_flags(mode & ~std::ios::in), stats);
+        error_ = fd < 0 ? errno : 0;
+        if (fd < 0) {
+            setstate(std::ios::failbit);
+            return;
+        }
+        if (!buf_.attach(fd, true, (mode | std::ios::out) & ~std::ios::in, stats, buffer_size)) {
+            error_ = buf_.error();
+            setstate(std::ios::failbit);
+            return;
+        }
+        clear();
+    }
+
+    bool is_open() const { return buf_.is_open(); }
+    void close() {
+        if (!buf_.close())
+            setstate(std::ios::failbit);
+    }
+    int error() const { return error_; }
+
+private:
+    instrumented_streambuf buf_ {};
+    int error_ {0};
+};
+
+/* Routes std::cin / std::cout through instrumented buffers ("stdin" / "stdout") while alive.
+   Input read ahead into the buffer but not consumed is handed back to fd 0 at the end of the
+   scope when stdin is a file. A pipe or terminal can't take it back: with those, finish reading
+   std::cin inside the scope, or pass buffer_size 1 (one read() per character) so nothing is
+   read ahead. */
+class instrumented_stdio {
+public:
+    explicit instrumented_stdio(std::size_t buffer_size = instrumented_streambuf::default_buffer_size) {
+        std::cout.flush();
+        in_.attach(STDIN_FILENO, false, std::ios::in, io_stats::global().track("stdin"), buffer_size);
+        out_.attach(STDOUT_FILENO, false, std::ios::out, io_stats::global().track("stdout"), buffer_size);
+        old_in_ = std::cin.rdbuf(&in_);
+        old_out_ = std::cout.rdbuf(&out_);
+    }
+
+    instrumented_stdio(const instrumented_stdio &) = delete;
+    instrumented_stdio &operator=(const instrumented_stdio &) = delete;
+
+    ~instrumented_stdio() {
+        std::cout.flush();
+        std::cin.rdbuf(old_in_);
+        std::cout.rdbuf(old_out_);
+    }
+
+private:
+    instrumented_streambuf in_ {};
+    instrumented_streambuf out_ {};
+    std::streambuf *old_in_ {nullptr};
+    std::streambuf *old_out_ {nullptr};
+};
+
+}   // namespace pg
+
+#endif  // PG_IO_STATS_H
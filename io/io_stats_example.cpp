@@ -0,0 +1,238 @@
+/**
+@file io_stats_example.cpp
+
+@brief
+    The file_input_output.cpp loops on instrumented streams (io_stats.h): counters,
+    latency histograms, a failed open, and the text and JSON snapshots.
+
+@par
+    Loops (each on std::ifstream/std::ofstream and on the instrumented streams, results must match):
+        1. Reading a text file one line at a time (getline)
+        2. Reading name/num/total with >>
+        3. Copying a text file one line at a time
+    Timed: std::ifstream getline vs instrumented (stats on) vs instrumented (stats off).
+    instrumented_stdio: with stdin on a file, std::cin after the scope continues where the
+    scope stopped reading (the read-ahead is handed back).
+    Output: text snapshot on stdout, JSON snapshot in io_stats.json.
+    Run with PG_IO_STATS_DUMP=stats.json to get a snapshot at exit as well.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "io_stats.h"
+
+/* name num total lines, as read by file_input_output.cpp */
+static bool make_test_file(const std::string &path, std::size_t lines) {
+    std::ofstream out_file {path};
+    if (!out_file)
+        return false;
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    for (std::size_t i {0}; i < lines; ++i)
+        out_file << names[i % 4] << " " << i % 1000 << " " << double(i % 4096) * 0.25 << "\n";
+    return static_cast<bool>(out_file);
+}
+
+struct totals {
+    std::size_t lines {0};
+    std::size_t bytes {0};
+    double sum {0.0};
+    bool operator==(const totals &o) const { return lines == o.lines && bytes == o.bytes && sum == o.sum; }
+};
+
+/* Reading text file one line at a time */
+template <typename In>
+static totals read_lines(In &in_file) {
+    totals t {};
+    std::string line {};
+    while (std::getline(in_file, line)) {
+        ++t.lines;
+        t.bytes += line.size();
+    }
+    return t;
+}
+
+/* Reading from files using >> */
+template <typename In>
+static totals read_fields(In &in_file) {
+    totals t {};
+    std::string name {};
+    int num {};
+    double total {};
+    while (in_file >> name >> num >> total) {
+        ++t.lines;
+        t.bytes += name.size() + static_cast<std::size_t>(num);
+        t.sum += total;
+    }
+    return t;
+}
+
+/* Copying a text file one line at a time */
+template <typename In, typename Out>
+static void copy_lines(In &in_file, Out &out_file) {
+    std::string line {};
+    while (std::getline(in_file, line))
+        out_file << line << '\n';
+}
+
+static std::string slurp(const std::string &path) {
+    std::ifstream in_file {path};
+    std::stringstream ss {};
+    ss << in_file.rdbuf();
+    return ss.str();
+}
+
+/* fd 0 on `path`: one word through instrumented_stdio, the rest through the stock std::cin */
+static bool check_stdio_handback(const std::string &path) {
+    int file = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    int saved = ::dup(STDIN_FILENO);
+    if (file < 0 || saved < 0 || ::dup2(file, STDIN_FILENO) < 0)
+        return false;
+    ::close(file);
+    std::string first {}, second {};
+    {
+        pg::instrumented_stdio stdio {};
+        std::cin >> first;
+    }
+    std::cin >> second;
+    std::cin.clear();
+    ::dup2(saved, STDIN_FILENO);
+    ::close(saved);
+    std::ifstream in_file {path};
+    std::string want_first {}, want_second {};
+    in_file >> want_first >> want_second;
+    return first == want_first && second == want_second;
+}
+
+template <typename Body>
+static double seconds(Body body) {
+    auto start = std::chrono::steady_clock::now();
+    body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main() {
+    const std::string path {"io_stats_input.txt"};
+    const std::string copy_path {"io_stats_copy.txt"};
+    const std::size_t line_count {2'000'000};
+    if (!make_test_file(path, line_count)) {
+        std::cerr << "File create error" << std::endl;
+        return 1;
+    }
+    bool all_ok {true};
+
+    /* A failed open is counted, with its errno */
+    pg::instrumented_ifstream missing {"no_such_file.txt"};
+    bool open_failed = !missing && missing.error() == ENOENT;
+    if (!missing)
+        std::cerr << "File open error: " << std::strerror(missing.error()) << " (expected)" << std::endl;
+
+    /* Same results as the std streams */
+    totals expected_lines {}, got_lines {}, expected_fields {}, got_fields {};
+    {
+        std::ifstream warm_up {path};           // page cache
+        read_lines(warm_up);
+    }
+    double std_seconds = seconds([&] {
+        std::ifstream in_file {path};
+        expected_lines = read_lines(in_file);
+    });
+    double on_seconds = seconds([&] {
+        pg::instrumented_ifstream in_file {path};
+        got_lines = read_lines(in_file);
+    });
+    {
+        std::ifstream in_file {path};
+        expected_fields = read_fields(in_file);
+        pg::instrumented_ifstream in_file2 {path};
+        got_fields = read_fields(in_file2);
+    }
+    {
+        pg::instrumented_ifstream in_file {path};
+        pg::instrumented_ofstream out_file {copy_path};
+        if (!in_file || !out_file) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        copy_lines(in_file, out_file);
+    }
+    bool copied = slurp(copy_path) == slurp(path);
+
+    /* Stats off: the same streams, no counters and no clock reads */
+    pg::io_stats::set_enabled(false);
+    totals off_lines {};
+    double off_seconds = seconds([&] {
+        pg::instrumented_ifstream in_file {path};
+        off_lines = read_lines(in_file);
+    });
+    pg::io_stats::set_enabled(true);
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "getline, std::ifstream:            " << double(expected_lines.bytes) / std_seconds / 1e6 << " MB/s\n"
+              << "getline, instrumented (stats on):  " << double(got_lines.bytes) / on_seconds / 1e6 << " MB/s\n"
+              << "getline, instrumented (stats off): " << double(off_lines.bytes) / off_seconds / 1e6 << " MB/s\n"
+              << std::endl;
+
+    /* Counters agree with what was read and written */
+    bool counted {true};
+    if (pg::io_stats::enabled()) {              // not with -DPG_IO_STATS=0
+        pg::stream_stats *in_stats = pg::io_stats::global().track(path);
+        pg::stream_stats *out_stats = pg::io_stats::global().track(copy_path);
+        pg::stream_stats *missing_stats = pg::io_stats::global().track("no_such_file.txt");
+        std::uint64_t file_size = slurp(path).size();
+        counted = in_stats->opens == 3 && in_stats->bytes_read == 3 * file_size &&
+                  in_stats->records_read == 3 * line_count && in_stats->refills == in_stats->read_calls - 3 &&
+                  out_stats->bytes_written == file_size && out_stats->records_written == line_count &&
+                  missing_stats->open_failures == 1 && missing_stats->last_errno == ENOENT;
+    }
+
+    /* Histogram precision: 1..100000 ns, percentiles within one bucket (~3%) */
+    pg::latency_histogram h {};
+    for (std::uint64_t v {1}; v <= 100'000; ++v)
+        h.record(v);
+    auto near = [](std::uint64_t got, double want) { return double(got) >= want && double(got) <= want * 1.04; };
+    bool histogram = h.count() == 100'000 && h.min() == 1 && h.max() == 100'000 && near(h.percentile(50), 50'000) &&
+                     near(h.percentile(99), 99'000) && h.percentile(100) == 100'000;
+
+    bool handback = check_stdio_handback(path);
+
+    pg::io_stats::global().write_text(std::cout);
+    bool dumped = pg::io_stats::global().dump("io_stats.json");
+
+    std::cout << "\nfailed open recorded: " << std::boolalpha << open_failed << "\n"
+              << "getline results: " << (got_lines == expected_lines && off_lines == expected_lines) << "\n"
+              << ">> results: " << (got_fields == expected_fields) << "\n"
+              << "copy identical: " << copied << "\n"
+              << "counters: " << counted << "\n"
+              << "histogram percentiles: " << histogram << "\n"
+              << "stdin read-ahead handed back: " << handback << "\n"
+              << "json written: " << dumped << std::endl;
+    all_ok = open_failed && got_lines == expected_lines && off_lines == expected_lines &&
+             got_fields == expected_fields && copied && counted && histogram && handback && dumped;
+
+    std::remove(path.c_str());
+    std::remove(copy_path.c_str());
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,230 @@
+/**
+@file line_reader.h
+
+@brief
+    Zero-copy line reader
+        File ===> mmap (or large read() buffer) ===> std::string_view per line
+
+@par
+    Why not std::getline:
+        * std::getline(in_file, line) copies every line into a std::string (may allocate).
+        * line_reader hands out std::string_view lines pointing straight into the mapped file
+          (or into its own read buffer), so there is no per-line allocation or copy.
+        * Line ends are found with the vectorized pg::find_byte (newline_scan.h).
+    Modes:
+        line_reader::mode::automatic -> mmap regular files (including "< file" stdin),
+                                        buffered read() for pipes and ttys.
+        line_reader::mode::buffered -> always use the buffered read() path.
+        Pipes get their kernel buffer raised to pipe_size (F_SETPIPE_SZ) so each read() gets more.
+    Lifetime:
+        * mapped mode: a view stays valid until the reader is destroyed.
+        * buffered mode: a view is only valid until the next call to next().
+    Line semantics match while (std::getline(in_file, line)):
+        * The '\n' is not part of the line.
+        * The last line is returned even without a trailing '\n'.
+        * No extra empty line is returned after a trailing '\n'.
+    Usage:
+        pg::line_reader reader {"../myfile.txt"};
+        if (!reader) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        std::string_view line {};
+        while (reader.next(line))
+            std::cout << line << '\n';
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_LINE_READER_H
+#define PG_LINE_READER_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "newline_scan.h"
+
+namespace pg {
+
+class line_reader {
+public:
+    enum class mode { automatic, buffered };
+
+    static constexpr std::size_t default_buffer_size {1 << 20};    // 1 MiB
+    static constexpr std::size_t pipe_size {1 << 20};              // requested pipe capacity
+
+    /* Open a file by path; "-" reads from stdin */
+    explicit line_reader(const std::string &path, mode m = mode::automatic,
+                         std::size_t buffer_size = default_buffer_size) {
+        if (path == "-") {
+            fd_ = STDIN_FILENO;
+            owns_fd_ = false;
+        } else {
+            fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            owns_fd_ = true;
+        }
+        init(m, buffer_size);
+    }
+
+    /* Read from an already open descriptor (not closed by the reader) */
+    explicit line_reader(int fd, mode m = mode::automatic,
+                         std::size_t buffer_size = default_buffer_size)
+        : fd_ {fd}, owns_fd_ {false} {
+        init(m, buffer_size);
+    }
+
+    line_reader(const line_reader &) = delete;
+    line_reader &operator=(const line_reader &) = delete;
+
+    ~line_reader() { close(); }
+
+    bool is_open() const { return fd_ >= 0; }
+    explicit operator bool() const { return is_open() && !error_; }
+    bool is_mapped() const { return mapped_; }
+    bool has_error() const { return error_; }   // a read() failed
+
+    /* Get the next line; false at end of input */
+    bool next(std::string_view &line) {
+        if (mapped_)
+            return next_mapped(line);
+        return next_buffered(line);
+    }
+
+    void close() {
+        if (map_ != nullptr && map_size_ > 0)
+            ::munmap(const_cast<char *>(map_), map_size_);
+        map_ = nullptr;
+        map_size_ = 0;
+        if (owns_fd_ && fd_ >= 0)
+            ::close(fd_);
+        fd_ = -1;
+    }
+
+private:
+    void init(mode m, std::size_t buffer_size) {
+        if (fd_ < 0)
+            return;
+        struct stat st {};
+        bool have_stat = ::fstat(fd_, &st) == 0;
+        if (m == mode::automatic && have_stat && S_ISREG(st.st_mode)) {
+            off_t offset = ::lseek(fd_, 0, SEEK_CUR);   // "< file" after a partial read starts mid-file
+            if (offset < 0 || offset > st.st_size)
+                offset = 0;
+            map_size_ = static_cast<std::size_t>(st.st_size);
+            if (map_size_ == static_cast<std::size_t>(offset)) {    // nothing to map, nothing to read
+                map_size_ = 0;
+                mapped_ = true;
+                return;
+            }
+            void *p = ::mmap(nullptr, map_size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+            if (p != MAP_FAILED) {
+                ::madvise(p, map_size_, MADV_SEQUENTIAL);
+                map_ = static_cast<const char *>(p);
+                cur_ = map_ + offset;
+                end_ = map_ + map_size_;
+                mapped_ = true;
+                return;
+            }
+            map_size_ = 0;                      // fall through to read()
+        }
+#ifdef F_SETPIPE_SZ
+        if (have_stat && S_ISFIFO(st.st_mode))  // fewer, larger reads from a pipe (best effort)
+            ::fcntl(fd_, F_SETPIPE_SZ, static_cast<int>(pipe_size));
+#endif
+        buffer_.resize(buffer_size < 4096 ? 4096 : buffer_size);
+    }
+
+    bool next_mapped(std::string_view &line) {
+        if (cur_ == end_)
+            return false;
+        const char *nl = find_byte(cur_, end_, '\n');
+        line = std::string_view(cur_, nl - cur_);
+        cur_ = nl == end_ ? end_ : nl + 1;
+        return true;
+    }
+
+    bool next_buffered(std::string_view &line) {
+        std::size_t scanned {0};                // bytes of the pending line already searched
+        for (;;) {
+            const char *last = buffer_.data() + end_pos_;
+            const char *nl = find_byte(buffer_.data() + begin_ + scanned, last, '\n');
+            if (nl != last) {
+                line = std::string_view(buffer_.data() + begin_, nl - (buffer_.data() + begin_));
+                begin_ = (nl - buffer_.data()) + 1;
+                return true;
+            }
+            scanned = end_pos_ - begin_;
+            if (eof_) {
+                if (begin_ == end_pos_)
+                    return false;
+                line = std::string_view(buffer_.data() + begin_, end_pos_ - begin_);
+                begin_ = end_pos_;
+                return true;
+            }
+            refill();
+        }
+    }
+
+    // Move the pending partial line to the front, grow if one line fills the buffer, then read()
+    void refill() {
+        if (begin_ > 0) {
+            std::memmove(buffer_.data(), buffer_.data() + begin_, end_pos_ - begin_);
+            end_pos_ -= begin_;
+            begin_ = 0;
+        }
+        if (end_pos_ == buffer_.size())
+            buffer_.resize(buffer_.size() * 2);
+        for (;;) {
+            ssize_t n = ::read(fd_, buffer_.data() + end_pos_, buffer_.size() - end_pos_);
+            if (n > 0) {
+                end_pos_ += static_cast<std::size_t>(n);
+                return;
+            }
+            if (n < 0 && errno == EINTR)
+                continue;
+            if (n < 0)
+                error_ = true;
+            eof_ = true;
+            return;
+        }
+    }
+
+    int fd_ {-1};
+    bool owns_fd_ {false};
+    bool mapped_ {false};
+    bool eof_ {false};
+    bool error_ {false};
+
+    // mapped mode
+    const char *map_ {nullptr};
+    std::size_t map_size_ {0};
+    const char *cur_ {nullptr};
+    const char *end_ {nullptr};
+
+    // buffered mode
+    std::vector<char> buffer_ {};
+    std::size_t begin_ {0};
+    std::size_t end_pos_ {0};
+};
+
+}   // namespace pg
+
+#endif  // PG_LINE_READER_H
@@ -0,0 +1,151 @@
+/**
+@file line_reader_example.cpp
+
+@brief
+    Reading a text file one line at a time without per-line allocation (line_reader.h),
+    with a throughput benchmark against the std::getline loop from file_input_output.cpp.
+
+@par
+    Usage:
+        line_reader_example                 -> generates a 256 MB test file and benchmarks it
+        line_reader_example <file>          -> benchmarks the given file
+        some_command | line_reader_example -    -> counts lines from stdin (buffered path)
+    Benchmarked loops:
+        1. std::getline(in_file, line) into a std::string (the file_input_output.cpp loop)
+        2. pg::line_reader, mmap path
+        3. pg::line_reader, buffered read() path
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "line_reader.h"
+
+struct scan_result {
+    std::size_t lines {0};
+    std::size_t bytes {0};  // line bytes without '\n'
+    double seconds {0.0};
+};
+
+/* Write a test file of about `size` bytes made of log-like lines */
+static bool make_test_file(const std::string &path, std::size_t size) {
+    std::ofstream out_file {path, std::ios::binary};
+    if (!out_file)
+        return false;
+    std::string line {};
+    std::size_t written {0};
+    for (std::size_t i {0}; written < size; ++i) {
+        line = "2026-10-16 12:00:00 INFO request " + std::to_string(i)
+             + " served in " + std::to_string(i % 997) + " us\n";
+        out_file << line;   // no std::endl, no flush per line
+        written += line.size();
+    }
+    return static_cast<bool>(out_file);
+}
+
+static scan_result scan_getline(const std::string &path) {
+    scan_result r {};
+    auto start = std::chrono::steady_clock::now();
+    std::ifstream in_file {path};
+    std::string line {};
+    while (std::getline(in_file, line)) {       // copies every line
+        ++r.lines;
+        r.bytes += line.size();
+    }
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+static scan_result scan_line_reader(const std::string &path, pg::line_reader::mode m) {
+    scan_result r {};
+    auto start = std::chrono::steady_clock::now();
+    pg::line_reader reader {path, m};
+    std::string_view line {};
+    while (reader.next(line)) {                 // no copy, no allocation
+        ++r.lines;
+        r.bytes += line.size();
+    }
+    r.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return r;
+}
+
+static void report(const char *label, const scan_result &r, std::size_t file_size) {
+    double mb = static_cast<double>(file_size) / (1024.0 * 1024.0);
+    std::cout << std::left << std::setw(22) << label << std::right
+              << std::setw(12) << r.lines << " lines"
+              << std::setw(10) << std::fixed << std::setprecision(3) << r.seconds << " s"
+              << std::setw(10) << std::setprecision(1) << mb / r.seconds << " MB/s" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+    std::string path {argc > 1 ? argv[1] : ""};
+
+    /* Reading stdin one line at a time */
+    if (path == "-") {
+        pg::line_reader reader {"-"};
+        std::string_view line {};
+        std::size_t lines {0};
+        while (reader.next(line))
+            ++lines;
+        std::cout << lines << " lines" << std::endl;
+        return reader.has_error() ? 1 : 0;
+    }
+
+    bool generated {false};
+    if (path.empty()) {
+        path = "line_reader_bench.txt";
+        std::cout << "Generating " << path << " ..." << std::endl;
+        if (!make_test_file(path, 256u << 20)) {
+            std::cerr << "File create error" << std::endl;
+            return 1;
+        }
+        generated = true;
+    }
+
+    /* Check if file opened successfully */
+    pg::line_reader probe {path};
+    if (!probe) {
+        std::cerr << "File open error" << std::endl;
+        return 1;
+    }
+    std::cout << "mmap used: " << std::boolalpha << probe.is_mapped() << std::endl;
+    probe.close();
+
+    std::ifstream size_probe {path, std::ios::binary | std::ios::ate};
+    std::size_t file_size {static_cast<std::size_t>(size_probe.tellg())};
+    size_probe.close();
+
+    /* Benchmark (first pass warms the page cache) */
+    scan_getline(path);
+    scan_result by_getline = scan_getline(path);
+    scan_result by_mmap = scan_line_reader(path, pg::line_reader::mode::automatic);
+    scan_result by_read = scan_line_reader(path, pg::line_reader::mode::buffered);
+
+    report("std::getline", by_getline, file_size);
+    report("line_reader (mmap)", by_mmap, file_size);
+    report("line_reader (read)", by_read, file_size);
+
+    bool same = by_getline.lines == by_mmap.lines && by_getline.bytes == by_mmap.bytes
+             && by_getline.lines == by_read.lines && by_getline.bytes == by_read.bytes;
+    std::cout << "results match: " << std::boolalpha << same << std::endl;
+
+    if (generated)
+        std::remove(path.c_str());
+    return same ? 0 : 1;
+}
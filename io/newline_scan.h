@@ -0,0 +1,201 @@
+/**
+@file newline_scan.h
+
+@brief
+    Vectorized delimiter scanning
+        Buffer ===> 16/32 bytes compared at once ===> position of the next '\n' / number of lines
+
+@par
+    Kernels:
+        scalar -> one byte at a time; reference implementation and non-x86 fallback.
+        sse2 -> 16 bytes per step (always available on x86-64).
+        avx2 -> 32 bytes per step, chosen at run time when the CPU supports it.
+    Functions:
+        pg::find_byte(first, last, c) -> pointer to the first c in [first, last), or last.
+        pg::count_byte(first, last, c) -> number of c in [first, last).
+        pg::count_lines(data, size) -> number of lines std::getline would return.
+        pg::detected_simd_level() -> kernel picked for this CPU.
+    Runtime dispatch:
+        * The kernel is chosen once, on the first call, with __builtin_cpu_supports().
+        * The avx2 kernel is compiled with __attribute__((target("avx2"))), so the
+          program itself doesn't need -mavx2.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_NEWLINE_SCAN_H
+#define PG_NEWLINE_SCAN_H
+
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__)                 // SSE2 is baseline and _mm256_extract_epi64 exists
+#define PG_SCAN_X86 1
+#include <immintrin.h>
+#endif
+
+namespace pg {
+
+enum class simd_level { scalar, sse2, avx2 };
+
+inline const char *to_string(simd_level level) {
+    switch (level) {
+    case simd_level::scalar: return "scalar";
+    case simd_level::sse2: return "sse2";
+    case simd_level::avx2: return "avx2";
+    }
+    return "?";
+}
+
+using find_byte_fn = const char *(*)(const char *first, const char *last, char c);
+using count_byte_fn = std::size_t (*)(const char *first, const char *last, char c);
+
+namespace scan {
+
+/* Scalar kernels */
+inline const char *find_byte_scalar(const char *first, const char *last, char c) {
+    while (first != last && *first != c)
+        ++first;
+    return first;
+}
+
+inline std::size_t count_byte_scalar(const char *first, const char *last, char c) {
+    std::size_t n {0};
+    for (; first != last; ++first)
+        n += (*first == c);
+    return n;
+}
+
+#ifdef PG_SCAN_X86
+/* SSE2 kernels */
+inline const char *find_byte_sse2(const char *first, const char *last, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    while (last - first >= 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(chunk, needle)));
+        if (mask != 0)
+            return first + __builtin_ctz(mask);
+        first += 16;
+    }
+    return find_byte_scalar(first, last, c);
+}
+
+inline std::size_t count_byte_sse2(const char *first, const char *last, char c) {
+    const __m128i needle = _mm_set1_epi8(c);
+    std::size_t n {0};
+    while (last - first >= 16) {
+        // per-byte counters overflow after 255 steps; fold them into n before that
+        __m128i counters = _mm_setzero_si128();
+        for (int i {0}; i < 255 && last - first >= 16; ++i, first += 16) {
+            __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i *>(first));
+            counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(chunk, needle));   // -(-1) == +1
+        }
+        __m128i sums = _mm_sad_epu8(counters, _mm_setzero_si128());
+        n += static_cast<std::size_t>(_mm_cvtsi128_si32(sums))
+           + static_cast<std::size_t>(_mm_extract_epi16(sums, 4));
+    }
+    return n + count_byte_scalar(first, last, c);
+}
+
+/* AVX2 kernels */
+__attribute__((target("avx2")))
+inline const char *find_byte_avx2(const char *first, const char *last, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    while (last - first >= 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+        unsigned mask = static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chunk, needle)));
+        if (mask != 0)
+            return first + __builtin_ctz(mask);
+        first += 32;
+    }
+    return find_byte_sse2(first, last, c);
+}
+
+__attribute__((target("avx2")))
+inline std::size_t count_byte_avx2(const char *first, const char *last, char c) {
+    const __m256i needle = _mm256_set1_epi8(c);
+    std::size_t n {0};
+    while (last - first >= 32) {
+        __m256i counters = _mm256_setzero_si256();
+        for (int i {0}; i < 255 && last - first >= 32; ++i, first += 32) {
+            __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(first));
+            counters = _mm256_sub_epi8(counters, _mm256_cmpeq_epi8(chunk, needle));
+        }
+        __m256i sums = _mm256_sad_epu8(counters, _mm256_setzero_si256());
+        n += static_cast<std::size_t>(_mm256_extract_epi64(sums, 0))
+           + static_cast<std::size_t>(_mm256_extract_epi64(sums, 1))
+           + static_cast<std::size_t>(_mm256_extract_epi64(sums, 2))
+           + static_cast<std::size_t>(_mm256_extract_epi64(sums, 3));
+    }
+    return n + count_byte_sse2(first, last, c);
+}
+#endif  // PG_SCAN_X86
+
+}   // namespace scan
+
+/* Best kernel level for this CPU */
+inline simd_level detected_simd_level() {
+#ifdef PG_SCAN_X86
+    static const simd_level level = __builtin_cpu_supports("avx2") ? simd_level::avx2
+                                                                    : simd_level::sse2;
+    return level;
+#else
+    return simd_level::scalar;
+#endif
+}
+
+/* Kernels for an explicit level (levels the CPU or target lacks fall back to scalar) */
+inline find_byte_fn find_byte_kernel(simd_level level) {
+#ifdef PG_SCAN_X86
+    if (level == simd_level::avx2 && __builtin_cpu_supports("avx2"))
+        return scan::find_byte_avx2;
+    if (level != simd_level::scalar)
+        return scan::find_byte_sse2;
+#else
+    (void)level;
+#endif
+    return scan::find_byte_scalar;
+}
+
+inline count_byte_fn count_byte_kernel(simd_level level) {
+#ifdef PG_SCAN_X86
+    if (level == simd_level::avx2 && __builtin_cpu_supports("avx2"))
+        return scan::count_byte_avx2;
+    if (level != simd_level::scalar)
+        return scan::count_byte_sse2;
+#else
+    (void)level;
+#endif
+    return scan::count_byte_scalar;
+}
+
+/* Dispatched entry points */
+inline const char *find_byte(const char *first, const char *last, char c) {
+    static const find_byte_fn fn = find_byte_kernel(detected_simd_level());
+    return fn(first, last, c);
+}
+
+inline std::size_t count_byte(const char *first, const char *last, char c) {
+    static const count_byte_fn fn = count_byte_kernel(detected_simd_level());
+    return fn(first, last, c);
+}
+
+/* Lines as counted by while (std::getline(in, line)): a last line without '\n' still counts */
+inline std::size_t count_lines(const char *data, std::size_t size) {
+    if (size == 0)
+        return 0;
+    return count_byte(data, data + size, '\n') + (data[size - 1] != '\n');
+}
+
+}   // namespace pg
+
+#endif  // PG_NEWLINE_SCAN_H
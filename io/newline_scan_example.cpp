@@ -0,0 +1,152 @@
+/**
+@file newline_scan_example.cpp
+
+@brief
+    Counting lines with the vectorized kernels from newline_scan.h, benchmarked
+    against std::getline and memchr on 1 KB, 1 MB and 1 GB inputs.
+
+@par
+    Usage:
+        newline_scan_example            -> 1 KB, 1 MB and 1 GB inputs
+        newline_scan_example --small    -> skip the 1 GB input (needs ~2 GB of memory)
+    Benchmarked line counters:
+        1. std::getline over a std::istringstream (the file_input_output.cpp loop, minus the disk)
+        2. memchr loop
+        3. pg::count_byte with the scalar, sse2 and avx2 kernels
+        4. pg::find_byte loop (dispatched kernel)
+    Every counter must agree with the scalar reference.
+    Odd sizes (1, 31, 33, 63, 65, 8177, 1000003 bytes) check each kernel's tail loop against the
+    scalar kernel before the benchmark.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "newline_scan.h"
+
+/* Log-like text of exactly `size` bytes */
+static std::string make_text(std::size_t size) {
+    std::string text {};
+    text.reserve(size + 128);
+    for (std::size_t i {0}; text.size() < size; ++i) {
+        text += "2026-10-16 INFO worker ";
+        text += std::to_string(i % 64);
+        text += " processed item ";
+        text += std::to_string(i);
+        text += '\n';
+    }
+    text.resize(size);
+    return text;
+}
+
+/* Run `count` enough times to cover ~1 GB and report GB/s */
+template <typename F>
+static std::size_t bench(const char *label, const std::string &text, F count) {
+    std::size_t repeats {text.size() >= (1u << 30) ? 1 : (1u << 30) / text.size()};
+    if (repeats > 100000)
+        repeats = 100000;
+    std::size_t lines {0};
+    auto start = std::chrono::steady_clock::now();
+    for (std::size_t r {0}; r < repeats; ++r)
+        lines = count(text);
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double gb = static_cast<double>(text.size()) * static_cast<double>(repeats) / (1u << 30);
+    std::cout << "  " << std::left << std::setw(18) << label << std::right
+              << std::setw(12) << lines << " lines"
+              << std::setw(10) << std::fixed << std::setprecision(2) << gb / s << " GB/s" << std::endl;
+    return lines;
+}
+
+int main(int argc, char *argv[]) {
+    bool small {argc > 1 && std::string {argv[1]} == "--small"};
+    std::cout << "detected kernel: " << pg::to_string(pg::detected_simd_level()) << std::endl;
+
+    bool all_ok {true};
+
+    /* Tails: sizes that aren't a multiple of the vector width or of the 255-step fold */
+    for (std::size_t size : {1, 31, 33, 63, 65, 255 * 32 + 17, 1000003}) {
+        std::string text = make_text(size);
+        const char *first = text.data(), *last = text.data() + text.size();
+        std::size_t expected = pg::scan::count_byte_scalar(first, last, '\n');
+        bool ok {true};
+        for (pg::simd_level level : {pg::simd_level::sse2, pg::simd_level::avx2}) {
+            pg::find_byte_fn find = pg::find_byte_kernel(level);
+            std::size_t found {0};
+            for (const char *p = find(first, last, '\n'); p != last; p = find(p + 1, last, '\n'))
+                ++found;
+            ok = ok && pg::count_byte_kernel(level)(first, last, '\n') == expected && found == expected;
+        }
+        all_ok = all_ok && ok;
+        if (!ok)
+            std::cout << size << " bytes: MISMATCH" << std::endl;
+    }
+
+    for (std::size_t size : {std::size_t {1} << 10, std::size_t {1} << 20, std::size_t {1} << 30}) {
+        if (small && size > (1u << 20))
+            break;
+        std::string text = make_text(size);
+        std::cout << size / 1024 << " KB" << std::endl;
+
+        /* Reference */
+        std::size_t expected = pg::scan::count_byte_scalar(text.data(), text.data() + text.size(), '\n')
+                             + (text.back() != '\n');
+
+        std::size_t got[6] {};
+        got[0] = bench("std::getline", text, [](const std::string &t) {
+            std::istringstream iss {t};
+            std::string line {};
+            std::size_t n {0};
+            while (std::getline(iss, line))
+                ++n;
+            return n;
+        });
+        got[1] = bench("memchr", text, [](const std::string &t) {
+            const char *p = t.data(), *end = t.data() + t.size();
+            std::size_t n {0};
+            while (p != end) {
+                const void *nl = std::memchr(p, '\n', end - p);
+                ++n;
+                p = nl ? static_cast<const char *>(nl) + 1 : end;
+            }
+            return n;
+        });
+        int k {2};
+        for (pg::simd_level level : {pg::simd_level::scalar, pg::simd_level::sse2, pg::simd_level::avx2}) {
+            pg::count_byte_fn count = pg::count_byte_kernel(level);
+            std::string label = std::string {"count_byte "} + pg::to_string(level);
+            got[k++] = bench(label.c_str(), text, [count](const std::string &t) {
+                return count(t.data(), t.data() + t.size(), '\n') + (t.back() != '\n');
+            });
+        }
+        got[5] = bench("find_byte loop", text, [](const std::string &t) {
+            const char *p = t.data(), *end = t.data() + t.size();
+            std::size_t n {0};
+            while (p != end) {
+                const char *nl = pg::find_byte(p, end, '\n');
+                ++n;
+                p = nl == end ? end : nl + 1;
+            }
+            return n;
+        });
+
+        for (std::size_t g : got)
+            all_ok = all_ok && g == expected;
+    }
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,269 @@
+/**
+@file parallel_scan.h
+
+@brief
+    Parallel chunked file processing
+        File ===> mmap ===> byte ranges aligned to '\n' ===> work-stealing pool ===> reduce
+
+@par
+    Steps:
+        1. Map the file and cut it into chunks of about chunk_size bytes.
+        2. Move each cut forward to just after the next '\n', so no line is split.
+        3. Each chunk runs on the pool: per_line(line, local) for every line of the chunk,
+           with a local result on the task's stack starting from T {}; it is stored once
+           per chunk, so workers don't share cache lines per line and need no locks.
+        4. reduce(total, local) folds the chunk results into init in file order, so the result is the
+           same as a serial loop even when reduce isn't commutative.
+    Line semantics match while (std::getline(in_file, line)).
+    If per_line throws, the other chunks still finish; the first exception in file order is
+    rethrown from parallel_scan().
+    work_stealing_pool:
+        * One task deque per worker. A worker pops from the back of its own deque and,
+          when that is empty, steals from the front of the others.
+        * Many more chunks than workers, so a worker stuck on a slow chunk doesn't hold
+          the others back.
+    Usage:
+        pg::work_stealing_pool pool {};
+        std::optional<std::size_t> lines = pg::parallel_scan<std::size_t>(
+            pool, "big.log", 0,
+            [](std::string_view, std::size_t &n) { ++n; },
+            [](std::size_t &total, const std::size_t &n) { total += n; });
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_PARALLEL_SCAN_H
+#define PG_PARALLEL_SCAN_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "newline_scan.h"
+
+namespace pg {
+
+class work_stealing_pool {
+public:
+    explicit work_stealing_pool(unsigned threads = std::thread::hardware_concurrency()) {
+        if (threads == 0)
+            threads = 1;
+        for (unsigned i {0}; i < threads; ++i)
+            queues_.push_back(std::make_unique<worker_queue>());
+        for (unsigned i {0}; i < threads; ++i)
+            threads_.emplace_back([this, i] { run(i); });
+    }
+
+    work_stealing_pool(const work_stealing_pool &) = delete;
+    work_stealing_pool &operator=(const work_stealing_pool &) = delete;
+
+    ~work_stealing_pool() {
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            stopping_ = true;
+        }
+        work_available_.notify_all();
+        for (std::thread &t : threads_)
+            t.join();
+    }
+
+    unsigned size() const { return static_cast<unsigned>(threads_.size()); }
+
+    /* Queue a task; tasks are spread round-robin and rebalanced by stealing */
+    void submit(std::function<void()> task) {
+        unsigned target = next_queue_.fetch_add(1, std::memory_order_relaxed) % size();
+        unfinished_.fetch_add(1, std::memory_order_relaxed);
+        {
+            std::lock_guard<std::mutex> lock {queues_[target]->mutex};
+            queues_[target]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard<std::mutex> lock {mutex_};
+            ++queued_;
+        }
+        work_available_.notify_one();
+    }
+
+    /* Block until every submitted task has finished */
+    void wait() {
+        std::unique_lock<std::mutex> lock {mutex_};
+        all_done_.wait(lock, [this] { return unfinished_.load() == 0; });
+    }
+
+    std::size_t steals() const { return steals_.load(); }
+
+private:
+    struct worker_queue {
+        std::mutex mutex {};
+        std::deque<std::function<void()>> tasks {};
+    };
+
+    bool try_pop(unsigned self, std::function<void()> &task) {
+        {
+            worker_queue &own = *queues_[self];
+            std::lock_guard<std::mutex> lock {own.mutex};
+            if (!own.tasks.empty()) {
+                task = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+        for (unsigned k {1}; k < size(); ++k) {
+            worker_queue &victim = *queues_[(self + k) % size()];
+            std::lock_guard<std::mutex> lock {victim.mutex};
+            if (!victim.tasks.empty()) {
+                task = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                steals_.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void run(unsigned self) {
+        std::function<void()> task {};
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lock {mutex_};
+                work_available_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+                if (queued_ == 0)
+                    return;                     // stopping and nothing left
+                --queued_;                      // this worker will take one task
+            }
+            while (!try_pop(self, task))        // the task is in some deque; find it
+                std::this_thread::yield();
+            task();
+            task = nullptr;
+            if (unfinished_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+                std::lock_guard<std::mutex> lock {mutex_};
+                all_done_.notify_all();
+            }
+        }
+    }
+
+    std::vector<std::unique_ptr<worker_queue>> queues_ {};
+    std::vector<std::thread> threads_ {};
+    std::mutex mutex_ {};
+    std::condition_variable work_available_ {};
+    std::condition_variable all_done_ {};
+    std::size_t queued_ {0};                    // tasks not yet claimed by a worker
+    bool stopping_ {false};
+    std::atomic<std::size_t> unfinished_ {0};
+    std::atomic<unsigned> next_queue_ {0};
+    std::atomic<std::size_t> steals_ {0};
+};
+
+/* Byte ranges of `data` of about chunk_size each (at least 1), every range starting at a line start */
+inline std::vector<std::pair<std::size_t, std::size_t>>
+split_lines(const char *data, std::size_t size, std::size_t chunk_size) {
+    std::vector<std::pair<std::size_t, std::size_t>> ranges {};
+    if (chunk_size == 0)
+        chunk_size = 1;                         // each range still ends after a '\n', so it always advances
+    std::size_t begin {0};
+    while (begin < size) {
+        std::size_t cut {begin + chunk_size};
+        if (cut >= size) {
+            ranges.emplace_back(begin, size);
+            break;
+        }
+        const char *nl = find_byte(data + cut - 1, data + size, '\n');   // a line starting at cut stays whole
+        std::size_t end = nl == data + size ? size : static_cast<std::size_t>(nl - data) + 1;
+        ranges.emplace_back(begin, end);
+        begin = end;
+    }
+    return ranges;
+}
+
+/* Calls per_line for each line in [first, last) */
+template <typename Line>
+void for_each_line(const char *first, const char *last, Line &&per_line) {
+    while (first != last) {
+        const char *nl = find_byte(first, last, '\n');
+        per_line(std::string_view(first, static_cast<std::size_t>(nl - first)));
+        first = nl == last ? last : nl + 1;
+    }
+}
+
+struct scan_options {
+    std::size_t chunk_size {8u << 20};          // 8 MiB; 0 is treated as 1
+};
+
+/* Map `path`, run per_line over every line in parallel and reduce the per-chunk results in
+   file order; std::nullopt if the file can't be opened or mapped */
+template <typename T, typename PerLine, typename Reduce>
+std::optional<T> parallel_scan(work_stealing_pool &pool, const std::string &path, T init,
+                               PerLine per_line, Reduce reduce, scan_options options = {}) {
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return std::nullopt;
+    struct stat st {};
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return std::nullopt;
+    }
+    std::size_t size = static_cast<std::size_t>(st.st_size);
+    if (size == 0) {
+        ::close(fd);
+        return init;
+    }
+    void *p = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED)
+        return std::nullopt;
+    const char *data = static_cast<const char *>(p);
+
+    std::vector<std::pair<std::size_t, std::size_t>> ranges = split_lines(data, size, options.chunk_size);
+    std::unique_ptr<T[]> partial {new T[ranges.size()] {}};   // not vector<T>: vector<bool> packs bits
+    std::vector<std::exception_ptr> errors(ranges.size());     // a throw on a worker would terminate
+    for (std::size_t i {0}; i < ranges.size(); ++i) {
+        pool.submit([&, i] {
+            T local {};
+            try {
+                for_each_line(data + ranges[i].first, data + ranges[i].second,
+                              [&](std::string_view line) { per_line(line, local); });
+                partial[i] = std::move(local);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        });
+    }
+    pool.wait();
+    ::munmap(p, size);
+    for (const std::exception_ptr &error : errors)
+        if (error)
+            std::rethrow_exception(error);
+
+    T total {init};
+    for (std::size_t i {0}; i < ranges.size(); ++i)
+        reduce(total, partial[i]);
+    return total;
+}
+
+}   // namespace pg
+
+#endif  // PG_PARALLEL_SCAN_H
@@ -0,0 +1,203 @@
+/**
+@file parallel_scan_example.cpp
+
+@brief
+    Counting lines and parsing "name num total" records on all cores (parallel_scan.h),
+    checked against the serial std::getline loop from file_input_output.cpp.
+
+@par
+    Usage:
+        parallel_scan_example               -> generates a 512 MB file
+        parallel_scan_example <file>        -> uses the given file
+    Checks (exit code 1 if any differs from the serial loop):
+        * number of lines and total line bytes
+        * sum of num and total over every "name num total" record
+        * the same results with tiny chunks (many boundaries) and 1..N threads
+        * a bool result per chunk (not packed into vector<bool>)
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "parallel_scan.h"
+#include "record_parser.h"
+
+struct file_stats {
+    std::size_t lines {0};
+    std::size_t bytes {0};
+    long long num_sum {0};
+    double total_sum {0.0};
+    std::size_t bad_records {0};
+
+    bool operator==(const file_stats &o) const {
+        return lines == o.lines && bytes == o.bytes && num_sum == o.num_sum
+            && total_sum == o.total_sum && bad_records == o.bad_records;
+    }
+};
+
+static bool make_test_file(const std::string &path, std::size_t size) {
+    std::ofstream out_file {path, std::ios::binary};
+    const char *names[] {"Moe", "Larry", "Curly", "Shemp"};
+    std::string line {};
+    std::size_t written {0};
+    for (std::size_t i {0}; out_file && written < size; ++i) {
+        line = std::string {names[i % 4]} + " " + std::to_string(i % 1000) + " "
+             + std::to_string((i % 4096) * 0.25) + "\n";
+        out_file << line;
+        written += line.size();
+    }
+    out_file << "no trailing newline 1";    // last line without '\n', like getline allows
+    return static_cast<bool>(out_file);
+}
+
+static void add_line(std::string_view line, file_stats &s) {
+    ++s.lines;
+    s.bytes += line.size();
+    std::string_view name {};
+    int num {};
+    double total {};
+    if (pg::parse_record(line, ' ', name, num, total)) {
+        ++s.bad_records;
+        return;
+    }
+    s.num_sum += num;
+    s.total_sum += total;       // totals are multiples of 0.25, so the sum is exact in any order
+}
+
+static void merge(file_stats &into, const file_stats &s) {
+    into.lines += s.lines;
+    into.bytes += s.bytes;
+    into.num_sum += s.num_sum;
+    into.total_sum += s.total_sum;
+    into.bad_records += s.bad_records;
+}
+
+int main(int argc, char *argv[]) {
+    std::string path {argc > 1 ? argv[1] : ""};
+    bool generated {false};
+    if (path.empty()) {
+        path = "parallel_scan_bench.txt";
+        std::cout << "Generating " << path << " ..." << std::endl;
+        if (!make_test_file(path, 512u << 20)) {
+            std::cerr << "File create error" << std::endl;
+            return 1;
+        }
+        generated = true;
+    }
+
+    /* Serial: the file_input_output.cpp loop */
+    auto start = std::chrono::steady_clock::now();
+    file_stats serial {};
+    {
+        std::ifstream in_file {path};
+        if (!in_file) {
+            std::cerr << "File open error" << std::endl;
+            return 1;
+        }
+        std::string line {};
+        while (std::getline(in_file, line))
+            add_line(line, serial);
+    }
+    double s_serial = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << std::left << std::setw(28) << "serial getline" << std::right << std::fixed
+              << std::setprecision(3) << std::setw(8) << s_serial << " s   "
+              << serial.lines << " lines" << std::endl;
+
+    /* Parallel, 1..N threads */
+    bool all_ok {true};
+    unsigned max_threads {std::thread::hardware_concurrency()};
+    for (unsigned threads {1}; threads <= max_threads; threads *= 2) {
+        pg::work_stealing_pool pool {threads};
+        start = std::chrono::steady_clock::now();
+        std::optional<file_stats> parallel = pg::parallel_scan(pool, path, file_stats {}, add_line, merge);
+        double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        bool ok = parallel && *parallel == serial;
+        all_ok = all_ok && ok;
+        std::cout << std::left << std::setw(28) << "parallel_scan " + std::to_string(threads) + " thread(s)"
+                  << std::right << std::setw(8) << s << " s   x" << std::setprecision(2) << s_serial / s
+                  << std::setprecision(3) << "   " << pool.steals() << " steals"
+                  << (ok ? "" : "   MISMATCH") << std::endl;
+        if (threads == max_threads)
+            break;
+        if (threads * 2 > max_threads)
+            threads = max_threads / 2;
+    }
+
+    /* Tiny chunks: thousands of line-boundary cuts */
+    {
+        pg::work_stealing_pool pool {};
+        pg::scan_options tiny {};
+        tiny.chunk_size = 4096 + 7;
+        std::optional<file_stats> parallel = pg::parallel_scan(pool, path, file_stats {}, add_line, merge, tiny);
+        bool ok = parallel && *parallel == serial;
+        all_ok = all_ok && ok;
+        std::cout << "tiny chunks match: " << std::boolalpha << ok << std::endl;
+    }
+
+    /* chunk_size 0 and empty lines: one range per line, every range makes progress */
+    {
+        const std::string small_path {"parallel_scan_small.txt"};
+        {
+            std::ofstream small {small_path};
+            small << "a\n\n\nbb\n\nccc";
+        }
+        pg::work_stealing_pool pool {4};
+        pg::scan_options zero {};
+        zero.chunk_size = 0;
+        std::optional<std::size_t> lines = pg::parallel_scan<std::size_t>(
+            pool, small_path, 0,
+            [](std::string_view, std::size_t &n) { ++n; },
+            [](std::size_t &total, const std::size_t &n) { total += n; }, zero);
+        bool ok = lines && *lines == 6;
+        all_ok = all_ok && ok;
+        std::cout << "zero chunk size match: " << std::boolalpha << ok << std::endl;
+
+        /* A throwing per_line reaches the caller instead of terminating a worker */
+        bool caught {false};
+        try {
+            pg::parallel_scan<std::size_t>(
+                pool, small_path, 0,
+                [](std::string_view line, std::size_t &) {
+                    if (line == "bb")
+                        throw std::runtime_error {"bad line"};
+                },
+                [](std::size_t &, const std::size_t &) {}, zero);
+        } catch (const std::runtime_error &) {
+            caught = true;
+        }
+        all_ok = all_ok && caught;
+        std::cout << "per_line exception caught: " << caught << std::endl;
+
+        /* T = bool: one result per chunk, written by different workers */
+        std::optional<bool> has_empty = pg::parallel_scan<bool>(
+            pool, small_path, false,
+            [](std::string_view line, bool &found) { found = found || line.empty(); },
+            [](bool &any, const bool &found) { any = any || found; }, zero);
+        ok = has_empty && *has_empty;
+        all_ok = all_ok && ok;
+        std::cout << "bool result match: " << ok << std::endl;
+        std::remove(small_path.c_str());
+    }
+
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    if (generated)
+        std::remove(path.c_str());
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+/**
+@file record_parser.h
+
+@brief
+    Allocation-free record parsing
+        "Moe 100 1234.5" ===> std::string_view fields ===> std::from_chars ===> typed values
+
+@par
+    Why not std::istringstream:
+        * std::istringstream iss {info}; copies the record and builds a stream per record.
+        * operator>> is locale-aware and goes through virtual calls per character.
+        * record_parser works on a std::string_view in place and never allocates.
+    Delimiters:
+        ' ' -> fields split by runs of spaces/tabs (like operator>>).
+        any other char (e.g. ',') -> fields split by that char; spaces around a field are trimmed.
+    Field types:
+        Integers, float, double, long double, bool (0/1/true/false), std::string_view, std::string.
+    Errors:
+        parse_error::code  -> what went wrong (parse_errc)
+        parse_error::field -> 0-based index of the field that failed
+        parse_error::column -> byte offset of that field in the record
+    Usage:
+        std::string_view name {};
+        int num {};
+        double total {};
+        pg::parse_error err = pg::parse_record("Moe 100 1234.5", ' ', name, num, total);
+        if (!err)
+            ...
+
+        struct person { std::string name; int num; double total; };
+        person p {};
+        err = pg::parse_into("Moe,100,1234.5", ',', p, &person::name, &person::num, &person::total);
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_RECORD_PARSER_H
+#define PG_RECORD_PARSER_H
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+namespace pg {
+
+enum class parse_errc { ok, missing_field, invalid_value, out_of_range, trailing_data };
+
+inline const char *to_string(parse_errc code) {
+    switch (code) {
+    case parse_errc::ok: return "ok";
+    case parse_errc::missing_field: return "missing field";
+    case parse_errc::invalid_value: return "invalid value";
+    case parse_errc::out_of_range: return "value out of range";
+    case parse_errc::trailing_data: return "unexpected trailing field";
+    }
+    return "?";
+}
+
+struct parse_error {
+    parse_errc code {parse_errc::ok};
+    std::size_t field {0};      // 0-based field index
+    std::size_t column {0};     // byte offset of the field in the record
+
+    explicit operator bool() const { return code != parse_errc::ok; }   // true on error
+};
+
+/* Parse one field into a value; the whole field must be consumed */
+inline parse_errc parse_field(std::string_view text, std::string_view &value) {
+    value = text;
+    return parse_errc::ok;
+}
+
+inline parse_errc parse_field(std::string_view text, std::string &value) {
+    value.assign(text.data(), text.size());
+    return parse_errc::ok;
+}
+
+inline parse_errc parse_field(std::string_view text, bool &value) {
+    if (text == "1" || text == "true") {
+        value = true;
+        return parse_errc::ok;
+    }
+    if (text == "0" || text == "false") {
+        value = false;
+        return parse_errc::ok;
+    }
+    return parse_errc::invalid_value;
+}
+
+template <typename T>
+inline std::enable_if_t<std::is_arithmetic_v<T>, parse_errc>
+parse_field(std::string_view text, T &value) {
+    const char *first = text.data();
+    const char *last = text.data() + text.size();
+    if (first != last && *first == '+') {       // operator>> accepts a leading '+', from_chars doesn't
+        ++first;
+        if (first != last && *first == '-')     // but not "+-1"
+            return parse_errc::invalid_value;
+    }
+    T parsed {};
+    std::from_chars_result r = std::from_chars(first, last, parsed);
+    if (r.ec == std::errc::result_out_of_range)
+        return parse_errc::out_of_range;
+    if (r.ec != std::errc {} || r.ptr != last || first == last)
+        return parse_errc::invalid_value;
+    value = parsed;
+    return parse_errc::ok;
+}
+
+/* Walks the fields of one record */
+class field_cursor {
+public:
+    field_cursor(std::string_view record, char delim = ' ')
+        : record_ {record}, delim_ {delim} {}
+
+    /* Next raw field; false when the record has no more fields */
+    bool next(std::string_view &field) {
+        if (delim_ == ' ') {
+            while (pos_ < record_.size() && is_space(record_[pos_]))
+                ++pos_;
+            if (pos_ == record_.size())
+                return false;
+            std::size_t start {pos_};
+            while (pos_ < record_.size() && !is_space(record_[pos_]))
+                ++pos_;
+            field_start_ = start;
+            field = record_.substr(start, pos_ - start);
+            return true;
+        }
+        if (pos_ > record_.size())
+            return false;
+        std::size_t end = record_.find(delim_, pos_);
+        if (end == std::string_view::npos)
+            end = record_.size();
+        std::size_t start {pos_};
+        std::size_t stop {end};
+        while (start < stop && is_space(record_[start]))
+            ++start;
+        while (stop > start && is_space(record_[stop - 1]))
+            --stop;
+        field_start_ = start;
+        field = record_.substr(start, stop - start);
+        pos_ = end + 1;                         // past the delimiter (or past the end)
+        return true;
+    }
+
+    /* Next field converted to T; on failure error() says which field and why */
+    template <typename T>
+    bool read(T &value) {
+        std::string_view field {};
+        if (!next(field)) {
+            error_ = {parse_errc::missing_field, index_, record_.size()};
+            return false;
+        }
+        parse_errc code = parse_field(field, value);
+        if (code != parse_errc::ok) {
+            error_ = {code, index_, field_start_};
+            return false;
+        }
+        ++index_;
+        return true;
+    }
+
+    /* Fail with trailing_data if any field is left */
+    bool finish() {
+        std::string_view field {};
+        if (next(field)) {
+            error_ = {parse_errc::trailing_data, index_, field_start_};
+            return false;
+        }
+        return true;
+    }
+
+    const parse_error &error() const { return error_; }
+
+private:
+    static bool is_space(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+    std::string_view record_;
+    char delim_;
+    std::size_t pos_ {0};
+    std::size_t field_start_ {0};
+    std::size_t index_ {0};
+    parse_error error_ {};
+};
+
+/* Parse every field of `record` into `fields...`, in order */
+template <typename... T>
+parse_error parse_record(std::string_view record, char delim, T &...fields) {
+    field_cursor cursor {record, delim};
+    if ((cursor.read(fields) && ...) && cursor.finish())
+        return {};
+    return cursor.error();
+}
+
+/* Parse `record` into the listed members of a struct */
+template <typename S, typename... M>
+parse_error parse_into(std::string_view record, char delim, S &out, M S::*...members) {
+    return parse_record(record, delim, (out.*members)...);
+}
+
+}   // namespace pg
+
+#endif  // PG_RECORD_PARSER_H
@@ -0,0 +1,124 @@
+/**
+@file record_parser_example.cpp
+
+@brief
+    Parsing "name num total" records with record_parser.h instead of std::istringstream,
+    with a records/sec benchmark of both.
+
+@par
+    Benchmarked parsers:
+        1. std::istringstream iss {info}; iss >> name >> num >> total;   (file_input_output.cpp)
+        2. pg::parse_into(info, ' ', rec, &record::name, &record::num, &record::total)
+    Both must produce the same checksum.
+    The single-record parses and the per-field errors are checked against the values shown
+    in the comments; exit code 1 on any mismatch.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "record_parser.h"
+
+struct record {
+    std::string_view name {};
+    int num {};
+    double total {};
+};
+
+int main() {
+    bool all_ok {true};
+
+    /* Reading from a string_view */
+    std::string info {"Moe 100 1234.5"};
+    record rec {};
+    pg::parse_error err = pg::parse_into(info, ' ', rec, &record::name, &record::num, &record::total);
+    if (!err)
+        std::cout << rec.name << " " << rec.num << " " << rec.total << std::endl;   // Moe 100 1234.5
+    all_ok = all_ok && !err && rec.name == "Moe" && rec.num == 100 && rec.total == 1234.5;
+
+    /* Comma-delimited records */
+    err = pg::parse_into("Larry, 255, 255.67", ',', rec, &record::name, &record::num, &record::total);
+    if (!err)
+        std::cout << rec.name << " " << rec.num << " " << rec.total << std::endl;   // Larry 255 255.67
+    all_ok = all_ok && !err && rec.name == "Larry" && rec.num == 255 && rec.total == 255.67;
+
+    /* Per-field errors */
+    struct bad_record {
+        std::string_view text;
+        pg::parse_errc code;
+        std::size_t field;
+        std::size_t column;
+    };
+    const bad_record bad_records[] {
+        {"Moe 1x0 1234.5", pg::parse_errc::invalid_value, 1, 4},
+        {"Moe 99999999999 1.0", pg::parse_errc::out_of_range, 1, 4},
+        {"Moe 100", pg::parse_errc::missing_field, 2, 7},
+        {"Moe 100 1.5 extra", pg::parse_errc::trailing_data, 3, 12},
+    };
+    for (const bad_record &bad : bad_records) {
+        err = pg::parse_into(bad.text, ' ', rec, &record::name, &record::num, &record::total);
+        std::cout << std::quoted(std::string {bad.text}) << ": " << pg::to_string(err.code)
+                  << " (field " << err.field << ", column " << err.column << ")" << std::endl;
+        all_ok = all_ok && err.code == bad.code && err.field == bad.field && err.column == bad.column;
+    }
+    /*
+    "Moe 1x0 1234.5": invalid value (field 1, column 4)
+    "Moe 99999999999 1.0": value out of range (field 1, column 4)
+    "Moe 100": missing field (field 2, column 7)
+    "Moe 100 1.5 extra": unexpected trailing field (field 3, column 12)
+    */
+
+    /* Benchmark */
+    std::vector<std::string> lines {};
+    const char *names[] {"Moe", "Larry", "Curly", "Shemp"};
+    for (int i {0}; i < 2'000'000; ++i)
+        lines.push_back(std::string {names[i % 4]} + " " + std::to_string(i % 1000) + " "
+                        + std::to_string(i * 0.25));
+
+    double sum_stream {0.0};
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string &line : lines) {
+        std::string name {};
+        int num {};
+        double total {};
+        std::istringstream iss {line};
+        iss >> name >> num >> total;
+        sum_stream += num + total + name.size();
+    }
+    double s_stream = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double sum_parser {0.0};
+    std::size_t failures {0};
+    start = std::chrono::steady_clock::now();
+    for (const std::string &line : lines) {
+        record r {};
+        if (pg::parse_into(line, ' ', r, &record::name, &record::num, &record::total))
+            ++failures;
+        sum_parser += r.num + r.total + r.name.size();
+    }
+    double s_parser = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "istringstream: " << std::setw(12) << lines.size() / s_stream << " records/s" << std::endl
+              << "record_parser: " << std::setw(12) << lines.size() / s_parser << " records/s" << std::endl;
+
+    all_ok = all_ok && failures == 0 && sum_stream == sum_parser;
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+/**
+@file token_validation.h
+
+@brief
+    Validating tokens without a stringstream
+        token ===> std::from_chars (record_parser.h) ===> valid / why not
+
+@par
+    Why not std::stringstream:
+        * std::stringstream ss {input}; if (ss >> value) builds a stream (and copies the token)
+          for every check.
+        * It also accepts "12abc" as the integer 12; the checks here require the whole token.
+    Single tokens:
+        pg::is_valid<int>("42")                 -> true, false on overflow or junk
+        pg::check<int>("42", 0, 100)            -> parse_errc::ok / invalid_value / out_of_range
+        pg::check_token("42", token_kind::integer) -> same, for a kind chosen at run time
+    Kinds (token_kind):
+        integer -> long long; unsigned_integer -> unsigned long long ("-1" is invalid);
+        floating -> double; boolean -> 0, 1, true, false.
+    Columns:
+        pg::validate_column(tokens, token_kind::integer) returns a failure_mask:
+        bit i is set when tokens[i] failed; count() gives the number of failures.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_TOKEN_VALIDATION_H
+#define PG_TOKEN_VALIDATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+#include <vector>
+
+#include "record_parser.h"
+
+namespace pg {
+
+enum class token_kind { integer, unsigned_integer, floating, boolean };
+
+/* Does `token` hold a T (whole token, in range of T)? */
+template <typename T>
+bool is_valid(std::string_view token) {
+    T value {};
+    return parse_field(token, value) == parse_errc::ok;
+}
+
+/* Does `token` hold a T within [min, max]? */
+template <typename T>
+parse_errc check(std::string_view token, T min, T max) {
+    T value {};
+    parse_errc code = parse_field(token, value);
+    if (code != parse_errc::ok)
+        return code;
+    return (value < min || value > max) ? parse_errc::out_of_range : parse_errc::ok;
+}
+
+inline parse_errc check_token(std::string_view token, token_kind kind) {
+    switch (kind) {
+    case token_kind::integer: {
+        long long value {};
+        return parse_field(token, value);
+    }
+    case token_kind::unsigned_integer: {
+        unsigned long long value {};
+        return parse_field(token, value);
+    }
+    case token_kind::floating: {
+        double value {};
+        return parse_field(token, value);
+    }
+    case token_kind::boolean: {
+        bool value {};
+        return parse_field(token, value);
+    }
+    }
+    return parse_errc::invalid_value;
+}
+
+/* One bit per token; a set bit marks a failed token */
+class failure_mask {
+public:
+    explicit failure_mask(std::size_t size = 0) : words_((size + 63) / 64), size_ {size} {}
+
+    void set(std::size_t i) { words_[i / 64] |= std::uint64_t {1} << (i % 64); }
+    void set_word(std::size_t w, std::uint64_t bits) { words_[w] = bits; }   // tokens 64*w .. 64*w+63
+    bool test(std::size_t i) const { return (words_[i / 64] >> (i % 64)) & 1u; }
+    std::size_t size() const { return size_; }
+    bool none() const {
+        for (std::uint64_t w : words_)
+            if (w != 0)
+                return false;
+        return true;
+    }
+    std::size_t count() const {
+        std::size_t n {0};
+        for (std::uint64_t w : words_)
+            n += static_cast<std::size_t>(__builtin_popcountll(w));
+        return n;
+    }
+    const std::vector<std::uint64_t> &words() const { return words_; }
+
+private:
+    std::vector<std::uint64_t> words_;
+    std::size_t size_;
+};
+
+namespace detail {
+
+// 64 tokens per mask word, so each word is written once
+template <typename It, typename Check>
+failure_mask validate_range(It first, It last, Check check) {
+    failure_mask mask(static_cast<std::size_t>(std::distance(first, last)));
+    std::size_t i {0};
+    std::uint64_t word {0};
+    for (; first != last; ++first, ++i) {
+        word |= std::uint64_t {!check(std::string_view {*first})} << (i % 64);
+        if (i % 64 == 63) {
+            mask.set_word(i / 64, word);
+            word = 0;
+        }
+    }
+    if (i % 64 != 0)
+        mask.set_word(i / 64, word);
+    return mask;
+}
+
+}   // namespace detail
+
+/* Validate a whole column of tokens (anything convertible to std::string_view) */
+template <typename Container>
+failure_mask validate_column(const Container &tokens, token_kind kind) {
+    using std::begin;
+    using std::end;
+    switch (kind) {
+    case token_kind::integer:
+        return detail::validate_range(begin(tokens), end(tokens), is_valid<long long>);
+    case token_kind::unsigned_integer:
+        return detail::validate_range(begin(tokens), end(tokens), is_valid<unsigned long long>);
+    case token_kind::floating:
+        return detail::validate_range(begin(tokens), end(tokens), is_valid<double>);
+    case token_kind::boolean:
+        return detail::validate_range(begin(tokens), end(tokens), is_valid<bool>);
+    }
+    return failure_mask {};
+}
+
+/* Validate a column of T values against [min, max] */
+template <typename T, typename Container>
+failure_mask validate_column(const Container &tokens, T min, T max) {
+    using std::begin;
+    using std::end;
+    return detail::validate_range(begin(tokens), end(tokens), [min, max](std::string_view t) {
+        return check<T>(t, min, max) == parse_errc::ok;
+    });
+}
+
+}   // namespace pg
+
+#endif  // PG_TOKEN_VALIDATION_H
@@ -0,0 +1,107 @@
+/**
+@file token_validation_example.cpp
+
+@brief
+    Validating input without a stringstream (token_validation.h), with a tokens/sec
+    benchmark against the "Validating input with stringstream" block of file_input_output.cpp.
+
+@par
+    Usage:
+        token_validation_example            -> demo + benchmark
+        token_validation_example <token>    -> checks one token like the original demo
+    The demo tokens and the column mask are checked against the values shown in the comments;
+    exit code 1 on any mismatch.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "token_validation.h"
+
+int main(int argc, char *argv[]) {
+    /* Validating input without stringstream */
+    if (argc > 1) {
+        if (pg::is_valid<int>(argv[1]))
+            std::cout << "An integer was entered" << std::endl;
+        else
+            std::cout << "An integer was NOT entered" << std::endl;
+        return 0;
+    }
+
+    bool all_ok {true};
+    auto expect = [&all_ok](bool got, bool want) {
+        std::cout << got << std::endl;
+        all_ok = all_ok && got == want;
+    };
+
+    /* Single tokens */
+    std::cout << std::boolalpha;
+    expect(pg::is_valid<int>("42"), true);
+    expect(pg::is_valid<int>("12abc"), false);          // ss >> value says true
+    expect(pg::is_valid<int>("99999999999"), false);    // overflow
+    expect(pg::is_valid<unsigned>("-1"), false);
+    expect(pg::is_valid<double>("1234.5"), true);
+    expect(pg::is_valid<bool>("true"), true);
+    pg::parse_errc range = pg::check<int>("150", 0, 100);
+    std::cout << pg::to_string(range) << std::endl;                     // value out of range
+    all_ok = all_ok && range == pg::parse_errc::out_of_range;
+
+    /* A column of tokens */
+    std::vector<std::string_view> column {"1", "2", "x", "4", "", "+6", "-7", "8.0"};
+    pg::failure_mask mask = pg::validate_column(column, pg::token_kind::integer);
+    std::cout << std::noboolalpha;
+    std::string bits {};
+    for (std::size_t i {0}; i < mask.size(); ++i)
+        bits += mask.test(i) ? '1' : '0';
+    std::cout << bits << " (" << mask.count() << " failures)" << std::endl;   // 00101001 (3 failures)
+    all_ok = all_ok && bits == "00101001" && mask.count() == 3;
+
+    /* Benchmark */
+    std::vector<std::string> tokens {};
+    for (int i {0}; i < 4'000'000; ++i) {
+        if (i % 10 == 0)
+            tokens.push_back("bad" + std::to_string(i));
+        else
+            tokens.push_back(std::to_string(i * 37));
+    }
+
+    std::size_t stream_failures {0};
+    auto start = std::chrono::steady_clock::now();
+    for (const std::string &input : tokens) {
+        int value {};
+        std::stringstream ss {input};
+        if (!(ss >> value))
+            ++stream_failures;
+    }
+    double s_stream = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    pg::failure_mask failures = pg::validate_column<int>(tokens, std::numeric_limits<int>::min(),
+                                                         std::numeric_limits<int>::max());
+    double s_column = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << std::fixed << std::setprecision(0)
+              << "stringstream:    " << std::setw(12) << tokens.size() / s_stream << " tokens/s" << std::endl
+              << "validate_column: " << std::setw(12) << tokens.size() / s_column << " tokens/s" << std::endl;
+
+    all_ok = all_ok && stream_failures == failures.count();
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}
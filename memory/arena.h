@@ -0,0 +1,371 @@
+/**
+@file arena.h
+
+@brief
+    Arena allocators for batch work, as std::pmr memory resources
+        batch of lines/records ===> pmr containers ===> arena (bump pointer) ===> reset in O(1)
+
+@par
+    Why:
+        * Each line read with std::getline into a std::string, and each parsed record,
+          is its own heap allocation. A batch of 100k lines is 100k malloc/free pairs.
+        * An arena hands out memory by bumping a pointer, and frees the whole batch at once
+          by moving the pointer back. Chunks are kept for the next batch, so a warmed-up
+          loop doesn't call malloc at all.
+    Resources (all derive from std::pmr::memory_resource, so std::pmr::vector,
+    std::pmr::string, etc. use them directly):
+        arena_resource -> monotonic bump allocator over a list of growing chunks.
+                          deallocate() is a no-op; reset() / rewind(mark()) free in bulk.
+                          Optional first chunk from the caller (e.g. a stack buffer).
+                          Unlike std::pmr::monotonic_buffer_resource, reset keeps the chunks.
+        pool_resource -> size classes 8 .. 1024 bytes with free lists on top of an arena,
+                         for containers that free and reallocate inside one batch
+                         (maps, node containers). Larger blocks come straight from the arena.
+        thread_arena() -> one arena_resource per thread, no locking.
+        arena_scope -> RAII mark/rewind of an arena; nested scopes free inner batches first.
+    Debug mode (arena_options::debug, default from PG_ARENA_DEBUG):
+        * Every block gets guard bytes behind it. check(), reset() and rewind() report
+          overwritten guards (overflow) and blocks still live when their memory is
+          released (a container that outlives its batch: leak / dangling).
+        * Released memory is filled with 0xDD, so a use after reset shows up quickly.
+        * Problems are counted in arena_report and printed to stderr.
+    Not thread-safe: share an arena between threads only with external locking, or use
+    thread_arena().
+    Usage:
+        pg::arena_resource arena {};
+        for (;;) {
+            pg::arena_scope batch {arena};
+            std::pmr::vector<std::pmr::string> lines {&arena};
+            ...
+        }   // lines destroyed, then the whole batch is released at once
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#ifndef PG_ARENA_H
+#define PG_ARENA_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory_resource>
+#include <unordered_map>
+#include <vector>
+
+#ifndef PG_ARENA_DEBUG
+#define PG_ARENA_DEBUG 0
+#endif
+
+namespace pg {
+
+struct arena_options {
+    std::size_t initial_chunk {64 * 1024};
+    std::size_t max_chunk {16u << 20};              // chunks double up to this size
+    bool debug {PG_ARENA_DEBUG != 0};
+    std::pmr::memory_resource *upstream {std::pmr::new_delete_resource()};
+};
+
+struct arena_report {
+    std::size_t leaks {0};          // blocks still live when released
+    std::size_t overflows {0};      // guard bytes overwritten
+    explicit operator bool() const { return leaks == 0 && overflows == 0; }
+};
+
+class arena_resource : public std::pmr::memory_resource {
+public:
+    struct marker {
+        std::size_t chunk;
+        std::size_t offset;
+        std::size_t used;
+        std::size_t debug_blocks;
+    };
+
+    explicit arena_resource(arena_options options = {}) : options_ {options} {}
+
+    /* The first chunk is caller memory (e.g. a stack buffer); it is never freed */
+    arena_resource(void *buffer, std::size_t size, arena_options options = {}) : options_ {options} {
+        chunks_.push_back({static_cast<char *>(buffer), size, false});
+    }
+
+    arena_resource(const arena_resource &) = delete;
+    arena_resource &operator=(const arena_resource &) = delete;
+
+    ~arena_resource() override {
+        if (options_.debug)
+            release_debug_blocks(0);
+        for (const chunk &c : chunks_) {
+            if (c.owned)
+                options_.upstream->deallocate(c.data, c.size, alignof(std::max_align_t));
+        }
+    }
+
+    /* Current position, for rewind() */
+    marker mark() const { return {current_, offset_, used_, debug_blocks_.size()}; }
+
+    /* Free everything allocated since m; chunks stay for reuse */
+    void rewind(const marker &m) {
+        if (options_.debug) {
+            release_debug_blocks(m.debug_blocks);
+            poison_from(m);
+        }
+        current_ = m.chunk;
+        offset_ = m.offset;
+        used_ = m.used;
+    }
+
+    void reset() { rewind(marker {0, 0, 0, 0}); }
+
+    std::size_t used() const { return used_; }         // bytes handed out (with padding and guards)
+    std::size_t capacity() const {
+        std::size_t total {0};
+        for (const chunk &c : chunks_)
+            total += c.size;
+        return total;
+    }
+    std::size_t chunk_count() const { return chunks_.size(); }
+    bool debug() const { return options_.debug; }
+
+    /* Debug mode: guard and leak check of the live blocks, without releasing anything */
+    arena_report check() const {
+        arena_report r {};
+        for (const debug_block &b : debug_blocks_)
+            r.overflows += guard_broken(b) ? 1 : 0;
+        return r;
+    }
+
+    /* Totals of every problem found so far by rewind/reset/destruction */
+    const arena_report &report() const { return report_; }
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        std::size_t total = options_.debug ? bytes + guard_size : bytes;
+        char *p = bump(total, alignment);
+        if (options_.debug) {
+            std::memset(p + bytes, guard_byte, guard_size);
+            debug_index_[p] = debug_blocks_.size();
+            debug_blocks_.push_back({p, bytes, true});
+        }
+        return p;
+    }
+
+    void do_deallocate(void *p, std::size_t, std::size_t) override {
+        if (!options_.debug)
+            return;                             // monotonic: memory comes back on reset
+        debug_set_live(p, false);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    friend class pool_resource;
+
+    static constexpr std::size_t guard_size {16};
+    static constexpr unsigned char guard_byte {0xCA};
+
+    struct chunk {
+        char *data;
+        std::size_t size;
+        bool owned;
+    };
+
+    struct debug_block {
+        char *data;
+        std::size_t size;
+        bool live;
+    };
+
+    char *bump(std::size_t bytes, std::size_t alignment) {
+        for (;;) {
+            if (current_ < chunks_.size()) {
+                chunk &c = chunks_[current_];
+                std::uintptr_t base = reinterpret_cast<std::uintptr_t>(c.data);
+                std::size_t aligned = ((base + offset_ + alignment - 1) & ~(alignment - 1)) - base;
+                if (aligned + bytes <= c.size) {
+                    used_ += aligned + bytes - offset_;
+                    offset_ = aligned + bytes;
+                    return c.data + aligned;
+                }
+                if (current_ + 1 < chunks_.size()) {    // reuse the next chunk from an earlier batch
+                    used_ += c.size - offset_;
+                    ++current_;
+                    offset_ = 0;
+                    continue;
+                }
+                used_ += c.size - offset_;
+            }
+            add_chunk(bytes + alignment);
+            current_ = chunks_.size() - 1;
+            offset_ = 0;
+        }
+    }
+
+    void add_chunk(std::size_t at_least) {
+        std::size_t size = options_.initial_chunk;
+        if (!chunks_.empty())
+            size = std::min(chunks_.back().size * 2, options_.max_chunk);
+        if (size < at_least)
+            size = at_least;
+        char *p = static_cast<char *>(options_.upstream->allocate(size, alignof(std::max_align_t)));
+        chunks_.push_back({p, size, true});
+    }
+
+    void debug_set_live(const void *p, bool live) {
+        auto it = debug_index_.find(p);
+        if (it != debug_index_.end())
+            debug_blocks_[it->second].live = live;
+    }
+
+    bool guard_broken(const debug_block &b) const {
+        for (std::size_t i {0}; i < guard_size; ++i) {
+            if (static_cast<unsigned char>(b.data[b.size + i]) != guard_byte)
+                return true;
+        }
+        return false;
+    }
+
+    void release_debug_blocks(std::size_t from) {
+        for (std::size_t i {from}; i < debug_blocks_.size(); ++i) {
+            const debug_block &b = debug_blocks_[i];
+            if (guard_broken(b)) {
+                ++report_.overflows;
+                std::fprintf(stderr, "arena: overflow past block of %zu bytes at %p\n", b.size,
+                             static_cast<void *>(b.data));
+            }
+            if (b.live) {
+                ++report_.leaks;
+                std::fprintf(stderr, "arena: block of %zu bytes at %p still in use when released\n", b.size,
+                             static_cast<void *>(b.data));
+            }
+            debug_index_.erase(b.data);
+        }
+        debug_blocks_.resize(from);
+    }
+
+    void poison_from(const marker &m) {
+        for (std::size_t i {m.chunk}; i <= current_ && i < chunks_.size(); ++i) {
+            std::size_t begin = i == m.chunk ? m.offset : 0;
+            std::size_t end = i == current_ ? offset_ : chunks_[i].size;
+            if (end > begin)
+                std::memset(chunks_[i].data + begin, 0xDD, end - begin);
+        }
+    }
+
+    arena_options options_;
+    std::vector<chunk> chunks_ {};
+    std::size_t current_ {0};
+    std::size_t offset_ {0};
+    std::size_t used_ {0};
+
+    // debug mode
+    std::vector<debug_block> debug_blocks_ {};
+    std::unordered_map<const void *, std::size_t> debug_index_ {};
+    arena_report report_ {};
+};
+
+/* Size-class free lists over an arena: blocks freed inside a batch are reused in that batch */
+class pool_resource : public std::pmr::memory_resource {
+public:
+    static constexpr std::size_t min_block {8};
+    static constexpr std::size_t max_block {1024};
+
+    explicit pool_resource(arena_options options = {}) : arena_ {options} {}
+
+    pool_resource(const pool_resource &) = delete;
+    pool_resource &operator=(const pool_resource &) = delete;
+
+    /* Drop every block at once */
+    void reset() {
+        for (free_node *&head : free_lists_)
+            head = nullptr;
+        arena_.reset();
+    }
+
+    std::size_t reused() const { return reused_; }     // allocations served from a free list
+    arena_resource &arena() { return arena_; }
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override {
+        std::size_t cls = size_class(bytes, alignment);
+        if (cls == classes)
+            return arena_.allocate(bytes, alignment);
+        if (free_node *n = free_lists_[cls]) {
+            free_lists_[cls] = n->next;
+            ++reused_;
+            if (arena_.debug())
+                arena_.debug_set_live(n, true);
+            return n;
+        }
+        std::size_t size = min_block << cls;
+        return arena_.allocate(size, size);     // size-aligned, so any alignment <= size works
+    }
+
+    void do_deallocate(void *p, std::size_t bytes, std::size_t alignment) override {
+        std::size_t cls = size_class(bytes, alignment);
+        if (cls == classes) {
+            arena_.deallocate(p, bytes, alignment);
+            return;
+        }
+        arena_.deallocate(p, min_block << cls, min_block << cls);  // debug bookkeeping only
+        free_node *n = static_cast<free_node *>(p);
+        n->next = free_lists_[cls];
+        free_lists_[cls] = n;
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override { return this == &other; }
+
+private:
+    struct free_node {
+        free_node *next;
+    };
+
+    static constexpr std::size_t classes {8};          // 8, 16, ..., 1024
+
+    static std::size_t size_class(std::size_t bytes, std::size_t alignment) {
+        std::size_t need = bytes > alignment ? bytes : alignment;
+        std::size_t cls {0};
+        for (std::size_t size {min_block}; size < need; size <<= 1)
+            ++cls;
+        return cls < classes ? cls : classes;
+    }
+
+    arena_resource arena_;
+    free_node *free_lists_[classes] {};
+    std::size_t reused_ {0};
+};
+
+/* One arena per thread */
+inline arena_resource &thread_arena() {
+    thread_local arena_resource arena {};
+    return arena;
+}
+
+/* Everything allocated from the arena during the scope is released when it ends */
+class arena_scope {
+public:
+    explicit arena_scope(arena_resource &arena = thread_arena()) : arena_ {arena}, mark_ {arena.mark()} {}
+
+    arena_scope(const arena_scope &) = delete;
+    arena_scope &operator=(const arena_scope &) = delete;
+
+    ~arena_scope() { arena_.rewind(mark_); }
+
+    arena_resource &resource() { return arena_; }
+
+private:
+    arena_resource &arena_;
+    arena_resource::marker mark_;
+};
+
+}   // namespace pg
+
+#endif  // PG_ARENA_H
@@ -0,0 +1,195 @@
+/**
+@file arena_example.cpp
+
+@brief
+    Per-batch line/token allocations with the default allocator and with the
+    pg arena resources (arena.h), plus the debug mode catching an overflow and a leak.
+
+@par
+    Workload: batches of 100k lines like "Larry 100 255.67 ...", each stored as a string
+    and split into tokens (vector<string> per line), then the whole batch is thrown away.
+    Compared (checksums must match):
+        std::vector<std::string>, default allocator
+        std::pmr with std::pmr::monotonic_buffer_resource (new resource per batch)
+        std::pmr with std::pmr::unsynchronized_pool_resource
+        std::pmr with pg::arena_resource (arena_scope per batch)
+        std::pmr with pg::pool_resource (reset per batch)
+        std::pmr with pg::thread_arena()
+    Reported: ns per line and speedup over the default allocator.
+
+$Author: $
+
+$Date: Oct. 16, 2026$
+
+$Revision: vA0-1$
+
+$Source: $
+
+@par history:
+    $Log: $
+
+*/
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include "arena.h"
+
+static const std::size_t batch_lines {100'000};
+static const int batches {20};
+
+static std::string make_line(std::size_t i) {
+    const char *names[] {"Larry", "Moe", "Curly", "Shemp"};
+    return std::string {names[i % 4]} + "_" + std::to_string(i) + " " + std::to_string(i % 1000) + " " +
+           std::to_string(i % 4096) + ".25 some trailing words to get past small-string storage";
+}
+
+/* One batch: copy every line, split it on spaces, sum the token sizes */
+template <typename String, typename Vector, typename Tokens>
+static std::size_t run_batch(const std::vector<std::string> &input, Vector &lines, Tokens &tokens) {
+    std::size_t checksum {0};
+    lines.reserve(input.size());
+    for (const std::string &in : input)
+        lines.emplace_back(in.data(), in.size());
+    for (const String &line : lines) {
+        tokens.emplace_back();
+        auto &t = tokens.back();
+        std::size_t start {0};
+        for (std::size_t i {0}; i <= line.size(); ++i) {
+            if (i == line.size() || line[i] == ' ') {
+                t.emplace_back(line.data() + start, i - start);
+                start = i + 1;
+            }
+        }
+        for (const auto &token : t)
+            checksum += token.size() + static_cast<unsigned char>(token[0]);
+    }
+    return checksum;
+}
+
+static std::size_t default_batch(const std::vector<std::string> &input) {
+    std::vector<std::string> lines {};
+    std::vector<std::vector<std::string>> tokens {};
+    return run_batch<std::string>(input, lines, tokens);
+}
+
+static std::size_t pmr_batch(const std::vector<std::string> &input, std::pmr::memory_resource *resource) {
+    std::pmr::vector<std::pmr::string> lines {resource};
+    std::pmr::vector<std::pmr::vector<std::pmr::string>> tokens {resource};
+    return run_batch<std::pmr::string>(input, lines, tokens);
+}
+
+template <typename Body>
+static double ns_per_line(Body body) {
+    body();
+    auto start = std::chrono::steady_clock::now();
+    for (int b {0}; b < batches; ++b)
+        body();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e9 /
+           (double(batch_lines) * batches);
+}
+
+static void report(const std::string &label, double ns, double baseline, bool ok) {
+    std::cout << std::left << std::setw(34) << label << std::right << std::fixed << std::setprecision(1)
+              << std::setw(8) << ns << " ns/line   x" << std::setprecision(2) << baseline / ns
+              << (ok ? "" : "   MISMATCH") << std::endl;
+}
+
+int main() {
+    std::vector<std::string> input {};
+    input.reserve(batch_lines);
+    for (std::size_t i {0}; i < batch_lines; ++i)
+        input.push_back(make_line(i));
+
+    /* Benchmark */
+    bool all_ok {true};
+    std::size_t expected {0}, got {0};
+    double base = ns_per_line([&] { expected = default_batch(input); });
+    report("std::allocator", base, base, true);
+
+    double ns = ns_per_line([&] {
+        std::pmr::monotonic_buffer_resource mono {};
+        got = pmr_batch(input, &mono);
+    });
+    report("std::pmr::monotonic_buffer", ns, base, got == expected);
+    all_ok = all_ok && got == expected;
+
+    std::pmr::unsynchronized_pool_resource std_pool {};
+    ns = ns_per_line([&] { got = pmr_batch(input, &std_pool); });
+    report("std::pmr::unsynchronized_pool", ns, base, got == expected);
+    all_ok = all_ok && got == expected;
+
+    pg::arena_resource arena {};
+    ns = ns_per_line([&] {
+        pg::arena_scope batch {arena};
+        got = pmr_batch(input, &arena);
+    });
+    report("pg::arena_resource", ns, base, got == expected);
+    all_ok = all_ok && got == expected;
+
+    // Warmed up: later batches reuse the same chunks
+    std::size_t chunks = arena.chunk_count();
+    for (int b {0}; b < 3; ++b) {
+        pg::arena_scope batch {arena};
+        pmr_batch(input, &arena);
+    }
+    bool steady = arena.chunk_count() == chunks && arena.used() == 0;
+    std::cout << "arena chunks " << chunks << ", " << (arena.capacity() >> 20) << " MiB, no growth after warmup: "
+              << std::boolalpha << steady << std::endl;
+    all_ok = all_ok && steady;
+
+    pg::pool_resource pool {};
+    ns = ns_per_line([&] {
+        got = pmr_batch(input, &pool);
+        pool.reset();
+    });
+    report("pg::pool_resource", ns, base, got == expected);
+    all_ok = all_ok && got == expected;
+
+    ns = ns_per_line([&] {
+        pg::arena_scope batch {};
+        got = pmr_batch(input, &batch.resource());
+    });
+    report("pg::thread_arena", ns, base, got == expected);
+    all_ok = all_ok && got == expected;
+
+    /* Nested scopes: the inner batch is released, the outer one stays */
+    {
+        char stack_buffer[4096];
+        pg::arena_resource small {stack_buffer, sizeof stack_buffer};
+        pg::arena_scope outer {small};
+        std::pmr::string kept {"outer string that is too long for small-string storage", &small};
+        std::size_t before = small.used();
+        {
+            pg::arena_scope inner {small};
+            std::pmr::vector<int> scratch(100, 7, &small);
+        }
+        bool nested = small.used() == before && kept.size() == 54 && small.chunk_count() == 1;
+        std::cout << "nested scopes: " << std::boolalpha << nested << std::endl;
+        all_ok = all_ok && nested;
+    }
+
+    /* Debug mode: overflow and leak (expected messages on stderr) */
+    {
+        pg::arena_options options {};
+        options.debug = true;
+        pg::arena_resource checked {options};
+        char *p = static_cast<char *>(checked.allocate(10, 1));
+        p[10] = 'x';                            // one past the end
+        bool overflow = checked.check().overflows == 1;
+
+        std::pmr::vector<int> outlives {{1, 2, 3}, &checked};
+        checked.reset();                        // outlives still points into the arena
+        bool leak = checked.report().leaks == 2 && checked.report().overflows == 1;   // p and outlives
+        std::cout << "debug mode caught overflow: " << std::boolalpha << overflow << ", leaks: " << leak
+                  << std::endl;
+        all_ok = all_ok && overflow && leak;
+    }
+
+    std::cout << "results match: " << std::boolalpha << all_ok << std::endl;
+    return all_ok ? 0 : 1;
+}